@@ -36,11 +36,19 @@ extern const int FEED_HOMING_DIRECTION;
 extern const float CUT_MOTOR_NORMAL_SPEED;      // Speed for the cutting pass (steps/sec)
 extern const float CUT_MOTOR_NORMAL_ACCELERATION; // Acceleration for the cutting pass (steps/sec^2)
 
+// Zoned cut stroke (Cutting State) - blade in air before contact and after clear
+extern const float CUT_MOTOR_APPROACH_SPEED;    // Rapid approach up to the recipe's blade contact position (steps/sec)
+extern const float CUT_MOTOR_EXIT_SPEED;        // Exit after the recipe's blade clear position (steps/sec)
+
 // Return Stroke (Returning State / End of Cutting State)
 extern const float CUT_MOTOR_RETURN_SPEED;     // Speed for returning after a cut (steps/sec)
 
 // Homing Operation (Homing State)
-extern const float CUT_MOTOR_HOMING_SPEED;      // Speed for homing the cut motor (steps/sec)
+extern const bool HOMING_ISR_LATCH;             // Zero from the edge-latched position (both axes)
+extern const float CUT_MOTOR_HOMING_SPEED;      // Fast approach to the home switch (steps/sec)
+extern const float CUT_MOTOR_HOMING_LATCH_SPEED; // Slow re-latch after the back-off (steps/sec)
+extern const float CUT_MOTOR_HOMING_BACKOFF_INCHES; // Back-off from the switch before the latch
+extern const float CUT_MOTOR_HOMING_OVERTRAVEL_INCHES; // Travel allowed past the trip point - computed, confirm on the machine
 
 //* ************************************************************************
 //* ************************ FEED MOTOR SPEED SETTINGS *******************
@@ -54,7 +62,20 @@ extern const float FEED_MOTOR_RETURN_SPEED;    // Speed for returning to home or
 extern const float FEED_MOTOR_RETURN_ACCELERATION; // Acceleration for return moves (steps/sec^2)
 
 // Homing Operation (Homing State)
-extern const float FEED_MOTOR_HOMING_SPEED;     // Speed for homing the feed motor (steps/sec)
+extern const float FEED_MOTOR_HOMING_SPEED;     // Fast approach to the home sensor (steps/sec)
+extern const float FEED_MOTOR_HOMING_LATCH_SPEED; // Slow re-latch after the back-off (steps/sec)
+extern const float FEED_MOTOR_HOMING_BACKOFF_INCHES; // Back-off from the sensor before the latch
+extern const float FEED_MOTOR_HOMING_OVERTRAVEL_INCHES; // Travel allowed past the trip point - computed, confirm on the machine
+
+//* ************************************************************************
+//* ************************ MOTION PROFILES ******************************
+//* ************************************************************************
+// Profile selection (MotionProfile) is in StateMachine/STATES/States_Config.h
+extern const uint32_t CUT_MOTOR_LINEAR_ACCELERATION_STEPS;  // Jerk-limited ramp length (steps)
+extern const uint32_t FEED_MOTOR_LINEAR_ACCELERATION_STEPS; // Jerk-limited ramp length (steps)
+extern const float CUT_MOTOR_RETURN_S_CURVE_ACCELERATION;   // Peak acceleration, S-curve return (steps/sec^2)
+extern const float FEED_MOTOR_S_CURVE_ACCELERATION;         // Peak acceleration, S-curve feed (steps/sec^2)
+extern const float FEED_MOTOR_RETURN_S_CURVE_ACCELERATION;  // Peak acceleration, S-curve feed return (steps/sec^2)
 
 //* ************************************************************************
 //* ************************ TIMING CONFIGURATION *************************
@@ -65,6 +86,7 @@ extern const unsigned long ROTATION_CLAMP_EXTEND_DURATION_MS; // Time clamp stay
 
 // Cut motor homing timeout
 extern const unsigned long CUT_HOME_TIMEOUT; // 5 seconds timeout
+extern const unsigned long FEED_HOME_TIMEOUT; // 30 seconds timeout
 
 // Signal timing
 extern const unsigned long TA_SIGNAL_DURATION; // Duration for Transfer Arm signal (ms)
@@ -72,13 +94,16 @@ extern const unsigned long TA_SIGNAL_DURATION; // Duration for Transfer Arm sign
 //* ************************************************************************
 //* ************************ OPERATIONAL CONSTANTS ***********************
 //* ************************************************************************
-// Rotation clamp early activation offset
-extern const float ROTATION_CLAMP_EARLY_ACTIVATION_OFFSET_INCHES;
+// Rotation clamp closed position, back from CUT_TRAVEL_DISTANCE
+extern const float ROTATION_CLAMP_CLOSED_OFFSET_INCHES;
 
-// Rotation servo early activation offset
-extern const float ROTATION_SERVO_EARLY_ACTIVATION_OFFSET_INCHES;
+// Cut return position where the blade is clear of the wood path (0 = wait for home)
+extern const float CUT_RETURN_BLADE_CLEAR_INCHES;
 
-// Transfer Arm signal early activation offset  
-extern const float TA_SIGNAL_EARLY_ACTIVATION_OFFSET_INCHES;
+// Actuator response times (ms) - activation positions are worked out from these
+extern const unsigned long ROTATION_CLAMP_RESPONSE_MS;
+extern const unsigned long ROTATION_SERVO_RESPONSE_MS;
+extern const unsigned long TA_SIGNAL_RESPONSE_MS;
+extern const unsigned long FEED_CLAMP_RESPONSE_MS;
 
 #endif // SYSTEM_CONFIG_H 
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef MATERIAL_RECIPES_H
+#define MATERIAL_RECIPES_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************ MATERIAL RECIPES ****************************
+//* ************************************************************************
+// Per-material settings that used to be edited in States_Config.cpp and reflashed
+// when the stock changed. One recipe is active at a time; the active recipe is
+// only changed by the control task (CONTROL_CMD_SELECT_RECIPE, accepted in IDLE),
+// so a cycle never sees a mix of two recipes.
+// "default" matches the States_Config constants, so the machine behaves as before
+// until another recipe is selected.
+
+struct MaterialRecipe {
+    const char* name;
+    float feedTravelDistanceInches;             // Feed travel per cut (replaces FEED_TRAVEL_DISTANCE in the cycle)
+    float rotationClampClosedOffsetInches;      // Rotation clamp is closed this far before CUT_TRAVEL_DISTANCE
+
+    // Cut stroke zones (see StateMachine/FUNCTIONS/Cut_Stroke.h)
+    float bladeContactInches;                   // Rapid approach up to here; 0 = no approach zone
+    float bladeClearInches;                     // Faster exit from here; >= CUT_TRAVEL_DISTANCE = no exit zone
+    float cutFeedSpeed;                         // Cut motor steps/sec through the material
+};
+
+const uint8_t MATERIAL_RECIPE_NONE = 0xFF;
+
+// Active recipe - any task may read, control task selects
+const MaterialRecipe& getActiveRecipe();
+uint8_t getActiveRecipeIndex();
+
+// Control task only. False (and the active recipe unchanged) for an unknown index.
+bool selectRecipe(uint8_t index);
+
+// Cut motor position (steps) where the rotation clamp must be closed for the active recipe
+long getRotationClampClosedSteps();
+
+// Recipe lookup - MATERIAL_RECIPE_NONE if no recipe has that name
+uint8_t findRecipe(const char* name);
+uint8_t getRecipeCount();
+const MaterialRecipe& getRecipe(uint8_t index);
+
+#endif // MATERIAL_RECIPES_H
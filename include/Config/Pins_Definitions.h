@@ -39,6 +39,10 @@ extern const int FIRST_CUT_OR_WOOD_FWD_ONE;      // Decides state: LOW = wood_fw
 extern const int _2x4_PRESENT_SENSOR;
 extern const int WOOD_SUCTION_CONFIRM_SENSOR;  // Confirms wood is grabbed by transfer arm suction (HIGH = grabbed, LOW = not grabbed)
 
+// Safety inputs (Active HIGH - input pullup, normally-closed contact to GND: pressing the stop
+// or breaking the wire opens it and the pullup pulls the pin HIGH, so either stops the machine)
+extern const int HARD_STOP_INPUT;            // Stops both motors from interrupt context
+
 //* ************************************************************************
 //* ************************ CLAMP PINS ***********************************
 //* ************************************************************************
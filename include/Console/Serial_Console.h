@@ -0,0 +1,53 @@
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************** SERIAL CONSOLE ******************************
+//* ************************************************************************
+// Line-based diagnostic commands read from the USB serial port.
+// Runs on the comms task (core 0) and never touches control state directly -
+// anything that changes control state goes through sendControlCommand().
+//
+// Commands:
+//   help            - list commands
+//   latency         - print per-state loop latency table
+//   latency csv     - export per-state loop latency as CSV
+//   latency reset   - clear the loop latency histograms
+//   stops           - print cut home / hard stop interrupt counters
+//   stops reset     - clear the stop interrupt counters
+//   budget          - print control tick, task time budgets and shed work
+//   budget reset    - clear the budget and overrun counters
+//   events          - print input event counters and the recent event trace
+//   events reset    - clear the input event counters and trace
+//   watchdog        - print state watchdog budgets, longest visits and overruns
+//   watchdog reset  - clear the watchdog counters
+//   triggers        - print position trigger firing counts and errors
+//   triggers reset  - clear the position trigger counters
+//   chain           - print feed chain counts and stop detection times
+//   chain reset     - clear the feed chain counters
+//   homing          - print homing speeds, per-axis homing times and latch spread
+//   homing reset    - clear the homing counters
+//   drift           - print cut home drift per return: last, mean, variance
+//   drift reset     - clear the home drift samples
+//   start           - start a cut cycle (IDLE only, same checks as the switch)
+//   stop            - finish the current cut and stop in IDLE
+//   recipe          - list material recipes and the active one
+//   recipe <name>   - select a material recipe (IDLE only)
+//   status          - log a one-line machine status
+//   telemetry       - print the latest control pass snapshot
+//   commands        - print control command counters
+//   commands reset  - clear the control command counters
+//   seq             - list motion tables (built-in or loaded)
+//   seq show <name> - print a motion table as step tokens
+//   seq begin <name>, seq add <steps...>, seq commit
+//                   - load a replacement motion table, used from the next run
+//   seq reset <name> - go back to the built-in table
+
+// Poll the serial port and run any complete command line. Never blocks.
+// machineCommandsOnly (comms work shed during a cycle): only start, stop and status
+// run; everything else is refused until the cycle is over.
+void handleSerialConsole(bool machineCommandsOnly);
+
+#endif // SERIAL_CONSOLE_H
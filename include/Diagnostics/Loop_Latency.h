@@ -0,0 +1,38 @@
+#ifndef LOOP_LATENCY_H
+#define LOOP_LATENCY_H
+
+#include <Arduino.h>
+#include "StateMachine/FUNCTIONS/General_Functions.h"
+
+//* ************************************************************************
+//* ************************ LOOP LATENCY HISTOGRAM ************************
+//* ************************************************************************
+// Times every pass of executeStateMachine() in microseconds and keeps a
+// fixed-memory log-bucket histogram per SystemState.
+// Buckets: 4 per power of two (<= 25% relative error), covering 0 us to ~33 s.
+
+struct LoopLatencySummary {
+    unsigned long count;
+    unsigned long minUs;
+    unsigned long maxUs;
+    unsigned long meanUs;
+    unsigned long p50Us;
+    unsigned long p99Us;
+    unsigned long p999Us;
+    unsigned long blockedCount;     // Passes over 1 ms - should stay 0 once handlers are non-blocking
+};
+
+// Record one pass. Called by the control task only.
+void recordLoopLatency(SystemState state, unsigned long elapsedUs);
+
+// Clear all histograms. Called by the control task only.
+void resetLoopLatency();
+
+// Compute min/max/mean/p50/p99/p99.9 for one state. Returns false if no samples.
+bool getLoopLatencySummary(SystemState state, LoopLatencySummary& summary);
+
+// Print a human-readable table or CSV export of every state with samples
+void printLoopLatencyReport(Print& out);
+void printLoopLatencyCsv(Print& out);
+
+#endif // LOOP_LATENCY_H
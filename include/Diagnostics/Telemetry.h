@@ -0,0 +1,68 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "StateMachine/FUNCTIONS/General_Functions.h"
+
+//* ************************************************************************
+//* *************************** TELEMETRY **********************************
+//* ************************************************************************
+// One consistent picture of the machine per control pass, for readers on the
+// comms core (serial dump today, web / UDP status later) that must not read
+// the control globals while the state machine is changing them.
+//
+// The control task builds a snapshot at the end of every pass and publishes it
+// through a seqlock: the sequence is odd while the copy is being written and
+// even once it is complete. Readers copy the snapshot and keep it only if the
+// sequence was even and unchanged across the copy. The writer never waits for
+// a reader and readers take no lock; a reader that keeps losing the race
+// (writer publishing every 500 us, copy is well under a microsecond) gives up
+// after TELEMETRY_READ_ATTEMPTS and reports no snapshot.
+
+const uint8_t TELEMETRY_READ_ATTEMPTS = 16;
+
+struct TelemetrySnapshot {
+    uint32_t passCount;             // Control passes published since boot
+    uint64_t timestampUs;           // Timebase stamp of the pass
+
+    uint8_t state;                  // SystemState
+    uint8_t previousState;
+    uint8_t recipeIndex;            // Active material recipe
+    bool controlPaused;             // Parked for an OTA upload
+
+    // Cycle flags
+    bool cuttingCycleInProgress;
+    bool continuousModeActive;
+    bool reloadMode;
+    bool startSwitchSafe;
+    bool cycleStopRequested;
+    bool woodSuctionError;
+    int consecutiveYeswoodCount;
+
+    // Debounced inputs and sensors (true = active)
+    bool cutHomeSwitch;
+    bool feedHomeSwitch;
+    bool reloadSwitch;
+    bool startCycleSwitch;
+    bool pushwoodSwitch;
+    bool suctionSensor;
+    bool woodPresent;               // _2x4Present
+
+    // Axes
+    long cutPositionSteps;
+    long feedPositionSteps;
+    bool cutRunning;
+    bool feedRunning;
+};
+
+// Control task only: build and publish this pass's snapshot
+void publishTelemetrySnapshot(bool controlPaused);
+
+// Any task on either core. False if nothing has been published yet or every
+// attempt overlapped a publish.
+bool readTelemetrySnapshot(TelemetrySnapshot& snapshot);
+
+// Reads a snapshot and prints it
+void printTelemetryReport(Print& out);
+
+#endif // TELEMETRY_H
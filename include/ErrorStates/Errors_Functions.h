@@ -36,13 +36,13 @@ void turnBlueLedOff();
 void allLedsOff();
 void handleHomingLedBlink();
 void handleErrorLedBlink();
-void handleSuctionErrorLedBlink(unsigned long& lastBlinkTimeRef, bool& blinkStateRef);
+void handleSuctionErrorLedBlink(uint64_t& lastBlinkTimeRef, bool& blinkStateRef);
 
 // Motor Control Functions
 void configureCutMotorForCutting();
-void configureCutMotorForReturn();
-void configureFeedMotorForNormalOperation();
-void configureFeedMotorForReturn();
+void configureCutMotorForReturn(MotionProfile profile);
+void configureFeedMotorForNormalOperation(MotionProfile profile);
+void configureFeedMotorForReturn(MotionProfile profile);
 void moveCutMotorToCut();
 void moveCutMotorToHome();
 void moveFeedMotorToTravel();
@@ -50,9 +50,6 @@ void moveFeedMotorToHome();
 void moveFeedMotorToPosition(float targetPositionInches);
 void stopCutMotor();
 void stopFeedMotor();
-void homeCutMotorBlocking(Bounce& homingSwitch, unsigned long timeout);
-void homeFeedMotorBlocking(Bounce& homingSwitch);
-void moveFeedMotorToInitialAfterHoming();
 bool checkAndRecalibrateCutMotorHome(int attempts);
 void moveFeedMotorToPostCutHome();
 
@@ -66,12 +63,11 @@ void handleStartSwitchContinuousMode();
 bool shouldStartCycle();
 void activateRotationServo();
 void handleRotationServoReturn();
-void handleTASignalTiming();
-void handleRotationClampRetract();
 
 // Cut Motor Error Functions
 struct CutMotorHomeErrorResult {
     bool wasHomeDetected;
+    bool isInProgress;              // Non-blocking check still running - call again next pass
     bool shouldTransitionToError;
     bool shouldAttemptSlowRecovery;
     bool shouldContinueWithWarning;
@@ -80,24 +76,25 @@ struct CutMotorHomeErrorResult {
 
 void performCutMotorRealTimeHomeSensorCheck(FastAccelStepper* cutMotor, Bounce& cutHomingSwitch, bool& cutMotorInYes2x4Return);
 CutMotorHomeErrorResult handleCutMotorHomeError(Bounce& cutHomingSwitch, FastAccelStepper* cutMotor, const String& contextDescription, bool allowSlowRecovery);
-void executeCutMotorErrorStateTransition(FastAccelStepper* cutMotor, FastAccelStepper* positionMotor, SystemState& currentState, int& cuttingStep, int& cuttingSubStep7, int& fixPositionStep, int& fixPositionSubStep2, unsigned long& errorStartTime, bool shouldExtend2x4SecureClamp);
+void executeCutMotorErrorStateTransition(FastAccelStepper* cutMotor, FastAccelStepper* positionMotor, SystemState& currentState, int& cuttingStep, int& cuttingSubStep7, int& fixPositionStep, int& fixPositionSubStep2, uint64_t& errorStartTime, bool shouldExtend2x4SecureClamp);
 void logCutMotorHomeErrorResult(const CutMotorHomeErrorResult& result);
 
 // Result creation helpers
 CutMotorHomeErrorResult createSuccessResult();
 CutMotorHomeErrorResult createErrorTransitionResult(const String& message);
 CutMotorHomeErrorResult createWarningOnlyResult(const String& message);
+CutMotorHomeErrorResult createInProgressResult();
 
 // External variable declarations (defined in main.cpp)
 extern bool blinkState;
 extern bool errorBlinkState;
-extern unsigned long lastErrorBlinkTime;
+extern uint64_t lastErrorBlinkTime;
 extern bool signalTAActive;
-extern unsigned long signalTAStartTime;
+extern uint64_t signalTAStartTime;
 extern bool rotationServoIsActiveAndTiming;
-extern unsigned long rotationServoActiveStartTime;
+extern uint64_t rotationServoActiveStartTime;
 extern bool rotationClampIsExtended;
-extern unsigned long rotationClampExtendTime;
+extern uint64_t rotationClampExtendTime;
 extern bool isReloadMode;
 extern bool errorAcknowledged;
 extern bool startSwitchSafe;
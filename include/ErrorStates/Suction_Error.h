@@ -1,6 +1,8 @@
 #ifndef SUCTION_ERROR_H
 #define SUCTION_ERROR_H
 
+#include "Events/Input_Events.h"
+
 //* ************************************************************************
 //* ********************* SUCTION ERROR ************************************
 //* ************************************************************************
@@ -8,4 +10,7 @@
 // Function declaration for handling suction error state
 void handleSuctionErrorState();
 
+// Start switch OFF to ON resets from the suction error (STATE_TABLE event handler)
+void handleSuctionErrorEvent(const InputEvent& event);
+
 #endif // SUCTION_ERROR_H 
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* *************************** INPUT EVENTS *******************************
+//* ************************************************************************
+// Debounced switch edges, motor-idle notifications, actuator timer expiries and
+// homing results as typed events on a fixed-size queue. Each event carries the timebase time it
+// was seen (Timing/Timebase.h).
+//
+// Flow, once per control pass (all on the control task):
+//   updateSwitches()         -> pollInputEvents() posts new edges/idle transitions
+//   handleCommonOperations() -> dispatchInputEvents() pops every event and hands it
+//                               to the current state if its STATE_TABLE row lists it
+//
+// A state only sees events posted after it was entered - an edge from the
+// previous state never triggers the new one.
+//
+// Compatibility shim: states that still poll can call inputEventThisPass(type)
+// instead of Bounce::rose()/fell(). It is true for the pass in which the event
+// was dispatched, whether or not the state declared it.
+
+enum InputEventType : uint8_t {
+    EVENT_START_SWITCH_ON,
+    EVENT_START_SWITCH_OFF,
+    EVENT_RELOAD_SWITCH_ON,
+    EVENT_RELOAD_SWITCH_OFF,
+    EVENT_PUSHWOOD_PRESSED,
+    EVENT_PUSHWOOD_RELEASED,
+    EVENT_CUT_HOME_MADE,
+    EVENT_CUT_HOME_CLEARED,
+    EVENT_FEED_HOME_MADE,
+    EVENT_FEED_HOME_CLEARED,
+    EVENT_SUCTION_CONFIRMED,
+    EVENT_SUCTION_LOST,
+    EVENT_CUT_MOTOR_IDLE,
+    EVENT_FEED_MOTOR_IDLE,
+    EVENT_TIMER_EXPIRED,        // detail = InputEventTimer
+    EVENT_HOMING_DONE,          // detail = HomingAxis (StateMachine/FUNCTIONS/Homing.h)
+    EVENT_HOMING_FAILED,        // detail = HomingAxis
+    INPUT_EVENT_TYPE_COUNT
+};
+
+// detail for EVENT_TIMER_EXPIRED
+enum InputEventTimer : uint8_t {
+    EVENT_TIMER_TA_SIGNAL,
+    EVENT_TIMER_ROTATION_CLAMP,
+    EVENT_TIMER_ROTATION_SERVO
+};
+
+struct InputEvent {
+    InputEventType type;
+    uint8_t detail;
+    uint32_t sequence;          // Post order, wraps
+    uint64_t timestampUs;       // nowUs() when posted
+};
+
+// States declare the events they handle as a mask of eventBit() values
+constexpr uint32_t eventBit(InputEventType type) {
+    return 1UL << type;
+}
+
+static_assert(INPUT_EVENT_TYPE_COUNT <= 32, "Handled event masks are 32-bit");
+
+struct InputEventStats {
+    unsigned long posted;
+    unsigned long dropped;      // Queue full
+    unsigned long handled;      // Delivered to a state that declared the event
+    unsigned long ignored;      // Not declared by the current state (or older than it)
+};
+
+const uint8_t INPUT_EVENT_QUEUE_LENGTH = 32;
+const uint8_t INPUT_EVENT_TRACE_LENGTH = 32;
+
+// One dispatched event, kept for cycle analysis
+struct InputEventTraceEntry {
+    InputEvent event;
+    uint8_t state;              // SystemState at dispatch
+    bool handled;
+};
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+// Queue an event stamped with nowUs(). Never blocks; counts a drop if the queue is full.
+void postInputEvent(InputEventType type, uint8_t detail = 0);
+
+// Post edges from the debounced switches and motor running->idle transitions.
+// Call right after the Bounce objects are updated.
+void pollInputEvents();
+
+// Sequence number the next posted event will get (changeState() records it)
+uint32_t getNextInputEventSequence();
+
+// Pop the oldest event; false when the queue is empty
+bool popInputEvent(InputEvent& event);
+
+// Start of a dispatch pass: clears the shim flags
+void beginInputEventPass();
+
+// Record a dispatched event for the shim, the trace and the counters
+void recordDispatchedInputEvent(const InputEvent& event, uint8_t state, bool handled);
+
+// Compatibility shim - see above
+bool inputEventThisPass(InputEventType type);
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getInputEventStats(InputEventStats& stats);
+void resetInputEventStats();
+
+const char* getInputEventName(InputEventType type);
+
+// Counters plus the most recent dispatched events with timestamps
+void printInputEventReport(Print& out);
+
+#endif // INPUT_EVENTS_H
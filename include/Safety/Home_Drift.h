@@ -0,0 +1,65 @@
+#ifndef HOME_DRIFT_H
+#define HOME_DRIFT_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* **************************** HOME DRIFT ********************************
+//* ************************************************************************
+// Missed-step check on every RETURNING_YES_2x4 return. The cut axis was zeroed
+// where its home switch trips (homing or the previous return), so the position
+// the cut home stop latches as the switch trips again should be 0. Whatever it
+// reads instead is the error the cycle picked up - lost or gained steps on the
+// cut stroke and return - and would be thrown away by the re-zero.
+//
+// Sign: positive = the switch tripped before the axis counted back to 0.
+//
+// Each return records one sample:
+// - Edge stop (Safety/Stop_Interrupts.h): the position latched in the ISR.
+// - Polled fallback stop, or no stop at all (the return ran out to its overshoot
+//   target and home was found by the verification or the incremental recovery):
+//   the position then, up to a control pass late. These are coarse - they are
+//   checked against the re-home limit but kept out of the mean and variance.
+//
+// The last HOME_DRIFT_WINDOW exact samples are kept for the mean and variance.
+// A sample past HOME_DRIFT_WARN_STEPS, or a window mean past it, logs a warning.
+// A sample past HOME_DRIFT_REHOME_STEPS requests a re-home: RETURNING_YES_2x4
+// takes the request and goes to HOMING instead of the next cycle.
+
+const uint8_t HOME_DRIFT_WINDOW = 32;               // Exact samples kept for mean / variance
+const uint8_t HOME_DRIFT_MEAN_MIN_SAMPLES = 8;      // Window size before the mean is checked
+const long HOME_DRIFT_WARN_STEPS = 10;              // 0.02 in at CUT_MOTOR_STEPS_PER_INCH
+const long HOME_DRIFT_REHOME_STEPS = 50;            // 0.10 in - position no longer trusted
+
+struct HomeDriftStats {
+    unsigned long samples;              // Returns recorded
+    unsigned long coarseSamples;        // Of which polled or found without a stop
+    unsigned long warnings;
+    unsigned long rehomeRequests;
+    long lastDriftSteps;
+    bool lastCoarse;
+    long maxAbsDriftSteps;
+    uint8_t windowCount;                // Exact samples in the window
+    float windowMeanSteps;
+    float windowVarianceSteps;          // Population variance, steps^2
+};
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+// Record the cut position where home was found on this return (before re-zeroing)
+void recordCutHomeDrift(long driftSteps, bool coarse);
+
+// True once after a sample past HOME_DRIFT_REHOME_STEPS
+bool takeCutHomeRehomeRequest();
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getHomeDriftStats(HomeDriftStats& stats);
+void resetHomeDriftStats();
+void printHomeDriftReport(Print& out);
+
+#endif // HOME_DRIFT_H
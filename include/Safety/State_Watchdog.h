@@ -0,0 +1,81 @@
+#ifndef STATE_WATCHDOG_H
+#define STATE_WATCHDOG_H
+
+#include <Arduino.h>
+#include "StateMachine/FUNCTIONS/General_Functions.h"
+
+//* ************************************************************************
+//* *************************** STATE WATCHDOG *****************************
+//* ************************************************************************
+// Wall-clock budgets for each state and for the named waits inside them, checked
+// by a supervisor that runs outside the states.
+// - State budget: the STATE_TABLE watchdogBudgetMs column. changeState() restarts
+//   it; 0 = unbounded (states that wait for the operator).
+// - Step budget: one named sub-step at a time, opened with beginWatchdogStep() and
+//   closed with endWatchdogStep() (or by the next state change). Motion table
+//   waits and SEQ_AWAIT_STEP open one automatically.
+// handleCommonOperations() calls checkStateWatchdog() once per pass. On an overrun
+// it stops both motors, goes to ERROR and the overrun is counted and recorded with
+// the state and step that ran long.
+// Blocking loops cannot be supervised from outside while they spin, so they poll
+// isStateWatchdogExpired() and bail out; the supervisor takes over on the next pass.
+
+const unsigned long STATE_WATCHDOG_UNBOUNDED = 0;
+
+// State budgets (ms) - worst normal visit plus margin
+const unsigned long STARTUP_WATCHDOG_MS = 10000;
+const unsigned long HOMING_WATCHDOG_MS = 60000;         // Cut 5 s + feed 30 s search + 10 s positioning + travel move
+const unsigned long CUTTING_WATCHDOG_MS = 20000;        // Cut stroke is ~7 s at CUT_MOTOR_NORMAL_SPEED
+const unsigned long RETURNING_WATCHDOG_MS = 15000;
+const unsigned long FEED_WATCHDOG_MS = 15000;
+const unsigned long ERROR_RESET_WATCHDOG_MS = 10000;
+
+// Step budgets (ms)
+const unsigned long MOTION_WAIT_WATCHDOG_MS = 8000;     // Each motor-idle / sensor / join wait in a motion table
+const unsigned long SEQUENCE_AWAIT_WATCHDOG_MS = 8000;  // Each SEQ_AWAIT_STEP motor wait
+const unsigned long FEED_MOVE_WATCHDOG_MS = 10000;      // Feed move to travel after homing
+
+struct WatchdogOverrun {
+    uint8_t state;              // SystemState that overran
+    const char* stepName;       // nullptr = the state budget itself ran out
+    int stepIndex;              // Motion table step, or source line for a sequence await
+    unsigned long elapsedMs;
+    unsigned long budgetMs;
+    uint64_t timestampMs;       // Timebase ms when the supervisor caught it
+};
+
+struct StateWatchdogStats {
+    unsigned long overruns;
+    unsigned long overrunsByState[SYSTEM_STATE_COUNT];
+    unsigned long longestVisitMs[SYSTEM_STATE_COUNT];   // Longest completed visit - for tuning budgets
+    bool hasOverrun;
+    WatchdogOverrun lastOverrun;
+};
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+// Restart the state budget and drop any open step (changeState() calls this)
+void startStateWatchdog(SystemState state, unsigned long budgetMs);
+
+// Open a named step; replaces the open step. name must be a string literal or other static string.
+void beginWatchdogStep(const char* name, int index, unsigned long budgetMs);
+void endWatchdogStep();
+
+// True once the state or the open step is over budget - for blocking loops to bail out
+bool isStateWatchdogExpired();
+
+// Supervisor pass. Returns true (and fills overrun) the first time a budget runs out
+// in this state visit; the caller stops the motors and goes to ERROR.
+bool checkStateWatchdog(SystemState state, unsigned long budgetMs, WatchdogOverrun& overrun);
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getStateWatchdogStats(StateWatchdogStats& stats);
+void resetStateWatchdogStats();
+void printStateWatchdogReport(Print& out);
+
+#endif // STATE_WATCHDOG_H
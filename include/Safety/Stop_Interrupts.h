@@ -0,0 +1,79 @@
+#ifndef STOP_INTERRUPTS_H
+#define STOP_INTERRUPTS_H
+
+#include <Arduino.h>
+#include <FastAccelStepper.h>
+
+//* ************************************************************************
+//* ************************** STOP INTERRUPTS *****************************
+//* ************************************************************************
+// GPIO edge interrupts that stop the steppers from interrupt context instead of
+// waiting for the next control loop pass.
+// - Cut home switch (rising edge): when armed, stops the cut motor, latches the
+//   step position it reached and re-zeroes it. Armed during the RETURNING_YES_2x4 return.
+// - Hard stop input (rising edge - the normally-closed contact opens): always live,
+//   stops both motors and latches an event that handleCommonOperations() turns into
+//   the ERROR state. An input already open at boot is caught by setupStopInterrupts().
+// - Home latches (cut switch rising edge, feed sensor falling edge): when armed,
+//   record the step position at the edge and leave the motor running. Homing
+//   (StateMachine/FUNCTIONS/Homing.h) then decelerates normally past the input and
+//   sets the zero from the latched position, so the approach speed no longer
+//   limits repeatability.
+// All inputs pass a short glitch filter inside the ISR before acting.
+
+enum HomeLatchInput : uint8_t {
+    HOME_LATCH_CUT,             // Cut home switch
+    HOME_LATCH_FEED,            // Feed home sensor
+    HOME_LATCH_COUNT
+};
+
+struct StopInterruptStats {
+    unsigned long cutHomeStops;         // Cut motor stops made by the ISR
+    unsigned long cutHomePollStops;     // Stops made by the polled fallback in handleCommonOperations()
+    unsigned long hardStops;            // Hard stop input activations
+    unsigned long glitchesRejected;     // Edges that failed the glitch filter
+    long lastCutHomePosition;           // Cut motor position latched at the last ISR stop (before re-zeroing)
+    unsigned long homeLatches[HOME_LATCH_COUNT];    // Positions latched for homing
+    unsigned long lastStopLatencyUs;    // ISR entry to stop issued, last stop (excludes interrupt dispatch)
+    unsigned long maxStopLatencyUs;     // ISR entry to stop issued, worst case (excludes interrupt dispatch)
+};
+
+// Attach the interrupts. Call from setup() after the motors are connected so the
+// ISRs are installed on the same core as the control task. A hard stop input that
+// is already active is latched here, and the first control pass goes to ERROR.
+void setupStopInterrupts(FastAccelStepper* cutMotor, FastAccelStepper* feedMotor);
+
+// Enable/disable the cut home stop. Only stops while armed and the cut motor is running.
+void armCutHomeStop();
+void disarmCutHomeStop();
+
+// Count a stop made by the polled fallback (switch already made when the stop was armed).
+// position is where the poll found the motor, before re-zeroing.
+void recordCutHomePollStop(long position);
+
+// Cut position where the armed home stop fired (ISR or polled fallback), before
+// re-zeroing - true once per stop, cleared by armCutHomeStop(). polled is set
+// when it came from the fallback, up to a control pass late.
+bool takeCutHomeStop(long& position, bool& polled);
+
+// Home latch: arm before the homing move toward the input; the next confirmed edge
+// records the position once and disarms. takeHomeLatch() is true once per latch.
+void armHomeLatch(HomeLatchInput input);
+void disarmHomeLatch(HomeLatchInput input);
+bool takeHomeLatch(HomeLatchInput input, long& position);
+
+// True once after each hard stop activation
+bool consumeHardStopEvent();
+
+// Hard stops since boot - work running off the control task (feed chain) notes it
+// when it starts and gives up if it changes
+uint32_t getHardStopCount();
+
+// Raw input level - true while the hard stop input is held active
+bool isHardStopInputActive();
+
+void getStopInterruptStats(StopInterruptStats& stats);
+void resetStopInterruptStats();
+void printStopInterruptReport(Print& out);
+
+#endif // STOP_INTERRUPTS_H
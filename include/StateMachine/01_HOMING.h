@@ -2,15 +2,20 @@
 #define HOMING_STATE_H
 
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Events/Input_Events.h"
 
 //* ************************************************************************
 //* ************************** HOMING STATE ********************************
 //* ************************************************************************
 // Function-based homing state handling.
-// Handles the homing sequence for all motors.
+// Handles the homing sequence for all motors. Never blocks - the axes run on the
+// homing engine (StateMachine/FUNCTIONS/Homing.h) and report back as events.
 
 void executeHomingState();
 void onEnterHomingState();
 void onExitHomingState();
 
+// EVENT_HOMING_DONE / EVENT_HOMING_FAILED (STATE_TABLE event handler)
+void handleHomingEvent(const InputEvent& event);
+
 #endif // HOMING_STATE_H 
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define IDLE_STATE_H
 
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Events/Input_Events.h"
+#include "Tasks/Task_Layout.h"
 
 //* ************************************************************************
 //* ************************** IDLE STATE **********************************
@@ -12,10 +14,12 @@
 void executeIdleState();
 void onEnterIdleState();
 void onExitIdleState();
+void handleIdleEvent(const InputEvent& event);
+bool handleIdleCommand(const ControlCommand& command);
 
 // Helper function declarations
 void handleReloadModeLogic();
-void checkFirstCutConditions();
-void checkStartConditions();
+void checkFirstCutConditions();                  // On a pushwood forward press
+void checkStartConditions(bool startCycleRose);  // startCycleRose = start switch just flipped ON
 
 #endif // IDLE_STATE_H 
\ No newline at end of file
@@ -7,9 +7,9 @@
 //* ************************** CUTTING STATE *******************************
 //* ************************************************************************
 // Handles the wood cutting operation with a clean 3-step process:
-// Step 0: Initialize cutting sequence - extend clamps and configure motors
+// Step 0: Initialize cutting sequence - extend clamps and start the zoned cut stroke
 // Step 1: Check suction sensor and handle cut motor movement
-// Step 2: Monitor cut motor position, activate rotation components, and complete cut
+// Step 2: Rotation clamp, rotation servo and TA fire from position triggers; complete cut
 
 void executeCuttingState();
 void onEnterCuttingState();
@@ -21,4 +21,7 @@ void handleHomePositionError();
 void resetCuttingSteps();
 void checkWoodPresentSensor();
 
+// Register the rotation clamp / servo / TA position triggers. Call once at startup.
+void setupCuttingTriggers();
+
 #endif // CUTTING_STATE_H 
\ No newline at end of file
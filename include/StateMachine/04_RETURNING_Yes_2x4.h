@@ -2,6 +2,7 @@
 #define _04_RETURNING_YES_2X4_STATE_H
 
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "StateMachine/FUNCTIONS/Sequence.h"
 
 //* ************************************************************************
 //* ******************** RETURNING YES 2X4 STATE **************************
@@ -17,8 +18,7 @@ void onExitReturningYes2x4State();
 
 // Helper function declarations for RETURNING_YES_2x4 sequence
 void handleReturningYes2x4Sequence();
-void handleFeedMotorReturnSequence();
-void handleFeedWoodMovement();
+SequenceStatus runReturningYes2x4Sequence();
 
 // Reset all step counters
 void resetReturningYes2x4Steps();
@@ -2,6 +2,7 @@
 #define _05_RETURNING_NO_2X4_STATE_H
 
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "StateMachine/FUNCTIONS/Sequence.h"
 
 //* ************************************************************************
 //* ************************ RETURNING NO 2X4 STATE ***********************
@@ -16,17 +17,7 @@ void onExitReturningNo2x4State();
 
 // Helper function declarations for RETURNING_NO_2x4 sequence
 void handleReturningNo2x4Sequence();
-void handleReturningNo2x4Step(int step);
-void handleCutMotorHomingWithIncrementalMoves();
-void handleFeedMotorHomingSequenceNo2x4();
-void handleAttentionSequence();
-
-// Step handler helper functions
-void handleWaitForMotorAndCylinderAction(FastAccelStepper* motor, bool extendClamp);
-void handleWaitForFeedMotorAndExtendClamp();
-
-// Error handling functions
-void handleCutMotorHomingError();
+SequenceStatus runReturningNo2x4Sequence();
 
 // Reset all step counters
 void resetReturningNo2x4Steps();
@@ -2,6 +2,7 @@
 #define FEED_WOOD_FWD_ONE_H
 
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "StateMachine/FUNCTIONS/Sequence.h"
 
 //* ************************************************************************
 //* ********************* FEED WOOD FWD ONE STATE **************************
@@ -16,6 +17,6 @@ void onExitFeedWoodFwdOneState();
 
 // Helper function declarations
 void executeFeedWoodFwdOneStep();
-void advanceToNextFeedWoodFwdOneStep();
+SequenceStatus runFeedWoodFwdOneSequence();
 
 #endif // FEED_WOOD_FWD_ONE_H 
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define FEED_FIRST_CUT_H
 
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "StateMachine/FUNCTIONS/Sequence.h"
 
 //* ************************************************************************
 //* ********************* FEED FIRST CUT STATE **************************
@@ -16,6 +17,6 @@ void onExitFeedFirstCutState();
 
 // Helper function declarations
 void executeFeedFirstCutStep();
-void advanceToNextFeedFirstCutStep();
+SequenceStatus runFeedFirstCutSequence();
 
 #endif // FEED_FIRST_CUT_H 
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef CUT_STROKE_H
+#define CUT_STROKE_H
+
+#include <Arduino.h>
+#include "Config/Material_Recipes.h"
+
+//* ************************************************************************
+//* **************************** CUT STROKE ********************************
+//* ************************************************************************
+// The cut stroke as up to three speed zones along one moveTo():
+//   APPROACH - CUT_MOTOR_APPROACH_SPEED while the blade is in air
+//   CUT      - the recipe's cut feed speed through the material
+//   EXIT     - CUT_MOTOR_EXIT_SPEED once the blade is clear, to the end of travel
+// Zone edges come from the active material recipe. Speed changes are applied to
+// the running move (setSpeedInHz + applySpeedAcceleration), so the carriage never
+// stops between zones. The slow-down starts early enough to be at cut feed by
+// blade contact: the deceleration distance plus the FastAccelStepper planning
+// horizon (CUT_ZONE_PLANNING_MARGIN_MS) at approach speed.
+//
+// The rotation clamp, rotation servo and TA triggers stay position based in the
+// CUTTING state. Where they fire is worked back from where the action has to be
+// complete, the actuator's response time and the planned speed over that stretch
+// (planActuatorLeadSteps), so a zone or speed change moves the firing point with it.
+
+enum CutZone : uint8_t {
+    CUT_ZONE_APPROACH,
+    CUT_ZONE_CUT,
+    CUT_ZONE_EXIT,
+    CUT_ZONE_COUNT
+};
+
+// FastAccelStepper queues up to ~20 ms of steps ahead, so a new speed takes that long to show
+const unsigned long CUT_ZONE_PLANNING_MARGIN_MS = 20;
+
+struct CutStrokePlan {
+    long slowdownSteps;         // Approach ends - start slowing to cut feed
+    long contactSteps;          // Blade contact (cut feed reached)
+    long clearSteps;            // Blade clear - exit zone starts
+    long endSteps;              // CUT_TRAVEL_DISTANCE
+    uint32_t approachSpeed;     // steps/sec
+    uint32_t cutSpeed;
+    uint32_t exitSpeed;
+    bool hasApproach;
+    bool hasExit;
+};
+
+// Work out the zones for a recipe. A recipe whose zones do not fit (contact past
+// clear, approach too short to slow down in) falls back to a single cut feed zone
+// for the part that does not fit.
+void planCutStroke(const MaterialRecipe& recipe, CutStrokePlan& plan);
+
+// CUTTING: plan from the active recipe and start the stroke to CUT_TRAVEL_DISTANCE
+void startCutStroke();
+
+// CUTTING: every pass while the stroke runs - moves to the next zone at its edge
+void serviceCutStroke();
+
+// CUTTING: stroke finished - log the time spent in each zone
+void finishCutStroke();
+
+// Planned carriage speed (steps/sec) at a position on the stroke: the zone speed,
+// the zone-to-zone ramps, and the ramps up from rest and down to the end of travel.
+float getPlannedCutSpeedAt(const CutStrokePlan& plan, float positionSteps);
+
+// Position where an action taking latencyMs must start so it is complete when the
+// carriage reaches needSteps. 0 if the stroke is too short to give that much lead.
+long planActuatorLeadSteps(const CutStrokePlan& plan, long needSteps, unsigned long latencyMs);
+
+// Planned time from the start of the stroke to a position
+unsigned long planCutTimeToMs(const CutStrokePlan& plan, long positionSteps);
+
+CutZone getCutZone();
+const CutStrokePlan& getCutStrokePlan();
+const char* getCutZoneName(CutZone zone);
+
+#endif // CUT_STROKE_H
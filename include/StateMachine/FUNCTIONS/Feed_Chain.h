@@ -0,0 +1,92 @@
+#ifndef FEED_CHAIN_H
+#define FEED_CHAIN_H
+
+#include <Arduino.h>
+#include "StateMachine/FUNCTIONS/Motion_Table.h"
+
+//* ************************************************************************
+//* ***************************** FEED CHAIN *******************************
+//* ************************************************************************
+// A run of feed motion table steps - wait for the feed to stop, clamp, feed
+// speed, wait ms, feed move - executed back to back on the esp_timer task
+// instead of one control pass per step. The motion table interpreter compiles
+// the run when its main branch reaches a feed motor-idle wait with the feed still
+// moving, so the next segment's clamps and moveTo go out as soon as the feed
+// stops, and the feed keeps working through the whole run even while the
+// control task is busy.
+//
+// The callback predicts the end of the current move from position and speed
+// and looks again no later than FEED_CHAIN_MAX_POLL_US, and no sooner than
+// FEED_CHAIN_MIN_POLL_US, until the motor and its ramp have stopped.
+//
+// While a chain runs it owns the feed motor and both clamps; the control task
+// does not touch them. cancelFeedChain() takes them back and waits out a callback
+// that is mid-run. A hard stop (Safety/Stop_Interrupts.h) is checked at the start
+// of each callback and again before every move and clamp entry, and aborts the
+// chain. A hard stop that fires between that check and the moveTo() itself can
+// still let one move out; the control task's hard stop handling stops both
+// motors again after cancelling the chain.
+
+const uint8_t FEED_CHAIN_MAX_ENTRIES = MOTION_TABLE_MAX_STEPS;
+const uint32_t FEED_CHAIN_MIN_POLL_US = 200;        // Shortest re-check while the feed is stopping
+const uint32_t FEED_CHAIN_MAX_POLL_US = 20000;      // Longest sleep during a move
+
+enum FeedChainOp : uint8_t {
+    FEED_CHAIN_WAIT_IDLE,       // Feed motor and ramp stopped
+    FEED_CHAIN_WAIT_US,         // value = microseconds
+    FEED_CHAIN_ACTION,          // action() - a pin write (clamp)
+    FEED_CHAIN_SPEED,           // value = multiplier of normal x1000 (configureFeedMotorForSlowOperation)
+    FEED_CHAIN_MOVE_TO          // value = absolute feed steps
+};
+
+struct FeedChainEntry {
+    FeedChainOp op;
+    uint8_t sourceStep;         // Motion table step it was compiled from
+    void (*action)();
+    int32_t value;
+};
+
+enum FeedChainStatus : uint8_t {
+    FEED_CHAIN_IDLE,
+    FEED_CHAIN_RUNNING,         // Timer pending
+    FEED_CHAIN_EXECUTING,       // Callback working through entries
+    FEED_CHAIN_DONE,
+    FEED_CHAIN_ABORTED          // Hard stop or timer failure - nothing more was issued
+};
+
+struct FeedChainStats {
+    unsigned long started;
+    unsigned long completed;
+    unsigned long aborted;
+    unsigned long cancelled;            // Taken back by the control task before the end
+    unsigned long movesIssued;
+    unsigned long stopsSeen;            // Feed stops detected at a wait
+    unsigned long lastStopDetectUs;     // Last look with the feed still moving -> stop seen
+    unsigned long maxStopDetectUs;
+    unsigned long maxCallbackLatencyUs; // Callback vs the time it was scheduled for
+};
+
+// Startup: create the chain timer. Call once before the tasks start.
+void setupFeedChain();
+
+// Control task: copy the entries and start running them. False if a chain is
+// still running or the timer would not start.
+bool startFeedChain(const FeedChainEntry* entries, uint8_t count);
+
+// Control task: stop a running chain and wait out a callback in progress.
+// Safe to call with no chain running.
+void cancelFeedChain();
+
+// Control task: a finished or aborted chain goes back to FEED_CHAIN_IDLE
+void releaseFeedChain();
+
+FeedChainStatus getFeedChainStatus();
+
+// Motion table step of the entry the chain is on (valid while running)
+uint8_t getFeedChainStep();
+bool isFeedChainWaitingForIdle();
+
+void resetFeedChainStats();
+void printFeedChainReport(Print& out);
+
+#endif // FEED_CHAIN_H
@@ -4,18 +4,19 @@
 #include <Arduino.h>
 #include <Bounce2.h>
 #include <FastAccelStepper.h>
+#include "StateMachine/STATES/States_Config.h"
 // #include <ESP32Servo.h> // Removed - using function-based PWM control instead
 
 // Forward declarations and external variable references
 extern bool blinkState;
 extern bool errorBlinkState;
-extern unsigned long lastErrorBlinkTime;
+extern uint64_t lastErrorBlinkTime;
 extern bool signalTAActive;
-extern unsigned long signalTAStartTime;
+extern uint64_t signalTAStartTime;
 extern bool rotationServoIsActiveAndTiming;
-extern unsigned long rotationServoActiveStartTime;
+extern uint64_t rotationServoActiveStartTime;
 extern bool rotationClampIsExtended;
-extern unsigned long rotationClampExtendTime;
+extern uint64_t rotationClampExtendTime;
 extern bool isReloadMode;
 extern bool errorAcknowledged;
 extern bool startSwitchSafe;
@@ -40,6 +41,9 @@ enum SystemState {
     FEED_WOOD_FWD_ONE
 };
 
+// Number of entries in SystemState - keep in sync with the last enumerator
+const int SYSTEM_STATE_COUNT = FEED_WOOD_FWD_ONE + 1;
+
 extern SystemState currentState;
 
 // Motor objects (servo now uses function-based PWM control)
@@ -56,8 +60,8 @@ extern Bounce pushwoodForwardSwitch;
 
 // Additional system flags
 extern bool _2x4Present;
-extern unsigned long lastBlinkTime;
-extern unsigned long errorStartTime;
+extern uint64_t lastBlinkTime;
+extern uint64_t errorStartTime;
 
 // Pin definitions and constants
 extern const int TRANSFER_ARM_SIGNAL_PIN;
@@ -119,11 +123,13 @@ void handleHomingLedBlink();
 //* ************************************************************************
 //* *********************** MOTOR CONTROL FUNCTIONS ************************
 //* ************************************************************************
+// Cutting is always trapezoid; the others take a MotionProfile (States_Config.h),
+// defaulting to the configured profile for that move
 void configureCutMotorForCutting();
-void configureCutMotorForReturn();
-void configureFeedMotorForNormalOperation();
-void configureFeedMotorForReturn();
-void configureFeedMotorForSlowOperation(float speedMultiplier);
+void configureCutMotorForReturn(MotionProfile profile = CUT_RETURN_MOTION_PROFILE);
+void configureFeedMotorForNormalOperation(MotionProfile profile = FEED_MOTION_PROFILE);
+void configureFeedMotorForReturn(MotionProfile profile = FEED_MOTION_PROFILE);
+void configureFeedMotorForSlowOperation(float speedMultiplier, MotionProfile profile = FEED_MOTION_PROFILE);
 void moveCutMotorToCut();
 void moveCutMotorToHome();
 void moveFeedMotorToTravel();
@@ -131,9 +137,6 @@ void moveFeedMotorToHome();
 void moveFeedMotorToPosition(float targetPositionInches);
 void stopCutMotor();
 void stopFeedMotor();
-void homeCutMotorBlocking(Bounce& homingSwitch, unsigned long timeout);
-void homeFeedMotorBlocking(Bounce& homingSwitch);
-void moveFeedMotorToInitialAfterHoming();
 bool checkAndRecalibrateCutMotorHome(int attempts);
 
 //* ************************************************************************
@@ -154,8 +157,6 @@ void activateRotationServo();
 bool getRotationServoSafetyDelayActive();
 void setRotationServoSafetyDelayActive(bool value);
 void handleRotationServoReturn();
-void handleTASignalTiming();
-void handleRotationClampRetract();
 void moveFeedMotorToPostCutHome();
 
 //* ************************************************************************
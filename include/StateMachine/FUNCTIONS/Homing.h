@@ -0,0 +1,128 @@
+#ifndef HOMING_H
+#define HOMING_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ******************************* HOMING *********************************
+//* ************************************************************************
+// Two-speed homing for each axis: a fast approach until the home switch trips,
+// a short back-off until it releases, then a slow re-latch that sets the zero.
+// The fast approach only has to find the switch; repeatability comes from the
+// slow latch, so the approach can run much faster than a single-speed search.
+// Speeds and distances are per axis in States_Config (*_HOMING_SPEED,
+// *_HOMING_LATCH_SPEED, *_HOMING_BACKOFF_INCHES). The feed axis then parks
+// FEED_MOTOR_OFFSET_FROM_SENSOR off its sensor at the working zero.
+//
+// Each axis runs as its own phase machine, so the cut and feed axes home at the
+// same time. Interlock: a feed run started with waitForCutHome is held until the
+// cut axis has found its home switch - from then on the blade only moves within
+// CUT_MOTOR_HOMING_BACKOFF_INCHES of home, or past it on the retracted side (the
+// ISR latch overtravel), clear of the feed path. If the cut
+// axis fails first, the held feed run fails without moving.
+//
+// Nothing here blocks. handleCommonOperations() calls serviceHoming() once per
+// control pass, right after the switches are updated (it reads the home inputs
+// but leaves update() and the edge events to updateSwitches()). Each phase has
+// an explicit limit - the run's timeout, or HOMING_PARK_TIMEOUT_MS for the feed
+// park move - and a run that finishes posts EVENT_HOMING_DONE or
+// EVENT_HOMING_FAILED (detail = HomingAxis) for the state that started it.
+// Retrying is up to that state (HOMING_MAX_ATTEMPTS).
+//
+// ISR latch (HOMING_ISR_LATCH): the home input's edge interrupt records the step
+// position at the trip (Safety/Stop_Interrupts.h). The approach then ramps down
+// past the input at the axis's normal acceleration, within
+// *_HOMING_OVERTRAVEL_INCHES - the approach speed is capped so v^2/2a fits - and
+// the zero is set from the latched position, so
+// there is no back-off or slow latch and the approach speed no longer limits
+// repeatability. Both axes then move back to where they park. An axis already
+// on its input at the start has no edge to latch and takes the two-speed path.
+//
+// Two-speed path (no ISR latch, or the input found by polling): the approach
+// still ramps down past the input at the normal acceleration - nothing stops
+// dead at the approach speed - then backs off until the input releases and
+// re-latches at the latch speed, which sets the zero. The approach speed cap
+// adds the detection delay (one control pass, plus the input debounce without
+// the ISR latch) to the stopping distance.
+//
+// Every run is timed - approach, found -> zero set and total - and kept here for
+// the "homing" console command, with the overtravel and, from the second homing
+// since boot, where the input tripped against the zero the axis held (last, min,
+// max and spread).
+
+const uint8_t HOMING_MAX_ATTEMPTS = 3;          // Runs per axis before the state gives up
+
+enum HomingAxis : uint8_t {
+    HOMING_AXIS_CUT,
+    HOMING_AXIS_FEED,
+    HOMING_AXIS_COUNT
+};
+
+enum HomingPhase : uint8_t {
+    HOMING_PHASE_IDLE,
+    HOMING_PHASE_HELD,          // Feed waiting on the cut home interlock
+    HOMING_PHASE_APPROACH,      // Fast, until the home input is made
+    HOMING_PHASE_BACKOFF,       // Moving off until the input releases
+    HOMING_PHASE_LATCH,         // Slow, until the input is made again
+    HOMING_PHASE_OVERTRAVEL,    // ISR latch: ramping down past the input
+    HOMING_PHASE_PARK,          // Move to where the axis ends (feed: working zero off the sensor)
+    HOMING_PHASE_DONE,
+    HOMING_PHASE_FAILED
+};
+
+struct HomingAxisStats {
+    unsigned long runs;
+    unsigned long failures;
+    unsigned long lastHeldMs;           // Start -> released by the interlock
+    unsigned long lastApproachMs;       // Released -> switch found at the fast speed
+    unsigned long lastLatchMs;          // Switch found -> zero set and parked
+    unsigned long lastTotalMs;          // Approach + latch
+    unsigned long maxTotalMs;
+    long lastOvertravelSteps;           // Travel past the input after the latch
+    long maxOvertravelSteps;
+    unsigned long latchSamples;         // Repeat homings with a clean latch position
+    long lastLatchOffsetSteps;          // Trip position vs the zero the axis held
+    long minLatchOffsetSteps;
+    long maxLatchOffsetSteps;
+};
+
+struct HomingStats {
+    HomingAxisStats axes[HOMING_AXIS_COUNT];
+    unsigned long lastSequenceMs;       // HOMING state entry -> all axes homed and in place
+    unsigned long maxSequenceMs;
+};
+
+const char* getHomingAxisName(HomingAxis axis);
+const char* getHomingPhaseName(HomingPhase phase);
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+// Start homing one axis. timeoutMs covers approach, back-off and latch and starts
+// when the run leaves the interlock. Restarts a run already in flight.
+void startHomingAxis(HomingAxis axis, unsigned long timeoutMs, bool waitForCutHome);
+
+// Advance every axis in flight as far as it can go. Never blocks.
+// True while any axis is still homing.
+bool serviceHoming();
+
+HomingPhase getHomingPhase(HomingAxis axis);
+bool isHomingAxisDone(HomingAxis axis);
+
+// Stop every axis still homing where it is; their runs end FAILED without
+// posting an event (hard stop, watchdog, leaving the state, a retry)
+void abortHoming();
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+// Record a complete HOMING state sequence
+void recordHomingSequence(unsigned long totalMs);
+
+void getHomingStats(HomingStats& stats);
+void resetHomingStats();
+void printHomingReport(Print& out);
+
+#endif // HOMING_H
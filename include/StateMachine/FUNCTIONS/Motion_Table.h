@@ -0,0 +1,192 @@
+#ifndef MOTION_TABLE_H
+#define MOTION_TABLE_H
+
+#include <Arduino.h>
+#include "StateMachine/FUNCTIONS/Sequence.h"
+#include "Timing/Deadline.h"
+
+//* ************************************************************************
+//* *************************** MOTION TABLES ******************************
+//* ************************************************************************
+// Feed/clamp motion sequences written as data. A table is a flat list of
+// MotionSteps ending in MOTION_END; runMotionTable() interprets it one pass at
+// a time and never blocks. Built-in tables are constexpr arrays in flash next to
+// the state that uses them. A replacement table can be loaded at runtime from the
+// serial console ("seq" commands) and takes effect the next time the state starts.
+//
+// Action steps (move, clamp, speed) never wait, so consecutive actions are
+// issued in the same pass - a clamp and a feed move listed back to back start
+// together. Wait steps hold their branch until the condition is met.
+//
+// Parallel branches: MOTION_FORK starts a second branch at another step index
+// and carries on with the next step. The forked branch runs alongside until its
+// own MOTION_END. MOTION_JOIN (main branch only) waits for every forked branch
+// to finish; the main branch's MOTION_END joins implicitly.
+//
+// Every wait on the main branch runs under a state watchdog step named after the
+// table and step index, with MOTION_WAIT_WATCHDOG_MS to complete.
+//
+// Feed chains: when the main branch reaches a feed motor-idle wait with the feed
+// still moving and no forks running, the steps from there up to the next step a
+// chain cannot run (end, fork, join, sensor or cut motor wait) are handed to the
+// esp_timer task as one feed chain (StateMachine/FUNCTIONS/Feed_Chain.h). The next
+// segment then starts the moment the feed stops instead of on the next control
+// pass. The interpreter follows the chain's progress for the watchdog steps and
+// carries on from the first step after it.
+//
+//     constexpr MotionStep EXAMPLE_STEPS[] = {
+//         motionFork(4),                               // 0: clamp branch starts at step 4
+//         motionMoveFeedTo(-1.2),                      // 1: feed move starts in the same pass
+//         motionWaitMotorIdle(MOTION_MOTOR_FEED),      // 2
+//         motionEnd(),                                 // 3: waits for the clamp branch too
+//         motionWaitMs(50),                            // 4
+//         motionClamp(MOTION_CLAMP_FEED, true),        // 5
+//         motionEnd()                                  // 6
+//     };
+
+enum MotionOp : uint8_t {
+    MOTION_END,                 // End of this branch
+    MOTION_FEED_MOVE_TO,        // Absolute feed move, value = inches
+    MOTION_FEED_MOVE_TO_TRAVEL, // Absolute feed move to the active recipe's feed travel distance
+    MOTION_FEED_SPEED,          // Scale feed speed/acceleration, value = multiplier of normal
+    MOTION_CLAMP,               // target = MotionClamp, value = 1 extend / 0 retract
+    MOTION_WAIT_MS,             // value = milliseconds
+    MOTION_WAIT_MOTOR_IDLE,     // target = MotionMotor
+    MOTION_WAIT_SENSOR,         // target = MotionSensor, value = raw pin level to wait for
+    MOTION_FORK,                // Start a branch at step index value
+    MOTION_JOIN                 // Wait for all forked branches to end
+};
+
+enum MotionClamp : uint8_t {
+    MOTION_CLAMP_FEED,
+    MOTION_CLAMP_2X4_SECURE
+};
+
+enum MotionMotor : uint8_t {
+    MOTION_MOTOR_FEED,
+    MOTION_MOTOR_CUT
+};
+
+enum MotionSensor : uint8_t {
+    MOTION_SENSOR_2X4_PRESENT,
+    MOTION_SENSOR_WOOD_SUCTION,
+    MOTION_SENSOR_FEED_HOME
+};
+
+struct MotionStep {
+    MotionOp op;
+    uint8_t target;
+    float value;
+};
+
+struct MotionTable {
+    const char* name;
+    const MotionStep* steps;
+    uint8_t stepCount;
+};
+
+// Tables the console can replace at runtime
+enum MotionTableId {
+    MOTION_TABLE_FEED_FIRST_CUT,
+    MOTION_TABLE_FEED_WOOD_FWD_ONE,
+    MOTION_TABLE_RETURNING_NO_2X4,
+    MOTION_TABLE_COUNT
+};
+
+const uint8_t MOTION_TABLE_MAX_STEPS = 48;     // Longest table (built-in or loaded)
+const uint8_t MOTION_MAX_BRANCHES = 3;         // Main branch + two forks
+
+struct MotionBranch {
+    uint8_t nextStep;
+    bool active;
+    Deadline wait;
+};
+
+const uint8_t MOTION_NO_WATCHED_STEP = 0xFF;
+const uint8_t MOTION_NO_CHAIN = 0xFF;
+
+struct MotionRunner {
+    const char* name;
+    const MotionStep* steps;
+    uint8_t stepCount;
+    MotionBranch branches[MOTION_MAX_BRANCHES];
+    uint8_t watchedStep;        // Main-branch wait holding the watchdog step, or MOTION_NO_WATCHED_STEP
+    uint8_t chainEndStep;       // Main branch resumes here when its feed chain ends, or MOTION_NO_CHAIN
+};
+
+// A table loaded at runtime (RAM copy)
+struct LoadedMotionTable {
+    MotionTableId id;
+    uint8_t stepCount;          // 0 = drop the loaded table and go back to the built-in one
+    MotionStep steps[MOTION_TABLE_MAX_STEPS];
+};
+
+//* ************************************************************************
+//* ************************** STEP BUILDERS *******************************
+//* ************************************************************************
+// Keep the constexpr tables readable
+
+constexpr MotionStep motionEnd() { return MotionStep{MOTION_END, 0, 0.0f}; }
+constexpr MotionStep motionMoveFeedTo(float inches) { return MotionStep{MOTION_FEED_MOVE_TO, 0, inches}; }
+constexpr MotionStep motionMoveFeedToTravel() { return MotionStep{MOTION_FEED_MOVE_TO_TRAVEL, 0, 0.0f}; }
+constexpr MotionStep motionFeedSpeed(float multiplier) { return MotionStep{MOTION_FEED_SPEED, 0, multiplier}; }
+constexpr MotionStep motionClamp(MotionClamp clamp, bool extend) { return MotionStep{MOTION_CLAMP, clamp, extend ? 1.0f : 0.0f}; }
+constexpr MotionStep motionWaitMs(unsigned long durationMs) { return MotionStep{MOTION_WAIT_MS, 0, (float)durationMs}; }
+constexpr MotionStep motionWaitMotorIdle(MotionMotor motor) { return MotionStep{MOTION_WAIT_MOTOR_IDLE, motor, 0.0f}; }
+constexpr MotionStep motionWaitSensor(MotionSensor sensor, int level) { return MotionStep{MOTION_WAIT_SENSOR, sensor, (float)level}; }
+constexpr MotionStep motionFork(uint8_t stepIndex) { return MotionStep{MOTION_FORK, 0, (float)stepIndex}; }
+constexpr MotionStep motionJoin() { return MotionStep{MOTION_JOIN, 0, 0.0f}; }
+
+//* ************************************************************************
+//* ************************* BUILT-IN TABLES ******************************
+//* ************************************************************************
+// Defined in the state files that own them
+extern const MotionTable FEED_FIRST_CUT_MOTION_TABLE;
+extern const MotionTable FEED_WOOD_FWD_ONE_MOTION_TABLE;
+extern const MotionTable RETURNING_NO_2X4_MOTION_TABLE;
+
+//* ************************************************************************
+//* ************************** INTERPRETER *********************************
+//* ************************************************************************
+// Control task only.
+
+// Point the runner at the active table for id (loaded or built-in) and rewind it.
+// Picks up a table loaded since the last start.
+void startMotionTable(MotionRunner& runner, MotionTableId id);
+
+// Run every branch as far as it can go this pass.
+// SEQUENCE_DONE once the main branch and all forks have ended.
+SequenceStatus runMotionTable(MotionRunner& runner);
+
+// Drop the runner (e.g. from onExit). Does not stop motors that are already moving.
+void stopMotionTable(MotionRunner& runner);
+
+// Drain tables queued from the console. Call once per control pass.
+void serviceMotionTableLoads();
+
+//* ************************************************************************
+//* ************************** LOADING (CONSOLE) ***************************
+//* ************************************************************************
+// Comms task side. Tables cross to the control task through a queue.
+
+// Create the load queue. Call once before the tasks start.
+void setupMotionTables();
+
+const MotionTable& getBuiltInMotionTable(MotionTableId id);
+
+// Look up a table id by name; false if unknown
+bool findMotionTableId(const char* name, MotionTableId& id);
+
+// Parse one step token (e.g. "fm-1.2", "fc+", "wf", "ms200"); false if malformed
+bool parseMotionStep(const char* token, MotionStep& step);
+
+// Write a step in the same token form parseMotionStep() reads
+void formatMotionStep(const MotionStep& step, char* buffer, size_t bufferSize);
+
+// Check a table before it is loaded. On failure writes a reason to error.
+bool validateMotionTable(const MotionStep* steps, uint8_t stepCount, char* error, size_t errorSize);
+
+// Queue a table for the control task. Never blocks; false if the queue is full.
+bool submitMotionTable(const LoadedMotionTable& table);
+
+#endif // MOTION_TABLE_H
@@ -0,0 +1,90 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <Arduino.h>
+#include <FastAccelStepper.h>
+#include "Timing/Deadline.h"
+#include "Safety/State_Watchdog.h"
+
+//* ************************************************************************
+//* ************************** SEQUENCE ENGINE *****************************
+//* ************************************************************************
+// Stackless coroutines (protothreads) for the multi-step states. A sequence is
+// written as a straight line of actions and awaits; every await that is not yet
+// satisfied returns to the loop and resumes at the same line on the next pass.
+// A pass costs one switch jump - the same as the old step-enum switch statements.
+//
+//     static Sequence feedSequence;
+//
+//     static SequenceStatus runFeedSequence() {
+//         FastAccelStepper* feedMotor = getFeedMotor();
+//         SEQ_BEGIN(feedSequence);
+//         retractFeedClamp();
+//         SEQ_AWAIT(motorIdle(feedMotor));
+//         moveFeedMotorToPosition(-1.2);
+//         SEQ_AWAIT(motorIdle(feedMotor));
+//         extendFeedClamp();
+//         SEQ_AWAIT_MS(200);
+//         SEQ_END;
+//     }
+//
+// Rules (standard protothread limits):
+// - Locals do not survive an await. Keep anything needed across awaits in statics.
+// - Declare locals before SEQ_BEGIN - jumping to a resume point may not skip an initializer.
+// - No switch statements and no bare break/continue outside a loop inside the body.
+// - Only one SEQ_AWAIT_MS can be pending per sequence (each sequence owns one Deadline).
+// To overlap work, start both actions before awaiting, or await several
+// conditions at once: SEQ_AWAIT(motorIdle(cutMotor) && motorIdle(feedMotor)).
+
+enum SequenceStatus {
+    SEQUENCE_RUNNING,
+    SEQUENCE_DONE
+};
+
+struct Sequence {
+    int resumeLine;     // 0 = start of the sequence
+    Deadline wait;      // Used by SEQ_AWAIT_MS
+};
+
+// Restart a sequence from the top on its next run (call from onEnter/onExit)
+void resetSequence(Sequence& sequence);
+
+bool isSequenceRunning(const Sequence& sequence);
+
+// Common await conditions
+bool motorIdle(FastAccelStepper* motor);
+
+// Resume points fall through into their case label on purpose
+#define SEQ_FALLTHROUGH __attribute__((fallthrough))
+
+#define SEQ_BEGIN(sequence) \
+    Sequence& activeSequence = (sequence); \
+    switch (activeSequence.resumeLine) { case 0:
+
+// Yield until condition is true (checked immediately, then once per pass)
+#define SEQ_AWAIT(condition) \
+    do { activeSequence.resumeLine = __LINE__; SEQ_FALLTHROUGH; case __LINE__: \
+         if (!(condition)) return SEQUENCE_RUNNING; } while (0)
+
+// SEQ_AWAIT under a named watchdog step (Safety/State_Watchdog.h). The step is
+// opened once, before the resume point, and closed when the condition is met.
+#define SEQ_AWAIT_STEP(condition, stepName, budgetMs) \
+    do { beginWatchdogStep((stepName), __LINE__, (budgetMs)); SEQ_AWAIT(condition); \
+         endWatchdogStep(); } while (0)
+
+// Non-blocking wait
+#define SEQ_AWAIT_MS(durationMs) \
+    SEQ_AWAIT(waitForDeadline(activeSequence.wait, (durationMs)))
+
+// Give the rest of the loop one pass
+#define SEQ_YIELD() \
+    do { activeSequence.resumeLine = __LINE__; return SEQUENCE_RUNNING; case __LINE__:; } while (0)
+
+// Leave early (e.g. after changeState to an error state)
+#define SEQ_EXIT() \
+    do { resetSequence(activeSequence); return SEQUENCE_DONE; } while (0)
+
+#define SEQ_END \
+    } resetSequence(activeSequence); return SEQUENCE_DONE
+
+#endif // SEQUENCE_H
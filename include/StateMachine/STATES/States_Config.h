@@ -1,6 +1,8 @@
 #ifndef STATES_CONFIG_H
 #define STATES_CONFIG_H
 
+#include <stdint.h>
+
 //* ************************************************************************
 //* ************************ STATES CONFIGURATION ************************
 //* ************************************************************************
@@ -22,8 +24,14 @@ extern const int FEED_HOMING_DIRECTION;
 // Cut Motor Speed Settings
 extern const float CUT_MOTOR_NORMAL_SPEED;
 extern const float CUT_MOTOR_NORMAL_ACCELERATION;
+extern const float CUT_MOTOR_APPROACH_SPEED;
+extern const float CUT_MOTOR_EXIT_SPEED;
 extern const float CUT_MOTOR_RETURN_SPEED;
+extern const bool HOMING_ISR_LATCH;
 extern const float CUT_MOTOR_HOMING_SPEED;
+extern const float CUT_MOTOR_HOMING_LATCH_SPEED;
+extern const float CUT_MOTOR_HOMING_BACKOFF_INCHES;
+extern const float CUT_MOTOR_HOMING_OVERTRAVEL_INCHES;
 
 // Feed Motor Speed Settings
 extern const float FEED_MOTOR_NORMAL_SPEED;
@@ -31,22 +39,45 @@ extern const float FEED_MOTOR_NORMAL_ACCELERATION;
 extern const float FEED_MOTOR_RETURN_SPEED;
 extern const float FEED_MOTOR_RETURN_ACCELERATION;
 extern const float FEED_MOTOR_HOMING_SPEED;
+extern const float FEED_MOTOR_HOMING_LATCH_SPEED;
+extern const float FEED_MOTOR_HOMING_BACKOFF_INCHES;
+extern const float FEED_MOTOR_HOMING_OVERTRAVEL_INCHES;
+
+// Motion Profiles
+enum MotionProfile : uint8_t {
+    MOTION_PROFILE_TRAPEZOID,   // Constant acceleration
+    MOTION_PROFILE_S_CURVE      // Jerk-limited: acceleration ramps over the linear acceleration steps
+};
+extern const MotionProfile CUT_RETURN_MOTION_PROFILE;
+extern const MotionProfile FEED_MOTION_PROFILE;
+extern const uint32_t CUT_MOTOR_LINEAR_ACCELERATION_STEPS;
+extern const uint32_t FEED_MOTOR_LINEAR_ACCELERATION_STEPS;
+extern const float CUT_MOTOR_RETURN_S_CURVE_ACCELERATION;
+extern const float FEED_MOTOR_S_CURVE_ACCELERATION;
+extern const float FEED_MOTOR_RETURN_S_CURVE_ACCELERATION;
 
 // Timing Configuration
 extern const unsigned long ROTATION_SERVO_ACTIVE_HOLD_DURATION_MS;
 extern const unsigned long ROTATION_CLAMP_EXTEND_DURATION_MS;
 extern const unsigned long CUT_HOME_TIMEOUT;
+extern const unsigned long FEED_HOME_TIMEOUT;
 extern const unsigned long TA_SIGNAL_DURATION;
 
 // Operational Constants
-extern const float ROTATION_CLAMP_EARLY_ACTIVATION_OFFSET_INCHES;
-extern const float ROTATION_SERVO_EARLY_ACTIVATION_OFFSET_INCHES;
-extern const float TA_SIGNAL_EARLY_ACTIVATION_OFFSET_INCHES;
+extern const float ROTATION_CLAMP_CLOSED_OFFSET_INCHES;
+extern const float CUT_RETURN_BLADE_CLEAR_INCHES;
+
+// Actuator Response Times
+extern const unsigned long ROTATION_CLAMP_RESPONSE_MS;
+extern const unsigned long ROTATION_SERVO_RESPONSE_MS;
+extern const unsigned long TA_SIGNAL_RESPONSE_MS;
+extern const unsigned long FEED_CLAMP_RESPONSE_MS;
 
 // Safety Constants
 extern const unsigned long ROTATION_SERVO_EXTENDED_WAIT_THRESHOLD_MS;
 extern const unsigned long ROTATION_SERVO_SAFETY_DELAY_MS;
 extern const unsigned long ROTATION_SERVO_RETURN_DELAY_MS;
+extern const unsigned long ROTATION_SERVO_SUCTION_POLL_MS;
 
 //* ************************************************************************
 //* ************************ MOTOR CONTROL CONSTANTS *********************
@@ -70,8 +101,5 @@ extern const float SUCTION_SENSOR_CHECK_DISTANCE_INCHES;
 //* ************************************************************************
 // Pre-calculated step values for cutting state to avoid repeated calculations
 extern const long SUCTION_SENSOR_CHECK_DISTANCE_STEPS;
-extern const long ROTATION_CLAMP_ACTIVATION_POSITION_STEPS;
-extern const long ROTATION_SERVO_ACTIVATION_POSITION_STEPS;
-extern const long TA_SIGNAL_ACTIVATION_POSITION_STEPS;
 
 #endif // STATES_CONFIG_H 
\ No newline at end of file
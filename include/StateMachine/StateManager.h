@@ -6,6 +6,7 @@
 #include <FastAccelStepper.h>
 #include <ESP32Servo.h>
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Tasks/Task_Layout.h"
 
 //* ************************************************************************
 //* ************************* STATE MANAGER *******************************
@@ -58,15 +59,19 @@ void setStartSwitchSafe(bool value);
 bool getComingFromNoWoodWithSensorsClear();
 void setComingFromNoWoodWithSensorsClear(bool value);
 
+// Set by a STOP_CYCLE command, cleared on entering IDLE
+bool getCycleStopRequested();
+void setCycleStopRequested(bool value);
+
 // Timer access functions
-unsigned long getLastBlinkTime();
-void setLastBlinkTime(unsigned long value);
+uint64_t getLastBlinkTime();
+void setLastBlinkTime(uint64_t value);
 
-unsigned long getLastErrorBlinkTime();
-void setLastErrorBlinkTime(unsigned long value);
+uint64_t getLastErrorBlinkTime();
+void setLastErrorBlinkTime(uint64_t value);
 
-unsigned long getErrorStartTime();
-void setErrorStartTime(unsigned long value);
+uint64_t getErrorStartTime();
+void setErrorStartTime(uint64_t value);
 
 // LED state access functions
 bool getBlinkState();
@@ -76,8 +81,8 @@ bool getErrorBlinkState();
 void setErrorBlinkState(bool value);
 
 // Rotation servo timing access functions
-unsigned long getRotationServoActiveStartTime();
-void setRotationServoActiveStartTime(unsigned long value);
+uint64_t getRotationServoActiveStartTime();
+void setRotationServoActiveStartTime(uint64_t value);
 
 bool getRotationServoIsActiveAndTiming();
 void setRotationServoIsActiveAndTiming(bool value);
@@ -86,21 +91,21 @@ void setRotationServoIsActiveAndTiming(bool value);
 bool getRotationServoSafetyDelayActive();
 void setRotationServoSafetyDelayActive(bool value);
 
-unsigned long getRotationServoSafetyDelayStartTime();
-void setRotationServoSafetyDelayStartTime(unsigned long value);
+uint64_t getRotationServoSafetyDelayStartTime();
+void setRotationServoSafetyDelayStartTime(uint64_t value);
 
-unsigned long getRotationServoReturnDelayStartTime();
-void setRotationServoReturnDelayStartTime(unsigned long value);
+uint64_t getRotationServoReturnDelayStartTime();
+void setRotationServoReturnDelayStartTime(uint64_t value);
 
-unsigned long getRotationClampExtendTime();
-void setRotationClampExtendTime(unsigned long value);
+uint64_t getRotationClampExtendTime();
+void setRotationClampExtendTime(uint64_t value);
 
 bool getRotationClampIsExtended();
 void setRotationClampIsExtended(bool value);
 
 // Signal timing access functions
-unsigned long getSignalTAStartTime();
-void setSignalTAStartTime(unsigned long value);
+uint64_t getSignalTAStartTime();
+void setSignalTAStartTime(uint64_t value);
 
 bool getSignalTAActive();
 void setSignalTAActive(bool value);
@@ -111,10 +116,17 @@ void incrementConsecutiveYeswoodCount();
 void resetConsecutiveYeswoodCount();
 
 // Utility functions
+const char* getStateName(SystemState state);
+unsigned long getStateWatchdogBudget(SystemState state);
 void printStateChange();
 void updateSwitches();
 void handleCommonOperations();
 
+// Control commands (control task): hand a machine command to the current state.
+// False if the state does not accept it or refused it.
+bool dispatchControlCommand(const ControlCommand& command);
+void logMachineStatus();
+
 // Error state handling functions
 void handleStandardErrorState();
 void handleErrorResetState();
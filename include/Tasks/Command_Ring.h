@@ -0,0 +1,46 @@
+#ifndef COMMAND_RING_H
+#define COMMAND_RING_H
+
+#include <Arduino.h>
+#include "Tasks/Task_Layout.h"
+
+//* ************************************************************************
+//* *************************** COMMAND RING *******************************
+//* ************************************************************************
+// Single-producer single-consumer lock-free ring carrying ControlCommands from
+// the comms task (console, OTA, future network front ends) to the control task.
+// The producer only writes head and the consumer only writes tail, so neither
+// side takes a lock or waits: a push into a full ring fails and is counted, a
+// pop from an empty ring returns false.
+//
+// Only the comms task may push. A second producer would need its own ring.
+
+const uint8_t CONTROL_COMMAND_RING_LENGTH = 16;   // Power of two
+
+static_assert((CONTROL_COMMAND_RING_LENGTH & (CONTROL_COMMAND_RING_LENGTH - 1)) == 0,
+              "Ring index masking needs a power-of-two length");
+
+struct CommandRingStats {
+    unsigned long pushed;
+    unsigned long dropped;                          // Ring full
+    unsigned long accepted[CONTROL_CMD_COUNT];
+    unsigned long rejected[CONTROL_CMD_COUNT];      // Not accepted by the state it arrived in
+    uint8_t highWater;                              // Most commands waiting at once
+};
+
+// Comms task only. Never blocks; false if the ring is full.
+bool pushControlCommand(const ControlCommand& command);
+
+// Control task only. False when the ring is empty.
+bool popControlCommand(ControlCommand& command);
+
+// Control task: count what happened to a popped command
+void recordControlCommandResult(ControlCommandType type, bool accepted);
+
+const char* getControlCommandName(ControlCommandType type);
+
+void getCommandRingStats(CommandRingStats& stats);
+void resetCommandRingStats();
+void printCommandRingReport(Print& out);
+
+#endif // COMMAND_RING_H
@@ -0,0 +1,99 @@
+#ifndef CONTROL_EXECUTIVE_H
+#define CONTROL_EXECUTIVE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "StateMachine/FUNCTIONS/General_Functions.h"
+
+//* ************************************************************************
+//* ************************* CONTROL EXECUTIVE ****************************
+//* ************************************************************************
+// Fixed-rate control tick, per-task time budgets and load shedding.
+//
+// A hardware timer fires every CONTROL_TICK_PERIOD_US and its ISR wakes the
+// control task through a task notification, so the state machine runs at a fixed
+// 2 kHz instead of free-running. The control task allocates the timer itself, so
+// the interrupt is on core 1 with the task - the tick does not wait behind WiFi
+// on core 0 the way the esp_timer task (priority 22, core 0) would. Each task run is timed against its budget; runs that
+// blow the budget, and ticks that passed while the control task was still busy,
+// are counted.
+//
+// While the state machine is in CUTTING or RETURNING_* the comms task sheds its
+// low-priority work: OTA handling and the serial console are skipped, and log
+// lines stay queued until the queue is nearly full or the cycle ends.
+// (LED patterns only blink in the error states, so there is nothing to shed there.)
+
+const unsigned long CONTROL_TICK_PERIOD_US = 500;     // 2 kHz
+const uint8_t CONTROL_TICK_HW_TIMER = 0;              // General-purpose timer 0, 1 MHz count
+const unsigned long CONTROL_TICK_BUDGET_US = 400;     // Leaves headroom for the tick wake-up
+const unsigned long COMMS_TASK_BUDGET_US = 2000;
+
+enum TaskBudgetId {
+    TASK_BUDGET_CONTROL,
+    TASK_BUDGET_COMMS,
+    TASK_BUDGET_COUNT
+};
+
+// Low-priority work the comms task can shed
+enum ShedWork {
+    SHED_OTA,
+    SHED_CONSOLE,
+    SHED_LOG_DRAIN,
+    SHED_WORK_COUNT
+};
+
+struct TaskBudgetStats {
+    unsigned long runs;
+    unsigned long budgetUs;
+    unsigned long lastUs;
+    unsigned long maxUs;
+    unsigned long overruns;     // Runs longer than budgetUs
+};
+
+struct ControlExecutiveStats {
+    TaskBudgetStats tasks[TASK_BUDGET_COUNT];
+    unsigned long missedTicks;  // Ticks that expired while the control task was still running
+    unsigned long shedPasses[SHED_WORK_COUNT];
+    bool tickRunning;           // false = tick timer failed to start, control task runs on the RTOS tick
+};
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+// Start the periodic tick that wakes controlTask. The control task calls it as its
+// first action, so the tick exists before the first wait and its interrupt is
+// allocated on the control task's core. Returns false if the timer cannot be
+// allocated; waitForControlTick() then sleeps one RTOS tick per pass.
+bool startControlTick(TaskHandle_t controlTask);
+
+// Block until the next tick (one RTOS tick without the timer). Returns the number
+// of ticks missed since the last call.
+uint32_t waitForControlTick();
+
+// CUTTING and RETURNING_* - the states that shed comms work
+bool isMotionCriticalState(SystemState state);
+
+// Publish whether the comms task should shed work (call once per control pass)
+void setLoadSheddingActive(bool active);
+
+//* ************************************************************************
+//* ************************** BOTH TASKS **********************************
+//* ************************************************************************
+
+void recordTaskRun(TaskBudgetId task, unsigned long durationUs);
+
+// True while the control task runs a motion-critical state
+bool isLoadSheddingActive();
+
+void recordShedWork(ShedWork work);
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getControlExecutiveStats(ControlExecutiveStats& stats);
+void resetControlExecutiveStats();
+void printControlExecutiveReport(Print& out);
+
+#endif // CONTROL_EXECUTIVE_H
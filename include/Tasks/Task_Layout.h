@@ -0,0 +1,60 @@
+#ifndef TASK_LAYOUT_H
+#define TASK_LAYOUT_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* *************************** TASK LAYOUT ********************************
+//* ************************************************************************
+// FreeRTOS task layout for the Stage 1 controller.
+// Core 1: control task - switch updates, handleCommonOperations() and the state machine,
+//         run on a fixed 2 kHz tick (see Tasks/Control_Executive.h).
+// Core 0: comms task - WiFi, OTA and serial logging. Sheds OTA/console/log work while cutting.
+// The two sides only talk through the bounded queues declared below and the
+// lock-free control command ring (Tasks/Command_Ring.h).
+
+//* ************************************************************************
+//* ************************ CONTROL COMMANDS ******************************
+//* ************************************************************************
+// Commands sent from the comms task (core 0) to the control task (core 1).
+// The control task drains them at the start of every pass, before the state machine runs.
+// Machine commands (start, stop, recipe) only apply in the states whose STATE_TABLE row
+// accepts them; anywhere else they are rejected, logged and counted.
+enum ControlCommandType : uint8_t {
+    CONTROL_CMD_OTA_BEGIN,      // OTA upload started - stop motors and park the state machine
+    CONTROL_CMD_OTA_ABORT,      // OTA upload failed - resume the state machine
+    CONTROL_CMD_RESET_LATENCY,  // Clear the loop latency histograms
+    CONTROL_CMD_START_CYCLE,    // IDLE: start a cut cycle, same checks as the start switch
+    CONTROL_CMD_STOP_CYCLE,     // Cycle states: finish the current cut and stop in IDLE
+    CONTROL_CMD_SELECT_RECIPE,  // IDLE: switch material recipe, arg = recipe index
+    CONTROL_CMD_LOG_STATUS,     // Any state: log a one-line machine status
+    CONTROL_CMD_COUNT
+};
+
+struct ControlCommand {
+    ControlCommandType type;
+    uint8_t arg;
+};
+
+// States declare the machine commands they accept as a mask of commandBit() values
+constexpr uint32_t commandBit(ControlCommandType type) {
+    return 1UL << type;
+}
+
+//* ************************************************************************
+//* ************************ TASK FUNCTIONS ********************************
+//* ************************************************************************
+// Create the log queue and start the control and comms tasks. Call once at the end of setup().
+void startSystemTasks();
+
+// Queue a command for the control task. Comms task only (single producer).
+// Never blocks; returns false if the command ring is full.
+bool sendControlCommand(ControlCommandType type, uint8_t arg = 0);
+
+// Queue a printf-style log line for the comms task. Never blocks; drops the line if the queue is full.
+void logMessage(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+// Number of log lines dropped because the log queue was full
+unsigned long getDroppedLogMessageCount();
+
+#endif // TASK_LAYOUT_H
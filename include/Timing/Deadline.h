@@ -0,0 +1,41 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ************************** DEADLINE SERVICE ****************************
+//* ************************************************************************
+// Non-blocking replacement for delay() inside state handlers.
+// A step arms a deadline, returns to the loop, and checks it again on the
+// next pass - switch debouncing, the cut-home stop check and the TA pulse
+// timeout in handleCommonOperations() keep running during the wait.
+//
+// Typical use inside a step:
+//     if (!waitForDeadline(clampSettleDeadline, 100)) return;  // arms on first call
+//     ...continue once 100 ms have passed...
+
+struct Deadline {
+    uint64_t startUs;           // nowUs() when armed
+    uint64_t durationUs;
+    bool armed;
+};
+
+// Arm (or re-arm) a deadline durationMs from now
+void startDeadline(Deadline& deadline, unsigned long durationMs);
+
+// Disarm a deadline so the next waitForDeadline() call starts a fresh wait
+void clearDeadline(Deadline& deadline);
+
+bool isDeadlineArmed(const Deadline& deadline);
+
+// True once an armed deadline has passed. An unarmed deadline never expires.
+bool isDeadlineExpired(const Deadline& deadline);
+
+// Arms the deadline on the first call and returns false until it expires.
+// Returns true exactly once on expiry and disarms the deadline.
+bool waitForDeadline(Deadline& deadline, unsigned long durationMs);
+
+#endif // DEADLINE_H
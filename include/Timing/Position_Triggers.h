@@ -0,0 +1,118 @@
+#ifndef POSITION_TRIGGERS_H
+#define POSITION_TRIGGERS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+//* ************************************************************************
+//* ************************* POSITION TRIGGERS ****************************
+//* ************************************************************************
+// "Fire action X when axis Y passes step N", timed from the planned trajectory
+// instead of whenever the next control pass happens to look.
+//
+// Each pass servicePositionTriggers() predicts, from the axis position and its
+// current speed, when every armed trigger will be passed. Once that is inside
+// TRIGGER_SCHEDULE_HORIZON_US (a few control ticks - short enough that speed is
+// effectively constant) the trigger is scheduled for the earliest time the target
+// step can go out. One hardware timer serves all triggers: while any is scheduled
+// its ISR runs every TRIGGER_RECHECK_US and checks the ones that are due. The step
+// counter does not show how far the axis is between steps, so a due trigger fires
+// only once the target step has been passed and is otherwise checked again; the
+// firing error is bounded by TRIGGER_RECHECK_US of travel. The output - pin or
+// servo writes only - runs in the ISR, which records the position it actually
+// fired at. On the next pass the control task runs the trigger's onFired callback
+// for the bookkeeping (actuator timers, flags, logging) and records the firing
+// error and how late the ISR fired against the scheduled time.
+//
+// The control task allocates the timer on its first pass, so the ISR runs on
+// core 1 with it and not behind WiFi on core 0. Like the stop interrupts
+// (Safety/Stop_Interrupts.h) it calls FastAccelStepper and the output writes,
+// which are not IRAM resident (OTA flash writes park the motors first). ISR LAT
+// in the report is how late it fired against the scheduled time - the
+// TRIGGER_RECHECK_US period plus interrupt latency. If the timer cannot be
+// allocated, every trigger is fired by the control pass.
+//
+// Safety nets:
+// - If the axis slowed or stopped short, the ISR hands the trigger back to the
+//   control pass to predict again instead of re-checking.
+// - A target passed without the timer firing (the axis sped up) is fired by the
+//   control pass at once and counted as polled.
+//
+// Triggers are caller owned (like WheelTimer) and registered once at startup.
+// Arm/disarm/service are control task only.
+
+const uint8_t POSITION_TRIGGER_MAX = 8;
+const uint32_t TRIGGER_SCHEDULE_HORIZON_US = 1500;  // 3 control ticks
+const uint32_t TRIGGER_RECHECK_US = 50;             // Timer ISR period while a trigger is scheduled
+const uint8_t POSITION_TRIGGER_HW_TIMER = 1;        // Timer 0 is the control tick (Tasks/Control_Executive.h)
+
+enum TriggerAxis : uint8_t {
+    TRIGGER_AXIS_CUT,
+    TRIGGER_AXIS_FEED
+};
+
+enum TriggerPhase : uint8_t {
+    TRIGGER_IDLE,
+    TRIGGER_ARMED,          // Waiting to come inside the schedule horizon
+    TRIGGER_SCHEDULED,      // Due at scheduledForUs - checked by the timer ISR
+    TRIGGER_FIRING,         // Output being written (timer ISR or control pass)
+    TRIGGER_FIRED           // Output written - onFired pending on the control task
+};
+
+struct PositionTrigger;
+
+typedef void (*TriggerOutput)();                                    // Timer ISR: pin/servo writes only
+typedef void (*TriggerCallback)(const PositionTrigger& trigger);    // Control task, after the output
+
+struct PositionTriggerStats {
+    unsigned long fired;
+    unsigned long polled;           // Fired by the control pass fallback, not the timer
+    unsigned long rechecks;         // ISR checks before the target step went out
+    unsigned long rearmed;          // Axis slowed or stopped short - back to the control pass
+    long lastErrorSteps;            // Fired position - target, in the direction of travel
+    long maxErrorSteps;             // Largest |error| seen
+    long totalAbsErrorSteps;
+    unsigned long lastTimerLatencyUs;   // Firing ISR vs the time it was scheduled for
+    unsigned long maxTimerLatencyUs;
+};
+
+struct PositionTrigger {
+    // Set by registerPositionTrigger()
+    const char* name;
+    TriggerAxis axis;
+    int8_t direction;               // +1 fires passing upward, -1 passing downward
+    TriggerOutput output;
+    TriggerCallback onFired;
+
+    // Engine state
+    std::atomic<uint8_t> phase;
+    long targetSteps;
+    uint64_t scheduledForUs;
+    long firedPositionSteps;
+    uint64_t firedAtUs;
+    bool firedByPoll;
+    PositionTriggerStats stats;
+};
+
+// Startup: add a trigger. name must be a static string.
+bool registerPositionTrigger(PositionTrigger& trigger, const char* name, TriggerAxis axis,
+                             int8_t direction, TriggerOutput output, TriggerCallback onFired);
+
+// Control task: (re)arm for a target position / drop a pending trigger.
+// An output already written when it is disarmed is still reported by the next service pass.
+// False if its last output is still being written - try again next pass.
+bool armPositionTrigger(PositionTrigger& trigger, long targetSteps);
+void disarmPositionTrigger(PositionTrigger& trigger);
+bool isPositionTriggerPending(const PositionTrigger& trigger);   // Armed, scheduled or firing
+
+// Control task, once per pass
+void servicePositionTriggers();
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void resetPositionTriggerStats();
+void printPositionTriggerReport(Print& out);
+
+#endif // POSITION_TRIGGERS_H
@@ -0,0 +1,47 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#ifdef TIMEBASE_VIRTUAL_CLOCK
+#include <stdint.h>
+#else
+#include <Arduino.h>
+#endif
+
+//* ************************************************************************
+//* ***************************** TIMEBASE *********************************
+//* ************************************************************************
+// The one clock for every timer, trace and telemetry stamp in the firmware:
+// 64-bit microseconds since boot. It does not wrap in the life of the machine,
+// so stamps can be compared and subtracted without the millis() wraparound care,
+// and it has the resolution to measure actuator lead times.
+//
+// Target: esp_timer_get_time(). nowUs() can be called from an ISR (not with the
+// flash cache disabled); the inline helpers below are not guaranteed to be IRAM
+// resident, so ISRs subtract by hand.
+// Host builds (-DTIMEBASE_VIRTUAL_CLOCK): a virtual clock that only moves when
+// the test moves it, so timing code can be stepped deterministically.
+//
+// Stamps are stored as uint64_t microseconds; durations in the config stay in
+// milliseconds and are compared with msSince():
+//     stepStartTime = nowUs();
+//     ...
+//     if (msSince(stepStartTime) >= CYLINDER_ACTION_DELAY_MS) { ... }
+
+uint64_t nowUs();
+
+// Whole milliseconds elapsed since a nowUs() stamp
+inline uint64_t msSince(uint64_t startUs) {
+    return (nowUs() - startUs) / 1000;
+}
+
+// Microseconds elapsed since a nowUs() stamp
+inline uint64_t usSince(uint64_t startUs) {
+    return nowUs() - startUs;
+}
+
+#ifdef TIMEBASE_VIRTUAL_CLOCK
+void setVirtualTimeUs(uint64_t timeUs);
+void advanceVirtualTimeUs(uint64_t deltaUs);
+#endif
+
+#endif // TIMEBASE_H
@@ -0,0 +1,46 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* **************************** TIMER WHEEL *******************************
+//* ************************************************************************
+// Hashed timer wheel for one-shot actuator timeouts (TA pulse, rotation clamp
+// retract, rotation servo hold/return). Owners keep a WheelTimer, schedule it
+// with a callback, and serviceTimers() runs callbacks as they expire.
+//
+// 1 ms per slot, 128 slots. A timer lives in slot (expiryMs % 128), so a pass
+// only walks the slots whose tick has come up - cost is O(ticks elapsed +
+// timers in those slots), not O(all timers). Longer timeouts just stay in their
+// slot for extra laps. Nothing is allocated; a WheelTimer must outlive its schedule.
+//
+// Ticks are whole milliseconds of the 64-bit timebase (Timing/Timebase.h), so
+// expiries never wrap and a host build steps the wheel with the virtual clock.
+
+typedef void (*TimerCallback)();
+
+struct WheelTimer {
+    WheelTimer* next;
+    WheelTimer* prev;
+    uint64_t expiryMs;          // Timebase milliseconds
+    TimerCallback callback;
+    bool scheduled;
+};
+
+// (Re)schedule a timer delayMs from now. Rescheduling a pending timer moves it.
+// A delay of 0 is treated as 1 ms.
+void scheduleTimer(WheelTimer& timer, unsigned long delayMs, TimerCallback callback);
+
+// Remove a pending timer. Safe to call on a timer that is not scheduled.
+void cancelTimer(WheelTimer& timer);
+
+bool isTimerScheduled(const WheelTimer& timer);
+
+// Run every expired callback. Call once per control pass. Callbacks may
+// schedule or cancel any timer, including their own.
+void serviceTimers();
+
+#endif // TIMER_WHEEL_H
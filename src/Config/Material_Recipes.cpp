@@ -0,0 +1,58 @@
+#include "Config/Material_Recipes.h"
+#include "StateMachine/STATES/States_Config.h"
+
+//* ************************************************************************
+//* ************************ MATERIAL RECIPES ****************************
+//* ************************************************************************
+
+// Blade contact / clear positions are measured on the machine for each stock; until
+// they are, a recipe keeps the single-zone stroke (contact 0, clear = CUT_TRAVEL_DISTANCE)
+// at CUT_MOTOR_NORMAL_SPEED, which is how the cut ran before zones existed.
+static const MaterialRecipe MATERIAL_RECIPES[] = {
+    // name       feed travel   rotation clamp closed   blade contact   blade clear   cut feed
+    { "default",  3.4,          2.6,                    0.0,            9.1,          650 },    // Same as the States_Config constants
+    { "sq3.00",   3.4,          1.35,                   0.0,            9.1,          650 },    // 3 inch squares
+    { "sq2.65",   3.25,         2.6,                    0.0,            9.1,          650 },    // 2.65 inch squares
+};
+
+static const uint8_t MATERIAL_RECIPE_COUNT = sizeof(MATERIAL_RECIPES) / sizeof(MATERIAL_RECIPES[0]);
+
+static_assert(sizeof(MATERIAL_RECIPES) / sizeof(MATERIAL_RECIPES[0]) < MATERIAL_RECIPE_NONE,
+              "Recipe indexes must fit below MATERIAL_RECIPE_NONE");
+
+// Written by the control task only; a byte store, so readers on the other core see old or new
+static volatile uint8_t activeRecipeIndex = 0;
+
+const MaterialRecipe& getActiveRecipe() {
+    return MATERIAL_RECIPES[activeRecipeIndex];
+}
+
+uint8_t getActiveRecipeIndex() {
+    return activeRecipeIndex;
+}
+
+bool selectRecipe(uint8_t index) {
+    if (index >= MATERIAL_RECIPE_COUNT) return false;
+    activeRecipeIndex = index;
+    return true;
+}
+
+long getRotationClampClosedSteps() {
+    return (CUT_TRAVEL_DISTANCE - getActiveRecipe().rotationClampClosedOffsetInches) * CUT_MOTOR_STEPS_PER_INCH;
+}
+
+uint8_t findRecipe(const char* name) {
+    for (uint8_t i = 0; i < MATERIAL_RECIPE_COUNT; i++) {
+        if (strcmp(MATERIAL_RECIPES[i].name, name) == 0) return i;
+    }
+    return MATERIAL_RECIPE_NONE;
+}
+
+uint8_t getRecipeCount() {
+    return MATERIAL_RECIPE_COUNT;
+}
+
+const MaterialRecipe& getRecipe(uint8_t index) {
+    if (index >= MATERIAL_RECIPE_COUNT) return MATERIAL_RECIPES[0];
+    return MATERIAL_RECIPES[index];
+}
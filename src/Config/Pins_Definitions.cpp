@@ -38,6 +38,10 @@ const int FIRST_CUT_OR_WOOD_FWD_ONE = 10;       // Decides state: LOW = wood_fwd
 const int _2x4_PRESENT_SENSOR = 4;
 const int WOOD_SUCTION_CONFIRM_SENSOR = 39;  // Confirms wood is grabbed by transfer arm suction (HIGH = grabbed, LOW = not grabbed)
 
+// Safety inputs (Active HIGH - input pullup, normally-closed contact to GND: pressing the stop
+// or breaking the wire opens it and the pullup pulls the pin HIGH, so either stops the machine)
+const int HARD_STOP_INPUT = 40;            // Stops both motors from interrupt context
+
 //* ************************************************************************
 //* ************************ CLAMP PINS ***********************************
 //* ************************************************************************
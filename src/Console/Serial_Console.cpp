@@ -0,0 +1,342 @@
+#include "Console/Serial_Console.h"
+#include "Tasks/Task_Layout.h"
+#include "Diagnostics/Loop_Latency.h"
+#include "Diagnostics/Telemetry.h"
+#include "Safety/Stop_Interrupts.h"
+#include "Safety/State_Watchdog.h"
+#include "Safety/Home_Drift.h"
+#include "Events/Input_Events.h"
+#include "Tasks/Control_Executive.h"
+#include "StateMachine/FUNCTIONS/Motion_Table.h"
+#include "Tasks/Command_Ring.h"
+#include "Timing/Position_Triggers.h"
+#include "StateMachine/FUNCTIONS/Feed_Chain.h"
+#include "StateMachine/FUNCTIONS/Homing.h"
+#include "Config/Material_Recipes.h"
+
+//* ************************************************************************
+//* ************************** SERIAL CONSOLE ******************************
+//* ************************************************************************
+
+const size_t CONSOLE_LINE_MAX_LENGTH = 64;
+
+static char consoleLine[CONSOLE_LINE_MAX_LENGTH];
+static size_t consoleLineLength = 0;
+
+// Motion table being edited ("seq begin" .. "seq commit") and the last table
+// committed per id. Console (comms task) owned - the control task gets copies.
+static LoadedMotionTable editedMotionTable;
+static bool motionTableEditOpen = false;
+static LoadedMotionTable committedMotionTables[MOTION_TABLE_COUNT];
+static bool motionTableCommitted[MOTION_TABLE_COUNT];
+
+static void printConsoleHelp() {
+    Serial.println("Commands:");
+    Serial.println("  help            - list commands");
+    Serial.println("  latency         - print per-state loop latency table");
+    Serial.println("  latency csv     - export per-state loop latency as CSV");
+    Serial.println("  latency reset   - clear the loop latency histograms");
+    Serial.println("  stops           - print cut home / hard stop interrupt counters");
+    Serial.println("  stops reset     - clear the stop interrupt counters");
+    Serial.println("  budget          - print control tick, task time budgets and shed work");
+    Serial.println("  budget reset    - clear the budget and overrun counters");
+    Serial.println("  events          - print input event counters and the recent event trace");
+    Serial.println("  events reset    - clear the input event counters and trace");
+    Serial.println("  watchdog        - print state watchdog budgets, longest visits and overruns");
+    Serial.println("  watchdog reset  - clear the watchdog counters");
+    Serial.println("  triggers        - print position trigger firing counts and errors");
+    Serial.println("  triggers reset  - clear the position trigger counters");
+    Serial.println("  chain           - print feed chain counts and stop detection times");
+    Serial.println("  chain reset     - clear the feed chain counters");
+    Serial.println("  homing          - print homing speeds, per-axis homing times and latch spread");
+    Serial.println("  homing reset    - clear the homing counters");
+    Serial.println("  drift           - print cut home drift per return: last, mean, variance");
+    Serial.println("  drift reset     - clear the home drift samples");
+    Serial.println("  start           - start a cut cycle (IDLE only, same checks as the switch)");
+    Serial.println("  stop            - finish the current cut and stop in IDLE");
+    Serial.println("  recipe          - list material recipes and the active one");
+    Serial.println("  recipe <name>   - select a material recipe (IDLE only)");
+    Serial.println("  status          - log a one-line machine status");
+    Serial.println("  telemetry       - print the latest control pass snapshot");
+    Serial.println("  commands        - print control command counters");
+    Serial.println("  commands reset  - clear the control command counters");
+    Serial.println("  seq             - list motion tables");
+    Serial.println("  seq show <name> - print a motion table as step tokens");
+    Serial.println("  seq begin <name> - start loading a replacement table");
+    Serial.println("  seq add <steps> - append step tokens to the table being loaded");
+    Serial.println("  seq commit      - check and load it (used from the next run)");
+    Serial.println("  seq reset <name> - go back to the built-in table");
+    Serial.println("  steps: fm<in> ft fs<mult> fc+ fc- sc+ sc- ms<n> wf wc");
+    Serial.println("         w2x4=<0|1> wsuc=<0|1> wfh=<0|1> fork<step> join end");
+}
+
+//* ************************************************************************
+//* ************************** MOTION TABLE COMMANDS ***********************
+//* ************************************************************************
+
+static void printMotionSteps(const MotionStep* steps, uint8_t stepCount) {
+    char token[16];
+    for (uint8_t i = 0; i < stepCount; i++) {
+        formatMotionStep(steps[i], token, sizeof(token));
+        Serial.printf("  %2u: %s\n", i, token);
+    }
+}
+
+static void listMotionTables() {
+    Serial.println("Motion tables:");
+    for (int i = 0; i < MOTION_TABLE_COUNT; i++) {
+        const MotionTable& builtIn = getBuiltInMotionTable((MotionTableId)i);
+        if (motionTableCommitted[i]) {
+            Serial.printf("  %-18s loaded (%u steps, built-in %u)\n", builtIn.name,
+                          committedMotionTables[i].stepCount, builtIn.stepCount);
+        } else {
+            Serial.printf("  %-18s built-in (%u steps)\n", builtIn.name, builtIn.stepCount);
+        }
+    }
+}
+
+static bool lookUpMotionTable(const char* name, MotionTableId& id) {
+    if (findMotionTableId(name, id)) return true;
+    Serial.print("Unknown motion table: ");
+    Serial.println(name);
+    return false;
+}
+
+static void showMotionTable(const char* name) {
+    MotionTableId id;
+    if (!lookUpMotionTable(name, id)) return;
+    if (motionTableCommitted[id]) {
+        Serial.printf("%s (loaded):\n", name);
+        printMotionSteps(committedMotionTables[id].steps, committedMotionTables[id].stepCount);
+    } else {
+        const MotionTable& builtIn = getBuiltInMotionTable(id);
+        Serial.printf("%s (built-in):\n", name);
+        printMotionSteps(builtIn.steps, builtIn.stepCount);
+    }
+}
+
+static void beginMotionTable(const char* name) {
+    MotionTableId id;
+    if (!lookUpMotionTable(name, id)) return;
+    editedMotionTable.id = id;
+    editedMotionTable.stepCount = 0;
+    motionTableEditOpen = true;
+    Serial.printf("Loading %s - add steps with \"seq add\", finish with \"seq commit\".\n", name);
+}
+
+static void addMotionSteps(char* tokens) {
+    if (!motionTableEditOpen) {
+        Serial.println("No table open - use \"seq begin <name>\" first.");
+        return;
+    }
+    for (char* token = strtok(tokens, " "); token; token = strtok(NULL, " ")) {
+        if (editedMotionTable.stepCount >= MOTION_TABLE_MAX_STEPS) {
+            Serial.printf("Table full (%u steps) - \"%s\" and later steps ignored.\n", MOTION_TABLE_MAX_STEPS, token);
+            return;
+        }
+        MotionStep step;
+        if (!parseMotionStep(token, step)) {
+            // Reject the whole line so a typo cannot leave half a line behind
+            Serial.printf("Bad step \"%s\" - line ignored.\n", token);
+            return;
+        }
+        editedMotionTable.steps[editedMotionTable.stepCount++] = step;
+    }
+    Serial.printf("%u steps so far.\n", editedMotionTable.stepCount);
+}
+
+static void commitMotionTable() {
+    if (!motionTableEditOpen) {
+        Serial.println("No table open - use \"seq begin <name>\" first.");
+        return;
+    }
+    char error[48];
+    if (!validateMotionTable(editedMotionTable.steps, editedMotionTable.stepCount, error, sizeof(error))) {
+        Serial.printf("Table not loaded: %s\n", error);
+        return;
+    }
+    if (!submitMotionTable(editedMotionTable)) {
+        Serial.println("Motion table queue full - try again.");
+        return;
+    }
+    committedMotionTables[editedMotionTable.id] = editedMotionTable;
+    motionTableCommitted[editedMotionTable.id] = true;
+    motionTableEditOpen = false;
+    Serial.printf("%s loaded - used from the next run.\n", getBuiltInMotionTable(editedMotionTable.id).name);
+}
+
+static void resetMotionTable(const char* name) {
+    MotionTableId id;
+    if (!lookUpMotionTable(name, id)) return;
+    LoadedMotionTable table;
+    table.id = id;
+    table.stepCount = 0;    // Tells the control task to drop its loaded copy
+    if (!submitMotionTable(table)) {
+        Serial.println("Motion table queue full - try again.");
+        return;
+    }
+    motionTableCommitted[id] = false;
+    Serial.printf("%s back to built-in from the next run.\n", name);
+}
+
+static void runMotionTableCommand(char* arguments) {
+    if (arguments[0] == '\0' || strcmp(arguments, "list") == 0) {
+        listMotionTables();
+    } else if (strncmp(arguments, "show ", 5) == 0) {
+        showMotionTable(arguments + 5);
+    } else if (strncmp(arguments, "begin ", 6) == 0) {
+        beginMotionTable(arguments + 6);
+    } else if (strncmp(arguments, "add ", 4) == 0) {
+        addMotionSteps(arguments + 4);
+    } else if (strcmp(arguments, "commit") == 0) {
+        commitMotionTable();
+    } else if (strncmp(arguments, "reset ", 6) == 0) {
+        resetMotionTable(arguments + 6);
+    } else {
+        Serial.print("Unknown seq command: ");
+        Serial.println(arguments);
+    }
+}
+
+//* ************************************************************************
+//* ************************** MACHINE COMMANDS ****************************
+//* ************************************************************************
+// The state in force when the control task drains the command decides whether
+// it applies - the reply here only says it was queued; the outcome is logged.
+
+static void queueMachineCommand(ControlCommandType type, uint8_t arg) {
+    if (sendControlCommand(type, arg)) {
+        Serial.printf("%s queued.\n", getControlCommandName(type));
+    } else {
+        Serial.println("Control command ring full - try again.");
+    }
+}
+
+static void listRecipes() {
+    uint8_t active = getActiveRecipeIndex();
+    Serial.println("Material recipes:");
+    for (uint8_t i = 0; i < getRecipeCount(); i++) {
+        const MaterialRecipe& recipe = getRecipe(i);
+        Serial.printf("  %c %-10s feed travel %.2f in, rotation clamp closed %.2f in before end\n",
+                      i == active ? '*' : ' ', recipe.name,
+                      recipe.feedTravelDistanceInches, recipe.rotationClampClosedOffsetInches);
+        Serial.printf("               blade contact %.2f in, blade clear %.2f in, cut feed %.0f steps/s\n",
+                      recipe.bladeContactInches, recipe.bladeClearInches, recipe.cutFeedSpeed);
+    }
+}
+
+static void selectRecipeByName(const char* name) {
+    uint8_t index = findRecipe(name);
+    if (index == MATERIAL_RECIPE_NONE) {
+        Serial.print("Unknown recipe: ");
+        Serial.println(name);
+        return;
+    }
+    queueMachineCommand(CONTROL_CMD_SELECT_RECIPE, index);
+}
+
+static void runConsoleCommand(char* line) {
+    if (strcmp(line, "help") == 0) {
+        printConsoleHelp();
+    } else if (strcmp(line, "latency") == 0) {
+        printLoopLatencyReport(Serial);
+    } else if (strcmp(line, "latency csv") == 0) {
+        printLoopLatencyCsv(Serial);
+    } else if (strcmp(line, "latency reset") == 0) {
+        // Histograms are owned by the control task - ask it to clear them
+        if (sendControlCommand(CONTROL_CMD_RESET_LATENCY)) {
+            Serial.println("Loop latency reset requested.");
+        } else {
+            Serial.println("Control command ring full - try again.");
+        }
+    } else if (strcmp(line, "stops") == 0) {
+        printStopInterruptReport(Serial);
+    } else if (strcmp(line, "stops reset") == 0) {
+        resetStopInterruptStats();
+        Serial.println("Stop interrupt counters cleared.");
+    } else if (strcmp(line, "budget") == 0) {
+        printControlExecutiveReport(Serial);
+    } else if (strcmp(line, "budget reset") == 0) {
+        resetControlExecutiveStats();
+        Serial.println("Budget counters cleared.");
+    } else if (strcmp(line, "events") == 0) {
+        printInputEventReport(Serial);
+    } else if (strcmp(line, "events reset") == 0) {
+        resetInputEventStats();
+        Serial.println("Input event counters cleared.");
+    } else if (strcmp(line, "watchdog") == 0) {
+        printStateWatchdogReport(Serial);
+    } else if (strcmp(line, "watchdog reset") == 0) {
+        resetStateWatchdogStats();
+        Serial.println("Watchdog counters cleared.");
+    } else if (strcmp(line, "triggers") == 0) {
+        printPositionTriggerReport(Serial);
+    } else if (strcmp(line, "triggers reset") == 0) {
+        resetPositionTriggerStats();
+        Serial.println("Position trigger counters cleared.");
+    } else if (strcmp(line, "chain") == 0) {
+        printFeedChainReport(Serial);
+    } else if (strcmp(line, "chain reset") == 0) {
+        resetFeedChainStats();
+        Serial.println("Feed chain counters cleared.");
+    } else if (strcmp(line, "homing") == 0) {
+        printHomingReport(Serial);
+    } else if (strcmp(line, "homing reset") == 0) {
+        resetHomingStats();
+        Serial.println("Homing counters cleared.");
+    } else if (strcmp(line, "drift") == 0) {
+        printHomeDriftReport(Serial);
+    } else if (strcmp(line, "drift reset") == 0) {
+        resetHomeDriftStats();
+        Serial.println("Home drift samples cleared.");
+    } else if (strcmp(line, "start") == 0) {
+        queueMachineCommand(CONTROL_CMD_START_CYCLE, 0);
+    } else if (strcmp(line, "stop") == 0) {
+        queueMachineCommand(CONTROL_CMD_STOP_CYCLE, 0);
+    } else if (strcmp(line, "recipe") == 0) {
+        listRecipes();
+    } else if (strncmp(line, "recipe ", 7) == 0) {
+        selectRecipeByName(line + 7);
+    } else if (strcmp(line, "status") == 0) {
+        queueMachineCommand(CONTROL_CMD_LOG_STATUS, 0);
+    } else if (strcmp(line, "telemetry") == 0) {
+        printTelemetryReport(Serial);
+    } else if (strcmp(line, "commands") == 0) {
+        printCommandRingReport(Serial);
+    } else if (strcmp(line, "commands reset") == 0) {
+        resetCommandRingStats();
+        Serial.println("Control command counters cleared.");
+    } else if (strcmp(line, "seq") == 0) {
+        runMotionTableCommand(line + 3);
+    } else if (strncmp(line, "seq ", 4) == 0) {
+        runMotionTableCommand(line + 4);
+    } else if (line[0] != '\0') {
+        Serial.print("Unknown command: ");
+        Serial.println(line);
+        printConsoleHelp();
+    }
+}
+
+// Commands cheap enough to run while comms work is shed - they only push to the ring
+static bool isMachineCommand(const char* line) {
+    return strcmp(line, "start") == 0 || strcmp(line, "stop") == 0 || strcmp(line, "status") == 0;
+}
+
+void handleSerialConsole(bool machineCommandsOnly) {
+    while (Serial.available() > 0) {
+        char c = (char)Serial.read();
+        if (c == '\r') continue;
+
+        if (c == '\n') {
+            consoleLine[consoleLineLength] = '\0';
+            if (machineCommandsOnly && consoleLine[0] != '\0' && !isMachineCommand(consoleLine)) {
+                Serial.println("Cycle running - only start/stop/status until it ends.");
+            } else {
+                runConsoleCommand(consoleLine);
+            }
+            consoleLineLength = 0;
+        } else if (consoleLineLength < CONSOLE_LINE_MAX_LENGTH - 1) {
+            consoleLine[consoleLineLength++] = c;
+        }
+    }
+}
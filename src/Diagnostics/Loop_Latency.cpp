@@ -0,0 +1,134 @@
+#include "Diagnostics/Loop_Latency.h"
+#include "StateMachine/StateManager.h"
+
+//* ************************************************************************
+//* ************************ LOOP LATENCY HISTOGRAM ************************
+//* ************************************************************************
+// Bucket layout: values 0-3 us get one bucket each. Above that every power of
+// two is split into 4 linear sub-buckets, so bucket index = 4 * (msb - 1) + sub.
+// Samples past the last bucket are clamped into it (max is still exact).
+
+const int LATENCY_SUB_BUCKET_BITS = 2;
+const int LATENCY_SUB_BUCKETS = 1 << LATENCY_SUB_BUCKET_BITS;
+const int LATENCY_MAX_MSB = 24;                                   // 2^25 us = ~33 s
+const int LATENCY_BUCKET_COUNT = LATENCY_SUB_BUCKETS * LATENCY_MAX_MSB;
+
+// Any pass longer than this means a handler blocked (delay() or a busy-wait loop)
+const uint32_t LOOP_BLOCKING_THRESHOLD_US = 1000;
+
+struct LoopLatencyHistogram {
+    uint32_t buckets[LATENCY_BUCKET_COUNT];
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t blockedCount;
+    uint64_t totalUs;
+};
+
+static LoopLatencyHistogram histograms[SYSTEM_STATE_COUNT];
+
+static int latencyBucketIndex(uint32_t valueUs) {
+    if (valueUs < (uint32_t)LATENCY_SUB_BUCKETS) {
+        return valueUs;
+    }
+    int msb = 31 - __builtin_clz(valueUs);
+    int sub = (valueUs >> (msb - LATENCY_SUB_BUCKET_BITS)) - LATENCY_SUB_BUCKETS;
+    int index = LATENCY_SUB_BUCKETS * (msb - 1) + sub;
+    return index < LATENCY_BUCKET_COUNT ? index : LATENCY_BUCKET_COUNT - 1;
+}
+
+// Largest value that falls into a bucket - percentiles are reported as this upper bound
+static uint32_t latencyBucketUpperBound(int index) {
+    if (index < LATENCY_SUB_BUCKETS) {
+        return index;
+    }
+    int msb = index / LATENCY_SUB_BUCKETS + 1;
+    int sub = index % LATENCY_SUB_BUCKETS;
+    uint32_t width = 1UL << (msb - LATENCY_SUB_BUCKET_BITS);
+    return (uint32_t)(LATENCY_SUB_BUCKETS + sub) * width + width - 1;
+}
+
+static uint32_t latencyPercentile(const LoopLatencyHistogram& histogram, uint32_t permille) {
+    // Rank of the sample at the requested per-mille, rounded up
+    uint64_t rank = ((uint64_t)histogram.count * permille + 999) / 1000;
+    if (rank == 0) rank = 1;
+
+    uint64_t cumulative = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        cumulative += histogram.buckets[i];
+        if (cumulative >= rank) {
+            uint32_t upper = latencyBucketUpperBound(i);
+            return upper < histogram.maxUs ? upper : histogram.maxUs;
+        }
+    }
+    return histogram.maxUs;
+}
+
+//* ************************************************************************
+//* ************************ RECORDING *************************************
+//* ************************************************************************
+
+void recordLoopLatency(SystemState state, unsigned long elapsedUs) {
+    if (state < 0 || state >= SYSTEM_STATE_COUNT) return;
+
+    LoopLatencyHistogram& histogram = histograms[state];
+    if (histogram.count == 0 || elapsedUs < histogram.minUs) histogram.minUs = elapsedUs;
+    if (elapsedUs > histogram.maxUs) histogram.maxUs = elapsedUs;
+    if (elapsedUs > LOOP_BLOCKING_THRESHOLD_US) histogram.blockedCount++;
+    histogram.totalUs += elapsedUs;
+    histogram.count++;
+    histogram.buckets[latencyBucketIndex(elapsedUs)]++;
+}
+
+void resetLoopLatency() {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+//* ************************************************************************
+//* ************************ REPORTING *************************************
+//* ************************************************************************
+// Reports are produced on the comms task while the control task keeps recording,
+// so a summary can be off by the few samples recorded while it was computed.
+
+bool getLoopLatencySummary(SystemState state, LoopLatencySummary& summary) {
+    if (state < 0 || state >= SYSTEM_STATE_COUNT) return false;
+
+    const LoopLatencyHistogram& histogram = histograms[state];
+    if (histogram.count == 0) return false;
+
+    summary.count = histogram.count;
+    summary.minUs = histogram.minUs;
+    summary.maxUs = histogram.maxUs;
+    summary.blockedCount = histogram.blockedCount;
+    summary.meanUs = histogram.totalUs / histogram.count;
+    summary.p50Us = latencyPercentile(histogram, 500);
+    summary.p99Us = latencyPercentile(histogram, 990);
+    summary.p999Us = latencyPercentile(histogram, 999);
+    return true;
+}
+
+void printLoopLatencyReport(Print& out) {
+    out.println("Loop latency per state (us):");
+    out.printf("%-24s %10s %8s %8s %8s %8s %8s %8s %8s\n",
+               "STATE", "COUNT", "MIN", "MEAN", "P50", "P99", "P99.9", "MAX", ">1MS");
+
+    LoopLatencySummary summary;
+    for (int state = 0; state < SYSTEM_STATE_COUNT; state++) {
+        if (!getLoopLatencySummary((SystemState)state, summary)) continue;
+        out.printf("%-24s %10lu %8lu %8lu %8lu %8lu %8lu %8lu %8lu\n",
+                   getStateName((SystemState)state), summary.count, summary.minUs, summary.meanUs,
+                   summary.p50Us, summary.p99Us, summary.p999Us, summary.maxUs, summary.blockedCount);
+    }
+}
+
+void printLoopLatencyCsv(Print& out) {
+    out.println("state,count,min_us,mean_us,p50_us,p99_us,p999_us,max_us,blocked");
+
+    LoopLatencySummary summary;
+    for (int state = 0; state < SYSTEM_STATE_COUNT; state++) {
+        if (!getLoopLatencySummary((SystemState)state, summary)) continue;
+        out.printf("%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                   getStateName((SystemState)state), summary.count, summary.minUs, summary.meanUs,
+                   summary.p50Us, summary.p99Us, summary.p999Us, summary.maxUs, summary.blockedCount);
+    }
+}
@@ -0,0 +1,112 @@
+#include "Diagnostics/Telemetry.h"
+#include <atomic>
+#include "StateMachine/StateManager.h"
+#include "StateMachine/STATES/States_Config.h"
+#include "Config/Material_Recipes.h"
+#include "Timing/Timebase.h"
+
+extern Bounce pushwoodForwardSwitch;   // From main.cpp
+
+//* ************************************************************************
+//* *************************** TELEMETRY **********************************
+//* ************************************************************************
+
+static TelemetrySnapshot publishedSnapshot;
+static std::atomic<uint32_t> telemetrySequence(0);   // Odd = write in progress, 0 = never published
+static uint32_t telemetryPassCount = 0;              // Control task only
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+static void buildTelemetrySnapshot(TelemetrySnapshot& snapshot, bool controlPaused) {
+    FastAccelStepper* cutMotor = getCutMotor();
+    FastAccelStepper* feedMotor = getFeedMotor();
+
+    snapshot.passCount = ++telemetryPassCount;
+    snapshot.timestampUs = nowUs();
+
+    snapshot.state = getCurrentState();
+    snapshot.previousState = getPreviousState();
+    snapshot.recipeIndex = getActiveRecipeIndex();
+    snapshot.controlPaused = controlPaused;
+
+    snapshot.cuttingCycleInProgress = getCuttingCycleInProgress();
+    snapshot.continuousModeActive = getContinuousModeActive();
+    snapshot.reloadMode = getIsReloadMode();
+    snapshot.startSwitchSafe = getStartSwitchSafe();
+    snapshot.cycleStopRequested = getCycleStopRequested();
+    snapshot.woodSuctionError = getWoodSuctionError();
+    snapshot.consecutiveYeswoodCount = getConsecutiveYeswoodCount();
+
+    snapshot.cutHomeSwitch = getCutHomingSwitch()->read() == HIGH;
+    snapshot.feedHomeSwitch = getFeedHomingSwitch()->read() == HIGH;
+    snapshot.reloadSwitch = getReloadSwitch()->read() == HIGH;
+    snapshot.startCycleSwitch = getStartCycleSwitch()->read() == HIGH;
+    snapshot.pushwoodSwitch = pushwoodForwardSwitch.read() == HIGH;
+    snapshot.suctionSensor = getSuctionSensorBounce()->read() == HIGH;
+    snapshot.woodPresent = get2x4Present();
+
+    snapshot.cutPositionSteps = cutMotor ? cutMotor->getCurrentPosition() : 0;
+    snapshot.feedPositionSteps = feedMotor ? feedMotor->getCurrentPosition() : 0;
+    snapshot.cutRunning = cutMotor && cutMotor->isRunning();
+    snapshot.feedRunning = feedMotor && feedMotor->isRunning();
+}
+
+void publishTelemetrySnapshot(bool controlPaused) {
+    // Gather first so the odd (in-progress) window is only the struct copy
+    TelemetrySnapshot snapshot;
+    buildTelemetrySnapshot(snapshot, controlPaused);
+
+    uint32_t sequence = telemetrySequence.load(std::memory_order_relaxed);
+    telemetrySequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);   // Odd sequence visible before the data changes
+    publishedSnapshot = snapshot;
+    telemetrySequence.store(sequence + 2, std::memory_order_release);
+}
+
+//* ************************************************************************
+//* **************************** READERS ***********************************
+//* ************************************************************************
+
+bool readTelemetrySnapshot(TelemetrySnapshot& snapshot) {
+    for (uint8_t attempt = 0; attempt < TELEMETRY_READ_ATTEMPTS; attempt++) {
+        uint32_t before = telemetrySequence.load(std::memory_order_acquire);
+        if (before == 0) return false;
+        if (before & 1) continue;
+
+        memcpy(&snapshot, &publishedSnapshot, sizeof(snapshot));
+
+        std::atomic_thread_fence(std::memory_order_acquire);   // Copy done before the sequence is re-read
+        if (telemetrySequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+void printTelemetryReport(Print& out) {
+    TelemetrySnapshot snapshot;
+    if (!readTelemetrySnapshot(snapshot)) {
+        out.println("Telemetry: no snapshot available.");
+        return;
+    }
+
+    out.printf("Telemetry (pass %lu, %llu us):\n", (unsigned long)snapshot.passCount,
+               (unsigned long long)snapshot.timestampUs);
+    out.printf("  State:     %s (from %s)%s\n", getStateName((SystemState)snapshot.state),
+               getStateName((SystemState)snapshot.previousState),
+               snapshot.controlPaused ? " - paused for OTA" : "");
+    out.printf("  Recipe:    %s\n", getRecipe(snapshot.recipeIndex).name);
+    out.printf("  Cycle:     in progress %d, continuous %d, reload %d, start safe %d, stop requested %d\n",
+               snapshot.cuttingCycleInProgress, snapshot.continuousModeActive, snapshot.reloadMode,
+               snapshot.startSwitchSafe, snapshot.cycleStopRequested);
+    out.printf("  Errors:    suction %d, consecutive yes-wood %d\n",
+               snapshot.woodSuctionError, snapshot.consecutiveYeswoodCount);
+    out.printf("  Inputs:    cut home %d, feed home %d, reload %d, start %d, pushwood %d, suction %d, 2x4 %d\n",
+               snapshot.cutHomeSwitch, snapshot.feedHomeSwitch, snapshot.reloadSwitch,
+               snapshot.startCycleSwitch, snapshot.pushwoodSwitch, snapshot.suctionSensor,
+               snapshot.woodPresent);
+    out.printf("  Cut axis:  %.3f in%s\n", (float)snapshot.cutPositionSteps / CUT_MOTOR_STEPS_PER_INCH,
+               snapshot.cutRunning ? " (running)" : "");
+    out.printf("  Feed axis: %.3f in%s\n", (float)snapshot.feedPositionSteps / FEED_MOTOR_STEPS_PER_INCH,
+               snapshot.feedRunning ? " (running)" : "");
+}
@@ -1,6 +1,7 @@
 #include "ErrorStates/Cut_Motor_Error.h"
 #include "ErrorStates/Error_Reset.h"  // For error timing constants
 #include "StateMachine/StateManager.h"
+#include "Timing/Timebase.h"
 
 // External references to functions from main.cpp (LED and motor functions only)
 extern void turnRedLedOn();
@@ -20,14 +21,14 @@ extern void stopFeedMotor();
 // Step 4: Once error is acknowledged, transition to ERROR_RESET state.
 void handleCutMotorErrorState() {
     // Blink error LEDs using StateManager timing
-    if (millis() - getLastErrorBlinkTime() > STANDARD_ERROR_BLINK_INTERVAL) {
+    if (msSince(getLastErrorBlinkTime()) > STANDARD_ERROR_BLINK_INTERVAL) {
         bool newBlinkState = !getErrorBlinkState();
         setErrorBlinkState(newBlinkState);
         
         if(newBlinkState) turnRedLedOn(); else turnRedLedOff();
         if(!newBlinkState) turnYellowLedOn(); else turnYellowLedOff();
         
-        setLastErrorBlinkTime(millis());
+        setLastErrorBlinkTime(nowUs());
     }
     
     // Keep motors stopped
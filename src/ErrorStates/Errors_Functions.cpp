@@ -1,6 +1,10 @@
 // IMPORTANT NOTE: This file contains helper functions specifically used by the error handling system.
 // It relies on the main file for pin definitions and global variable declarations (via extern).
 #include "ErrorStates/Errors_Functions.h"
+#include "Tasks/Task_Layout.h"
+#include "Timing/Deadline.h"
+#include "Timing/Timebase.h"
+#include "StateMachine/STATES/States_Config.h"
 
 //* ************************************************************************
 //* *************************** ERROR LED FUNCTIONS ************************
@@ -8,17 +12,17 @@
 // Contains LED functions specifically for error state handling.
 
 void handleErrorLedBlink() {
-    if (millis() - lastErrorBlinkTime > 250) {
+    if (msSince(lastErrorBlinkTime) > 250) {
         errorBlinkState = !errorBlinkState;
         if(errorBlinkState) turnRedLedOn(); else turnRedLedOff();
         if(!errorBlinkState) turnYellowLedOn(); else turnYellowLedOff();
-        lastErrorBlinkTime = millis();
+        lastErrorBlinkTime = nowUs();
     }
 }
 
-void handleSuctionErrorLedBlink(unsigned long& lastBlinkTimeRef, bool& blinkStateRef) {
-    if (millis() - lastBlinkTimeRef >= 1500) {
-        lastBlinkTimeRef = millis();
+void handleSuctionErrorLedBlink(uint64_t& lastBlinkTimeRef, bool& blinkStateRef) {
+    if (msSince(lastBlinkTimeRef) >= 1500) {
+        lastBlinkTimeRef = nowUs();
         blinkStateRef = !blinkStateRef;
         if(blinkStateRef) turnRedLedOn(); else turnRedLedOff();
     }
@@ -62,6 +66,7 @@ const float CUT_MOTOR_HOME_RECOVERY_SPEED = 1000; // Recovery speed (same as hom
 CutMotorHomeErrorResult createSuccessResult() {
     CutMotorHomeErrorResult result;
     result.wasHomeDetected = true;
+    result.isInProgress = false;
     result.shouldTransitionToError = false;
     result.shouldAttemptSlowRecovery = false;
     result.shouldContinueWithWarning = false;
@@ -73,6 +78,7 @@ CutMotorHomeErrorResult createSuccessResult() {
 CutMotorHomeErrorResult createErrorTransitionResult(const String& message) {
     CutMotorHomeErrorResult result;
     result.wasHomeDetected = false;
+    result.isInProgress = false;
     result.shouldTransitionToError = true;
     result.shouldAttemptSlowRecovery = false;
     result.shouldContinueWithWarning = false;
@@ -84,6 +90,7 @@ CutMotorHomeErrorResult createErrorTransitionResult(const String& message) {
 CutMotorHomeErrorResult createWarningOnlyResult(const String& message) {
     CutMotorHomeErrorResult result;
     result.wasHomeDetected = false;
+    result.isInProgress = false;
     result.shouldTransitionToError = false;
     result.shouldAttemptSlowRecovery = false;
     result.shouldContinueWithWarning = true;
@@ -91,6 +98,18 @@ CutMotorHomeErrorResult createWarningOnlyResult(const String& message) {
     return result;
 }
 
+//! IN PROGRESS RESULT - Check still running, call again on the next loop pass
+CutMotorHomeErrorResult createInProgressResult() {
+    CutMotorHomeErrorResult result;
+    result.wasHomeDetected = false;
+    result.isInProgress = true;
+    result.shouldTransitionToError = false;
+    result.shouldAttemptSlowRecovery = false;
+    result.shouldContinueWithWarning = false;
+    result.errorMessage = "";
+    return result;
+}
+
 // ========================================================================
 //! REAL-TIME HOME SENSOR MONITORING SYSTEM
 // ========================================================================
@@ -109,7 +128,7 @@ void performCutMotorRealTimeHomeSensorCheck(FastAccelStepper* cutMotor, Bounce&
         VERIFYING_SENSOR     // Verification delay complete, confirming sensor state
     } realTimeCheckState = MONITORING;
     
-    static unsigned long verificationDelayStartTime = 0;
+    static uint64_t verificationDelayStartTime = 0;
     
     //! SAFETY DISTANCE AND TIMING CONSTANTS
     const float DECELERATION_DISTANCE_INCHES = 0.2; // Maximum 0.2 inch deceleration distance
@@ -132,15 +151,11 @@ void performCutMotorRealTimeHomeSensorCheck(FastAccelStepper* cutMotor, Bounce&
                     
                     //! Set high deceleration for quick but controlled stop within safety distance
                     cutMotor->setAcceleration(30000); // High deceleration for quick stop within 0.2 inch
+                    cutMotor->setLinearAcceleration(0); // No S-curve tail on this stop
                     cutMotor->moveTo(targetPosition);
                     
-                    Serial.print("Decelerating from position ");
-                    Serial.print(currentPosition);
-                    Serial.print(" to target position ");
-                    Serial.print(targetPosition);
-                    Serial.print(" (");
-                    Serial.print(DECELERATION_DISTANCE_INCHES);
-                    //serial.println(" inch max distance)");
+                    logMessage("Decelerating from position %ld to target position %ld (%.2f inch max distance)",
+                               currentPosition, targetPosition, DECELERATION_DISTANCE_INCHES);
                     
                     realTimeCheckState = DECELERATING;
                 }
@@ -151,7 +166,7 @@ void performCutMotorRealTimeHomeSensorCheck(FastAccelStepper* cutMotor, Bounce&
                 // Check if motor has completed controlled deceleration
                 if (!cutMotor->isRunning()) {
                     // Motor has stopped after controlled deceleration, start verification delay
-                    verificationDelayStartTime = millis();
+                    verificationDelayStartTime = nowUs();
                     realTimeCheckState = WAITING_FOR_DELAY;
                     //serial.println("Cut motor deceleration complete. Starting 30ms sensor verification delay...");
                 }
@@ -164,7 +179,7 @@ void performCutMotorRealTimeHomeSensorCheck(FastAccelStepper* cutMotor, Bounce&
             //! DELAY PHASE - Wait for sensor to stabilize before verification
             case WAITING_FOR_DELAY:
                 // Wait for the 30ms verification delay to complete
-                if (millis() - verificationDelayStartTime >= SENSOR_VERIFICATION_DELAY_MS) {
+                if (msSince(verificationDelayStartTime) >= SENSOR_VERIFICATION_DELAY_MS) {
                     realTimeCheckState = VERIFYING_SENSOR;
                 }
                 break;
@@ -203,120 +218,126 @@ void performCutMotorRealTimeHomeSensorCheck(FastAccelStepper* cutMotor, Bounce&
 //! PRIMARY CUT MOTOR HOME ERROR DETECTION WITH RECOVERY CAPABILITY
 //! This is the main function that handles all cut motor home position verification
 //! and implements slow recovery when initial detection fails.
+//! NON-BLOCKING: call once per loop pass until the result is no longer isInProgress.
+//! Sensor settle delays and the recovery poll use the deadline service instead of delay().
+
+static enum {
+    HOME_CHECK_IDLE,        // No check running - next call starts phase 1
+    HOME_CHECK_VERIFYING,   // Phase 1: up to 3 reads spaced by the settle delay
+    HOME_CHECK_RECOVERING   // Phase 2: slow recovery move toward the switch
+} homeCheckPhase = HOME_CHECK_IDLE;
+
+static int homeCheckAttemptNumber = 0;
+static Deadline homeCheckSettleDeadline = {0, 0, false};
+static Deadline homeCheckRecoveryDeadline = {0, 0, false};
+
 CutMotorHomeErrorResult handleCutMotorHomeError(
     Bounce& cutHomingSwitch, 
     FastAccelStepper* cutMotor, 
     const String& contextDescription,
     bool allowSlowRecovery
 ) {
-    bool sensorDetectedHome = false;
-    Serial.print("ERROR DETECTION: Checking cut motor home position for context: ");
-    //serial.println(contextDescription);
+    if (homeCheckPhase == HOME_CHECK_IDLE) {
+        logMessage("ERROR DETECTION: Checking cut motor home position for context: %s", contextDescription.c_str());
+        homeCheckAttemptNumber = 0;
+        clearDeadline(homeCheckSettleDeadline);
+        homeCheckPhase = HOME_CHECK_VERIFYING;
+    }
     
     // ====================================================================
     //! PHASE 1: INITIAL HOME VERIFICATION (3-try approach)
     // ====================================================================
     
-    for (int attemptNumber = 1; attemptNumber <= 3; attemptNumber++) {
-        delay(30);  // Brief delay for sensor stabilization
+    if (homeCheckPhase == HOME_CHECK_VERIFYING) {
+        // Brief non-blocking delay for sensor stabilization before each read
+        if (!waitForDeadline(homeCheckSettleDeadline, SENSOR_STABILIZATION_DELAY_MS)) {
+            return createInProgressResult();
+        }
+        homeCheckAttemptNumber++;
         cutHomingSwitch.update();
-        Serial.print("Initial home verification attempt ");
-        Serial.print(attemptNumber);
-        Serial.print(" of 3: ");
-        //serial.println(cutHomingSwitch.read() == HIGH ? "HOME DETECTED" : "NO HOME");
+        logMessage("Initial home verification attempt %d of 3: %s",
+                   homeCheckAttemptNumber, cutHomingSwitch.read() == HIGH ? "HOME DETECTED" : "NO HOME");
         
         if (cutHomingSwitch.read() == HIGH) {
-            sensorDetectedHome = true;
             if (cutMotor) {
                 cutMotor->setCurrentPosition(0); // Recalibrate position to absolute zero
             }
-            Serial.print("SUCCESS: Cut motor home position confirmed on initial check for ");
-            //serial.println(contextDescription);
+            logMessage("SUCCESS: Cut motor home position confirmed on initial check for %s", contextDescription.c_str());
+            homeCheckPhase = HOME_CHECK_IDLE;
             return createSuccessResult();
         }
-    }
-    
-    // ====================================================================
-    //! PHASE 2: SLOW RECOVERY ATTEMPT (if enabled for this context)
-    // ====================================================================
-    
-    if (!sensorDetectedHome && allowSlowRecovery) {
-        //serial.println("INITIATING SLOW RECOVERY: Moving cut motor slowly back to home at homing speed...");
+        if (homeCheckAttemptNumber < 3) {
+            return createInProgressResult();
+        }
         
-        if (cutMotor) {
-            //! CONFIGURE MOTOR FOR RECOVERY MOVEMENT
-            cutMotor->setSpeedInHz(CUT_MOTOR_HOME_RECOVERY_SPEED);
-            cutMotor->setAcceleration(10000); // Moderate acceleration for controlled movement
-            
-            //! START RECOVERY MOVEMENT (backward toward home)
-            cutMotor->runBackward();
-            
-            unsigned long recoveryStartTime = millis();
-            bool homeFoundDuringRecovery = false;
-            
-            Serial.print("Slow recovery started at homing speed (");
-            Serial.print(CUT_MOTOR_HOME_RECOVERY_SPEED);
-            //serial.println(" steps/sec) with 5-second timeout...");
-            
-            //! MONITOR FOR HOME SENSOR DETECTION DURING RECOVERY
-            while ((millis() - recoveryStartTime) < CUT_MOTOR_HOME_RECOVERY_TIMEOUT_MS) {
-                cutHomingSwitch.update();
-                
-                if (cutHomingSwitch.read() == HIGH) {
-                    //! HOME SENSOR DETECTED DURING RECOVERY!
-                    cutMotor->forceStopAndNewPosition(0);
-                    homeFoundDuringRecovery = true;
-                    
-                    unsigned long recoveryDuration = millis() - recoveryStartTime;
-                    Serial.print("SUCCESS: Home sensor detected during slow recovery after ");
-                    Serial.print(recoveryDuration);
-                    //serial.println(" ms. Cut motor position recalibrated to 0.");
-                    
-                    String successMessage = "Recovery successful for " + contextDescription + 
-                                          " after " + String(recoveryDuration) + " ms";
-                    return createSuccessResult();
-                }
-                
-                // Small delay to prevent excessive sensor polling
-                delay(10);
-            }
-            
-            //! RECOVERY TIMEOUT - Stop motor and report error
-            cutMotor->forceStopAndNewPosition(cutMotor->getCurrentPosition());
-            
-            if (!homeFoundDuringRecovery) {
-                String timeoutErrorMessage = String("CRITICAL ERROR: Recovery timeout after 5 seconds. ") +
-                                           String("Cut motor failed to find home position during slow recovery for context: ") + 
-                                           contextDescription;
-                //serial.println(timeoutErrorMessage);
-                return createErrorTransitionResult(timeoutErrorMessage);
-            }
-        } else {
+        // ====================================================================
+        //! PHASE 3: HANDLE CASES WHERE SLOW RECOVERY IS DISABLED
+        // ====================================================================
+        
+        if (!allowSlowRecovery) {
+            //? Slow recovery not allowed for this context (currently only used for NO_WOOD sequences)
+            homeCheckPhase = HOME_CHECK_IDLE;
+            String warningMessage = String("WARNING: Cut motor home sensor did not detect home for ") + contextDescription + 
+                                  String(", but slow recovery disabled. Proceeding with warning.");
+            //serial.println(warningMessage);
+            return createWarningOnlyResult(warningMessage);
+        }
+        
+        // ====================================================================
+        //! PHASE 2: SLOW RECOVERY ATTEMPT (if enabled for this context)
+        // ====================================================================
+        
+        //serial.println("INITIATING SLOW RECOVERY: Moving cut motor slowly back to home at homing speed...");
+        if (!cutMotor) {
+            homeCheckPhase = HOME_CHECK_IDLE;
             String motorErrorMessage = "CRITICAL ERROR: Cut motor object is null during recovery for context: " + contextDescription;
             //serial.println(motorErrorMessage);
             return createErrorTransitionResult(motorErrorMessage);
         }
-    } 
-    // ====================================================================
-    //! PHASE 3: HANDLE CASES WHERE SLOW RECOVERY IS DISABLED
-    // ====================================================================
+        
+        //! CONFIGURE MOTOR FOR RECOVERY MOVEMENT
+        cutMotor->setSpeedInHz(CUT_MOTOR_HOME_RECOVERY_SPEED);
+        cutMotor->setAcceleration(10000); // Moderate acceleration for controlled movement
+        
+        //! START RECOVERY MOVEMENT (backward toward home)
+        cutMotor->runBackward();
+        startDeadline(homeCheckRecoveryDeadline, CUT_MOTOR_HOME_RECOVERY_TIMEOUT_MS);
+        homeCheckPhase = HOME_CHECK_RECOVERING;
+        
+        logMessage("Slow recovery started at homing speed (%.0f steps/sec) with 5-second timeout...",
+                   CUT_MOTOR_HOME_RECOVERY_SPEED);
+        return createInProgressResult();
+    }
     
-    else if (!allowSlowRecovery) {
-        //? Slow recovery not allowed for this context (currently only used for NO_WOOD sequences)
-        String warningMessage = String("WARNING: Cut motor home sensor did not detect home for ") + contextDescription + 
-                              String(", but slow recovery disabled. Proceeding with warning.");
-        //serial.println(warningMessage);
-        return createWarningOnlyResult(warningMessage);
+    //! MONITOR FOR HOME SENSOR DETECTION DURING RECOVERY (one poll per loop pass)
+    cutHomingSwitch.update();
+    
+    if (cutHomingSwitch.read() == HIGH) {
+        //! HOME SENSOR DETECTED DURING RECOVERY!
+        if (cutMotor) cutMotor->forceStopAndNewPosition(0);
+        homeCheckPhase = HOME_CHECK_IDLE;
+        
+        unsigned long recoveryDuration = msSince(homeCheckRecoveryDeadline.startUs);
+        clearDeadline(homeCheckRecoveryDeadline);
+        logMessage("SUCCESS: Home sensor detected during slow recovery after %lu ms. Cut motor position recalibrated to 0.",
+                   recoveryDuration);
+        return createSuccessResult();
     }
     
-    // ====================================================================
-    //! FINAL FALLBACK - All detection and recovery attempts failed
-    // ====================================================================
+    if (!isDeadlineExpired(homeCheckRecoveryDeadline)) {
+        return createInProgressResult();
+    }
+    
+    //! RECOVERY TIMEOUT - Stop motor and report error
+    if (cutMotor) cutMotor->forceStopAndNewPosition(cutMotor->getCurrentPosition());
+    clearDeadline(homeCheckRecoveryDeadline);
+    homeCheckPhase = HOME_CHECK_IDLE;
     
-    String finalErrorMessage = String("FAILED: Cut motor home sensor did not detect home position after 3 attempts. ") +
-                             String("Context: ") + contextDescription;
-    //serial.println(finalErrorMessage);
-    return createErrorTransitionResult(finalErrorMessage);
+    String timeoutErrorMessage = String("CRITICAL ERROR: Recovery timeout after 5 seconds. ") +
+                               String("Cut motor failed to find home position during slow recovery for context: ") + 
+                               contextDescription;
+    //serial.println(timeoutErrorMessage);
+    return createErrorTransitionResult(timeoutErrorMessage);
 }
 
 // ========================================================================
@@ -334,7 +355,7 @@ void executeCutMotorErrorStateTransition(
     int& cuttingSubStep7,
     int& fixPositionStep,
     int& fixPositionSubStep2,
-    unsigned long& errorStartTime,
+    uint64_t& errorStartTime,
     bool shouldExtend2x4SecureClamp
 ) {
     //serial.println("EXECUTING CUT MOTOR ERROR STATE TRANSITION");
@@ -363,7 +384,7 @@ void executeCutMotorErrorStateTransition(
     
     //! TRANSITION TO ERROR STATE
     currentState = ERROR;
-    errorStartTime = millis();
+    errorStartTime = nowUs();
     
     //! RESET ALL STATE MACHINE COUNTERS - Clean slate for restart
     cuttingStep = 0;
@@ -382,8 +403,7 @@ void executeCutMotorErrorStateTransition(
 //! LOG CUT MOTOR HOME ERROR RESULTS FOR DEBUGGING AND MONITORING
 void logCutMotorHomeErrorResult(const CutMotorHomeErrorResult& result) {
     if (!result.errorMessage.isEmpty()) {
-        Serial.print("Cut Motor Home Error Handler Result: ");
-        //serial.println(result.errorMessage);
+        logMessage("Cut Motor Home Error Handler Result: %s", result.errorMessage.c_str());
     }
     
     //! VISUAL STATUS INDICATORS FOR SERIAL MONITOR
@@ -2,6 +2,9 @@
 #include "ErrorStates/Error_Reset.h"  // For error timing constants
 #include "StateMachine/StateManager.h"
 #include <Bounce2.h>
+#include "Events/Input_Events.h"
+#include "Timing/Timebase.h"
+#include "StateMachine/FUNCTIONS/Homing.h"
 
 // External references to functions from main.cpp (LED functions only)
 extern void turnRedLedOn();
@@ -10,9 +13,7 @@ extern void turnYellowLedOff();
 extern void turnGreenLedOff();
 extern void turnBlueLedOff();
 
-// External references for cut motor homing
-extern void homeCutMotorBlocking(Bounce& homingSwitch, unsigned long timeout);
-extern Bounce cutHomingSwitch;
+const unsigned long SUCTION_ERROR_CUT_HOME_TIMEOUT_MS = 10000;
 
 //* ************************************************************************
 //* ********************* SUCTION ERROR ************************************
@@ -20,6 +21,8 @@ extern Bounce cutHomingSwitch;
 // Handles wood suction error detection and recovery.
 // This state is entered from CUTTING (Step 1) if the WOOD_SUCTION_CONFIRM_SENSOR indicates an error (LOW = no suction detected).
 // Step 1: Automatically home the cut motor upon entering this state for safety.
+//         Runs on the homing engine; the result arrives as an event and a failed
+//         run is retried up to HOMING_MAX_ATTEMPTS times.
 // Step 2: Slowly blink the red LED using defined suction error timing interval.
 // Step 3: Ensure yellow, green, and blue LEDs are off.
 // Step 4: Monitor the start cycle switch.
@@ -29,22 +32,24 @@ extern Bounce cutHomingSwitch;
 //          - Set continuousModeActive to false.
 //          - Set startSwitchSafe to false (requires user to cycle switch again for a new start).
 //          - Transition to HOMING state to re-initialize the system.
+static bool hasHomedCutMotor = false;
+static uint8_t cutHomingAttempts = 0;
+
 void handleSuctionErrorState() {
-    static bool hasHomedCutMotor = false;
-    static unsigned long lastSuctionErrorBlinkTime = 0;
+    static uint64_t lastSuctionErrorBlinkTime = 0;
     static bool suctionErrorBlinkState = false;
 
     // Step 1: Home cut motor immediately when entering this state (only once)
     if (!hasHomedCutMotor) {
         //serial.println("SUCTION ERROR: Automatically homing cut motor for safety...");
-        homeCutMotorBlocking(cutHomingSwitch, 10000); // 10 second timeout
+        startHomingAxis(HOMING_AXIS_CUT, SUCTION_ERROR_CUT_HOME_TIMEOUT_MS, false);
+        cutHomingAttempts = 1;
         hasHomedCutMotor = true;
-        //serial.println("Cut motor homing complete. Now monitoring for user reset.");
     }
 
     // Step 2: Blink STATUS_LED_RED using defined suction error timing interval
-    if (millis() - lastSuctionErrorBlinkTime >= SUCTION_ERROR_BLINK_INTERVAL) {
-        lastSuctionErrorBlinkTime = millis();
+    if (msSince(lastSuctionErrorBlinkTime) >= SUCTION_ERROR_BLINK_INTERVAL) {
+        lastSuctionErrorBlinkTime = nowUs();
         suctionErrorBlinkState = !suctionErrorBlinkState;
         if(suctionErrorBlinkState) turnRedLedOn(); else turnRedLedOff();
     }
@@ -54,16 +59,33 @@ void handleSuctionErrorState() {
     turnGreenLedOff();
     turnBlueLedOff();
 
-    // Step 4 & 5: Use StateManager to access switches instead of global variables
-    if (getStartCycleSwitch()->rose()) { // Check for start switch OFF to ON transition
-        //serial.println("Start cycle switch toggled ON. Resetting from suction error. Transitioning to HOMING.");
-        turnRedLedOff();   // Turn off error LED explicitly before changing state
-        
-        setContinuousModeActive(false); // Ensure continuous mode is off
-        
-        // Reset the homing flag for next time this state is entered
-        hasHomedCutMotor = false;
-        
-        changeState(HOMING);        // Go to HOMING to re-initialize using proper StateManager method
+    // Step 4 & 5: Start switch OFF to ON arrives as an event - see handleSuctionErrorEvent()
+}
+
+void handleSuctionErrorEvent(const InputEvent& event) {
+    if (event.type == EVENT_HOMING_DONE && event.detail == HOMING_AXIS_CUT) {
+        logMessage("SUCTION ERROR: cut motor homed - waiting for the start switch to reset");
+        return;
     }
-} 
\ No newline at end of file
+    if (event.type == EVENT_HOMING_FAILED && event.detail == HOMING_AXIS_CUT) {
+        if (cutHomingAttempts < HOMING_MAX_ATTEMPTS) {
+            cutHomingAttempts++;
+            logMessage("SUCTION ERROR: cut motor homing failed - attempt %u", cutHomingAttempts);
+            startHomingAxis(HOMING_AXIS_CUT, SUCTION_ERROR_CUT_HOME_TIMEOUT_MS, false);
+        } else {
+            logMessage("SUCTION ERROR: cut motor homing failed after %u attempts - reset re-homes from HOMING", cutHomingAttempts);
+        }
+        return;
+    }
+    if (event.type != EVENT_START_SWITCH_ON) return;
+
+    //serial.println("Start cycle switch toggled ON. Resetting from suction error. Transitioning to HOMING.");
+    turnRedLedOff();   // Turn off error LED explicitly before changing state
+    
+    setContinuousModeActive(false); // Ensure continuous mode is off
+    
+    // Reset the homing flag for next time this state is entered
+    hasHomedCutMotor = false;
+    
+    changeState(HOMING);        // Go to HOMING to re-initialize using proper StateManager method
+}
@@ -0,0 +1,185 @@
+#include "Events/Input_Events.h"
+#include "StateMachine/StateManager.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* *************************** INPUT EVENTS *******************************
+//* ************************************************************************
+
+extern Bounce pushwoodForwardSwitch;
+
+static const char* const INPUT_EVENT_NAMES[INPUT_EVENT_TYPE_COUNT] = {
+    "START_SWITCH_ON",
+    "START_SWITCH_OFF",
+    "RELOAD_SWITCH_ON",
+    "RELOAD_SWITCH_OFF",
+    "PUSHWOOD_PRESSED",
+    "PUSHWOOD_RELEASED",
+    "CUT_HOME_MADE",
+    "CUT_HOME_CLEARED",
+    "FEED_HOME_MADE",
+    "FEED_HOME_CLEARED",
+    "SUCTION_CONFIRMED",
+    "SUCTION_LOST",
+    "CUT_MOTOR_IDLE",
+    "FEED_MOTOR_IDLE",
+    "TIMER_EXPIRED",
+    "HOMING_DONE",
+    "HOMING_FAILED"
+};
+
+// Ring buffer - only the control task posts and pops, so no locking is needed here
+static InputEvent eventQueue[INPUT_EVENT_QUEUE_LENGTH];
+static uint8_t eventQueueHead = 0;     // Next to pop
+static uint8_t eventQueueCount = 0;
+static uint32_t nextEventSequence = 0;
+
+static uint32_t eventsThisPass = 0;    // Shim flags, eventBit() mask
+
+static bool cutMotorWasRunning = false;
+static bool feedMotorWasRunning = false;
+
+// Read by the console on the comms task
+static InputEventStats eventStats;
+static InputEventTraceEntry eventTrace[INPUT_EVENT_TRACE_LENGTH];
+static uint8_t eventTraceNext = 0;
+static uint8_t eventTraceCount = 0;
+static portMUX_TYPE eventStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Post the rising and falling edge of one debounced input
+static void pollSwitchEdges(Bounce& input, InputEventType onRise, InputEventType onFall) {
+    if (input.rose()) postInputEvent(onRise);
+    if (input.fell()) postInputEvent(onFall);
+}
+
+static void pollMotorIdle(FastAccelStepper* motor, bool& wasRunning, InputEventType idleEvent) {
+    if (!motor) return;
+    bool running = motor->isRunning();
+    if (wasRunning && !running) postInputEvent(idleEvent);
+    wasRunning = running;
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+void postInputEvent(InputEventType type, uint8_t detail) {
+    if (eventQueueCount >= INPUT_EVENT_QUEUE_LENGTH) {
+        portENTER_CRITICAL(&eventStatsMux);
+        eventStats.dropped++;
+        portEXIT_CRITICAL(&eventStatsMux);
+        return;
+    }
+    InputEvent& event = eventQueue[(eventQueueHead + eventQueueCount) % INPUT_EVENT_QUEUE_LENGTH];
+    event.type = type;
+    event.detail = detail;
+    event.sequence = nextEventSequence++;
+    event.timestampUs = nowUs();
+    eventQueueCount++;
+
+    portENTER_CRITICAL(&eventStatsMux);
+    eventStats.posted++;
+    portEXIT_CRITICAL(&eventStatsMux);
+}
+
+void pollInputEvents() {
+    // Polarity follows the wiring: start/reload/pushwood/cut home are active HIGH,
+    // the feed home sensor is active LOW, suction reads HIGH when the wood is grabbed
+    pollSwitchEdges(*getStartCycleSwitch(), EVENT_START_SWITCH_ON, EVENT_START_SWITCH_OFF);
+    pollSwitchEdges(*getReloadSwitch(), EVENT_RELOAD_SWITCH_ON, EVENT_RELOAD_SWITCH_OFF);
+    pollSwitchEdges(pushwoodForwardSwitch, EVENT_PUSHWOOD_PRESSED, EVENT_PUSHWOOD_RELEASED);
+    pollSwitchEdges(*getCutHomingSwitch(), EVENT_CUT_HOME_MADE, EVENT_CUT_HOME_CLEARED);
+    pollSwitchEdges(*getFeedHomingSwitch(), EVENT_FEED_HOME_CLEARED, EVENT_FEED_HOME_MADE);
+    pollSwitchEdges(*getSuctionSensorBounce(), EVENT_SUCTION_CONFIRMED, EVENT_SUCTION_LOST);
+
+    pollMotorIdle(getCutMotor(), cutMotorWasRunning, EVENT_CUT_MOTOR_IDLE);
+    pollMotorIdle(getFeedMotor(), feedMotorWasRunning, EVENT_FEED_MOTOR_IDLE);
+}
+
+uint32_t getNextInputEventSequence() {
+    return nextEventSequence;
+}
+
+bool popInputEvent(InputEvent& event) {
+    if (eventQueueCount == 0) return false;
+    event = eventQueue[eventQueueHead];
+    eventQueueHead = (eventQueueHead + 1) % INPUT_EVENT_QUEUE_LENGTH;
+    eventQueueCount--;
+    return true;
+}
+
+void beginInputEventPass() {
+    eventsThisPass = 0;
+}
+
+void recordDispatchedInputEvent(const InputEvent& event, uint8_t state, bool handled) {
+    eventsThisPass |= eventBit(event.type);
+
+    portENTER_CRITICAL(&eventStatsMux);
+    if (handled) eventStats.handled++; else eventStats.ignored++;
+    InputEventTraceEntry& entry = eventTrace[eventTraceNext];
+    entry.event = event;
+    entry.state = state;
+    entry.handled = handled;
+    eventTraceNext = (eventTraceNext + 1) % INPUT_EVENT_TRACE_LENGTH;
+    if (eventTraceCount < INPUT_EVENT_TRACE_LENGTH) eventTraceCount++;
+    portEXIT_CRITICAL(&eventStatsMux);
+}
+
+bool inputEventThisPass(InputEventType type) {
+    return (eventsThisPass & eventBit(type)) != 0;
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getInputEventStats(InputEventStats& stats) {
+    portENTER_CRITICAL(&eventStatsMux);
+    stats = eventStats;
+    portEXIT_CRITICAL(&eventStatsMux);
+}
+
+void resetInputEventStats() {
+    portENTER_CRITICAL(&eventStatsMux);
+    memset(&eventStats, 0, sizeof(eventStats));
+    eventTraceNext = 0;
+    eventTraceCount = 0;
+    portEXIT_CRITICAL(&eventStatsMux);
+}
+
+const char* getInputEventName(InputEventType type) {
+    if (type >= INPUT_EVENT_TYPE_COUNT) return "UNKNOWN";
+    return INPUT_EVENT_NAMES[type];
+}
+
+void printInputEventReport(Print& out) {
+    InputEventStats stats;
+    InputEventTraceEntry trace[INPUT_EVENT_TRACE_LENGTH];
+    uint8_t traceCount;
+    uint8_t traceNext;
+
+    portENTER_CRITICAL(&eventStatsMux);
+    stats = eventStats;
+    memcpy(trace, eventTrace, sizeof(trace));
+    traceCount = eventTraceCount;
+    traceNext = eventTraceNext;
+    portEXIT_CRITICAL(&eventStatsMux);
+
+    out.println("Input events:");
+    out.printf("  Posted / dropped:          %lu / %lu\n", stats.posted, stats.dropped);
+    out.printf("  Handled / ignored:         %lu / %lu\n", stats.handled, stats.ignored);
+    out.printf("  Last %u dispatched (oldest first):\n", traceCount);
+
+    // Oldest entry sits at traceNext once the trace has wrapped
+    uint8_t first = (traceCount < INPUT_EVENT_TRACE_LENGTH) ? 0 : traceNext;
+    uint64_t previousUs = 0;
+    for (uint8_t i = 0; i < traceCount; i++) {
+        const InputEventTraceEntry& entry = trace[(first + i) % INPUT_EVENT_TRACE_LENGTH];
+        unsigned long deltaUs = (i == 0) ? 0 : (unsigned long)(entry.event.timestampUs - previousUs);
+        previousUs = entry.event.timestampUs;
+        out.printf("  %12llu us  +%-9lu %-18s %-3u %-22s %s\n", (unsigned long long)entry.event.timestampUs, deltaUs,
+                   getInputEventName(entry.event.type), entry.event.detail,
+                   getStateName((SystemState)entry.state), entry.handled ? "handled" : "-");
+    }
+}
@@ -4,6 +4,7 @@
 #include <WiFiUdp.h>
 #include <ArduinoOTA.h>
 #include "Config/Pins_Definitions.h"
+#include "Tasks/Task_Layout.h"
 
 //* ************************************************************************
 //* *********************** OTA UPDATER IMPLEMENTATION *********************
@@ -76,6 +77,7 @@ void setupOTA() {
       }
       // NOTE: if updating SPIFFS, ensure SPIFFS is mounted via SPIFFS.begin()
       //serial.println("Start updating " + type);
+      sendControlCommand(CONTROL_CMD_OTA_BEGIN); // Park the control task before flash writes start
       otaAllLedsOff(); // Clear all LEDs at start
       digitalWrite(STATUS_LED_RED, HIGH); // Start with red LED
       //serial.println("OTA Upload started - LED progress indication active");
@@ -119,6 +121,7 @@ void setupOTA() {
         delay(100);
       }
       //serial.println("OTA error indication completed");
+      sendControlCommand(CONTROL_CMD_OTA_ABORT); // Upload failed - let the control task resume
     });
 
   ArduinoOTA.begin();
@@ -0,0 +1,113 @@
+#include "Safety/Home_Drift.h"
+#include "StateMachine/StateManager.h"
+#include "StateMachine/STATES/States_Config.h"
+
+//* ************************************************************************
+//* **************************** HOME DRIFT ********************************
+//* ************************************************************************
+
+static long driftWindow[HOME_DRIFT_WINDOW];
+static uint8_t driftWindowNext = 0;
+static bool rehomeRequested = false;
+
+static HomeDriftStats driftStats;
+static portMUX_TYPE driftStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Mean and variance of the window - called with driftStatsMux held
+static void updateDriftWindowStats() {
+    uint8_t count = driftStats.windowCount;
+    if (count == 0) {
+        driftStats.windowMeanSteps = 0.0f;
+        driftStats.windowVarianceSteps = 0.0f;
+        return;
+    }
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < count; i++) sum += (float)driftWindow[i];
+    float mean = sum / count;
+    float squares = 0.0f;
+    for (uint8_t i = 0; i < count; i++) {
+        float delta = (float)driftWindow[i] - mean;
+        squares += delta * delta;
+    }
+    driftStats.windowMeanSteps = mean;
+    driftStats.windowVarianceSteps = squares / count;
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+void recordCutHomeDrift(long driftSteps, bool coarse) {
+    long absDrift = labs(driftSteps);
+    bool warnSample = !coarse && absDrift > HOME_DRIFT_WARN_STEPS;
+    bool rehome = absDrift > HOME_DRIFT_REHOME_STEPS;
+    bool warnMean = false;
+    float mean;
+
+    portENTER_CRITICAL(&driftStatsMux);
+    driftStats.samples++;
+    if (coarse) driftStats.coarseSamples++;
+    driftStats.lastDriftSteps = driftSteps;
+    driftStats.lastCoarse = coarse;
+    if (absDrift > driftStats.maxAbsDriftSteps) driftStats.maxAbsDriftSteps = absDrift;
+    if (!coarse) {
+        driftWindow[driftWindowNext] = driftSteps;
+        driftWindowNext = (driftWindowNext + 1) % HOME_DRIFT_WINDOW;
+        if (driftStats.windowCount < HOME_DRIFT_WINDOW) driftStats.windowCount++;
+        updateDriftWindowStats();
+        warnMean = driftStats.windowCount >= HOME_DRIFT_MEAN_MIN_SAMPLES &&
+                   fabsf(driftStats.windowMeanSteps) > HOME_DRIFT_WARN_STEPS;
+    }
+    mean = driftStats.windowMeanSteps;
+    if (warnSample || warnMean) driftStats.warnings++;
+    if (rehome) driftStats.rehomeRequests++;
+    portEXIT_CRITICAL(&driftStatsMux);
+
+    if (rehome) {
+        rehomeRequested = true;
+        logMessage("WARNING: cut home found %ld steps (%.3f in) from zero%s - re-home requested",
+                   driftSteps, (float)driftSteps / CUT_MOTOR_STEPS_PER_INCH, coarse ? " (coarse)" : "");
+    } else if (warnSample) {
+        logMessage("WARNING: cut home drift %ld steps (%.3f in) on this return",
+                   driftSteps, (float)driftSteps / CUT_MOTOR_STEPS_PER_INCH);
+    } else if (warnMean) {
+        logMessage("WARNING: cut home drift averaging %.1f steps over the last returns", mean);
+    }
+}
+
+bool takeCutHomeRehomeRequest() {
+    if (!rehomeRequested) return false;
+    rehomeRequested = false;
+    return true;
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getHomeDriftStats(HomeDriftStats& stats) {
+    portENTER_CRITICAL(&driftStatsMux);
+    stats = driftStats;
+    portEXIT_CRITICAL(&driftStatsMux);
+}
+
+void resetHomeDriftStats() {
+    portENTER_CRITICAL(&driftStatsMux);
+    memset(&driftStats, 0, sizeof(driftStats));
+    driftWindowNext = 0;
+    portEXIT_CRITICAL(&driftStatsMux);
+}
+
+void printHomeDriftReport(Print& out) {
+    HomeDriftStats stats;
+    getHomeDriftStats(stats);
+
+    out.println("Cut home drift (position where the switch trips on each return, expected 0):");
+    out.printf("  Samples / coarse:          %lu / %lu\n", stats.samples, stats.coarseSamples);
+    out.printf("  Last / max |drift|:        %ld%s / %ld steps\n", stats.lastDriftSteps,
+               stats.lastCoarse ? " (coarse)" : "", stats.maxAbsDriftSteps);
+    out.printf("  Window mean / variance:    %.2f steps / %.2f steps^2 (%u returns)\n",
+               stats.windowMeanSteps, stats.windowVarianceSteps, stats.windowCount);
+    out.printf("  Warnings / re-homes:       %lu / %lu (warn %ld, re-home %ld steps)\n",
+               stats.warnings, stats.rehomeRequests, HOME_DRIFT_WARN_STEPS, HOME_DRIFT_REHOME_STEPS);
+}
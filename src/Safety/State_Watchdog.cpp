@@ -0,0 +1,153 @@
+#include "Safety/State_Watchdog.h"
+#include "StateMachine/StateManager.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* *************************** STATE WATCHDOG *****************************
+//* ************************************************************************
+
+// Control task owned
+static bool watchdogArmed = false;
+static SystemState watchedState = STARTUP;
+static uint64_t stateStartUs = 0;
+static unsigned long stateBudgetMs = STATE_WATCHDOG_UNBOUNDED;
+static bool overrunReported = false;     // One report per state visit
+
+static const char* stepName = nullptr;  // nullptr = no open step
+static int stepIndex = 0;
+static uint64_t stepStartUs = 0;
+static unsigned long stepBudgetMs = 0;
+
+// Read by the console on the comms task
+static StateWatchdogStats watchdogStats;
+static portMUX_TYPE watchdogStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint64_t elapsedMs(uint64_t startUs, uint64_t now) {
+    return (now - startUs) / 1000;
+}
+
+static bool stateOverBudget(uint64_t now) {
+    return stateBudgetMs != STATE_WATCHDOG_UNBOUNDED && elapsedMs(stateStartUs, now) > stateBudgetMs;
+}
+
+static bool stepOverBudget(uint64_t now) {
+    return stepName != nullptr && elapsedMs(stepStartUs, now) > stepBudgetMs;
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+void startStateWatchdog(SystemState state, unsigned long budgetMs) {
+    uint64_t now = nowUs();
+
+    if (watchdogArmed) {
+        unsigned long visitMs = (unsigned long)elapsedMs(stateStartUs, now);
+        portENTER_CRITICAL(&watchdogStatsMux);
+        if (visitMs > watchdogStats.longestVisitMs[watchedState]) {
+            watchdogStats.longestVisitMs[watchedState] = visitMs;
+        }
+        portEXIT_CRITICAL(&watchdogStatsMux);
+    }
+
+    watchdogArmed = true;
+    watchedState = state;
+    stateStartUs = now;
+    stateBudgetMs = budgetMs;
+    overrunReported = false;
+    stepName = nullptr;
+}
+
+void beginWatchdogStep(const char* name, int index, unsigned long budgetMs) {
+    stepName = name;
+    stepIndex = index;
+    stepStartUs = nowUs();
+    stepBudgetMs = budgetMs;
+}
+
+void endWatchdogStep() {
+    stepName = nullptr;
+}
+
+bool isStateWatchdogExpired() {
+    if (!watchdogArmed) return false;
+    uint64_t now = nowUs();
+    return stateOverBudget(now) || stepOverBudget(now);
+}
+
+bool checkStateWatchdog(SystemState state, unsigned long budgetMs, WatchdogOverrun& overrun) {
+    // The power-up state is entered without changeState()
+    if (!watchdogArmed || state != watchedState) startStateWatchdog(state, budgetMs);
+    if (overrunReported) return false;
+
+    uint64_t now = nowUs();
+    if (stepOverBudget(now)) {
+        overrun.stepName = stepName;
+        overrun.stepIndex = stepIndex;
+        overrun.elapsedMs = (unsigned long)elapsedMs(stepStartUs, now);
+        overrun.budgetMs = stepBudgetMs;
+    } else if (stateOverBudget(now)) {
+        overrun.stepName = nullptr;
+        overrun.stepIndex = 0;
+        overrun.elapsedMs = (unsigned long)elapsedMs(stateStartUs, now);
+        overrun.budgetMs = stateBudgetMs;
+    } else {
+        return false;
+    }
+    overrun.state = state;
+    overrun.timestampMs = now / 1000;
+    overrunReported = true;
+
+    portENTER_CRITICAL(&watchdogStatsMux);
+    watchdogStats.overruns++;
+    watchdogStats.overrunsByState[state]++;
+    watchdogStats.hasOverrun = true;
+    watchdogStats.lastOverrun = overrun;
+    portEXIT_CRITICAL(&watchdogStatsMux);
+    return true;
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getStateWatchdogStats(StateWatchdogStats& stats) {
+    portENTER_CRITICAL(&watchdogStatsMux);
+    stats = watchdogStats;
+    portEXIT_CRITICAL(&watchdogStatsMux);
+}
+
+void resetStateWatchdogStats() {
+    portENTER_CRITICAL(&watchdogStatsMux);
+    memset(&watchdogStats, 0, sizeof(watchdogStats));
+    portEXIT_CRITICAL(&watchdogStatsMux);
+}
+
+void printStateWatchdogReport(Print& out) {
+    StateWatchdogStats stats;
+    getStateWatchdogStats(stats);
+
+    out.println("State watchdog:");
+    out.printf("  Overruns:                  %lu\n", stats.overruns);
+    if (stats.hasOverrun) {
+        const WatchdogOverrun& last = stats.lastOverrun;
+        out.printf("  Last overrun:              %s", getStateName((SystemState)last.state));
+        if (last.stepName) {
+            out.printf(" / %s #%d", last.stepName, last.stepIndex);
+        }
+        out.printf(" - %lu ms of %lu ms budget, at %llu ms\n", last.elapsedMs, last.budgetMs,
+                   (unsigned long long)last.timestampMs);
+    }
+    out.println("  STATE                     BUDGET_MS  LONGEST_MS OVERRUNS");
+    for (int i = 0; i < SYSTEM_STATE_COUNT; i++) {
+        unsigned long budgetMs = getStateWatchdogBudget((SystemState)i);
+        char budget[24];
+        if (budgetMs == STATE_WATCHDOG_UNBOUNDED) {
+            snprintf(budget, sizeof(budget), "-");
+        } else {
+            snprintf(budget, sizeof(budget), "%lu", budgetMs);
+        }
+        out.printf("  %-25s %-10s %-10lu %lu\n", getStateName((SystemState)i), budget,
+                   stats.longestVisitMs[i], stats.overrunsByState[i]);
+    }
+}
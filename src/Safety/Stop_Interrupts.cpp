@@ -0,0 +1,263 @@
+#include "Safety/Stop_Interrupts.h"
+#include "Config/Pins_Definitions.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ************************** STOP INTERRUPTS *****************************
+//* ************************************************************************
+// At 25,000 steps/s one step is 40 us, so the glitch filter below costs well
+// under one step of overtravel while rejecting single-sample noise spikes.
+// The handlers are IRAM_ATTR, but digitalRead(), delayMicroseconds() and the
+// FastAccelStepper calls they make are not, so they are not safe to run while the
+// flash cache is disabled (OTA flash writes park the motors first).
+
+const int STOP_INPUT_GLITCH_FILTER_SAMPLES = 4;      // Consecutive active reads required
+const uint32_t STOP_INPUT_GLITCH_SAMPLE_SPACING_US = 2;
+
+static FastAccelStepper* isrCutMotor = NULL;
+static FastAccelStepper* isrFeedMotor = NULL;
+
+static volatile bool cutHomeStopArmed = false;
+static volatile bool cutHomeStopReady = false;
+static volatile bool cutHomeStopPolled = false;
+static volatile long cutHomeStopPosition = 0;
+static volatile bool homeLatchArmed[HOME_LATCH_COUNT] = {false, false};
+static volatile bool homeLatchReady[HOME_LATCH_COUNT] = {false, false};
+static volatile long homeLatchPosition[HOME_LATCH_COUNT] = {0, 0};
+static volatile bool hardStopEventPending = false;
+static volatile uint32_t hardStopCount = 0;         // Never reset - work on other tasks compares it
+
+static StopInterruptStats stopStats;
+static portMUX_TYPE stopStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Re-sample the pin a few times - a real switch edge stays put, EMI spikes from
+// the stepper drivers do not
+static bool IRAM_ATTR confirmStopInputLevel(int pin, int activeLevel) {
+    for (int i = 0; i < STOP_INPUT_GLITCH_FILTER_SAMPLES; i++) {
+        if (digitalRead(pin) != activeLevel) return false;
+        delayMicroseconds(STOP_INPUT_GLITCH_SAMPLE_SPACING_US);
+    }
+    return true;
+}
+
+static void IRAM_ATTR recordStopLatency(uint64_t entryUs) {
+    unsigned long latencyUs = (unsigned long)(nowUs() - entryUs);
+    stopStats.lastStopLatencyUs = latencyUs;
+    if (latencyUs > stopStats.maxStopLatencyUs) stopStats.maxStopLatencyUs = latencyUs;
+}
+
+//* ************************************************************************
+//* ************************** INTERRUPT HANDLERS **************************
+//* ************************************************************************
+
+// Position at ISR entry - the glitch filter after it costs well under a step
+static bool IRAM_ATTR latchHomePosition(HomeLatchInput input, FastAccelStepper* motor, int pin, int activeLevel) {
+    if (!homeLatchArmed[input] || !motor) return false;
+    long position = motor->getCurrentPosition();
+    if (!confirmStopInputLevel(pin, activeLevel)) {
+        portENTER_CRITICAL_ISR(&stopStatsMux);
+        stopStats.glitchesRejected++;
+        portEXIT_CRITICAL_ISR(&stopStatsMux);
+        return true;
+    }
+    portENTER_CRITICAL_ISR(&stopStatsMux);
+    homeLatchPosition[input] = position;
+    homeLatchReady[input] = true;
+    homeLatchArmed[input] = false;
+    stopStats.homeLatches[input]++;
+    portEXIT_CRITICAL_ISR(&stopStatsMux);
+    return true;
+}
+
+static void IRAM_ATTR cutHomeSwitchISR() {
+    uint64_t entryUs = nowUs();
+    // Homing latch takes the edge - the homing run is not a return stroke
+    if (latchHomePosition(HOME_LATCH_CUT, isrCutMotor, CUT_MOTOR_HOME_SWITCH, HIGH)) return;
+    if (!cutHomeStopArmed || !isrCutMotor) return;
+
+    if (!confirmStopInputLevel(CUT_MOTOR_HOME_SWITCH, HIGH)) {
+        portENTER_CRITICAL_ISR(&stopStatsMux);
+        stopStats.glitchesRejected++;
+        portEXIT_CRITICAL_ISR(&stopStatsMux);
+        return;
+    }
+    if (!isrCutMotor->isRunning()) return;
+
+    // Latch where the switch was actually hit, then stop and re-zero exactly as the polled path did
+    long latchedPosition = isrCutMotor->getCurrentPosition();
+    isrCutMotor->forceStopAndNewPosition(0);
+    cutHomeStopArmed = false;
+
+    portENTER_CRITICAL_ISR(&stopStatsMux);
+    stopStats.cutHomeStops++;
+    stopStats.lastCutHomePosition = latchedPosition;
+    cutHomeStopPosition = latchedPosition;
+    cutHomeStopPolled = false;
+    cutHomeStopReady = true;
+    recordStopLatency(entryUs);
+    portEXIT_CRITICAL_ISR(&stopStatsMux);
+}
+
+static void IRAM_ATTR feedHomeSensorISR() {
+    latchHomePosition(HOME_LATCH_FEED, isrFeedMotor, FEED_MOTOR_HOME_SENSOR, LOW);
+}
+
+// Stop both motors, drop every armed stop/latch and leave the event for the control task.
+// forceStopAndNewPosition() drops the queued steps too - forceStop() lets up to
+// ~20 ms of them run out, about 1 in at the return speed.
+static void IRAM_ATTR stopForHardStop() {
+    if (isrCutMotor) isrCutMotor->forceStopAndNewPosition(isrCutMotor->getCurrentPosition());
+    if (isrFeedMotor) isrFeedMotor->forceStopAndNewPosition(isrFeedMotor->getCurrentPosition());
+    cutHomeStopArmed = false;
+    homeLatchArmed[HOME_LATCH_CUT] = false;
+    homeLatchArmed[HOME_LATCH_FEED] = false;
+    hardStopEventPending = true;
+    hardStopCount = hardStopCount + 1;
+}
+
+static void IRAM_ATTR hardStopISR() {
+    uint64_t entryUs = nowUs();
+
+    if (!confirmStopInputLevel(HARD_STOP_INPUT, HIGH)) {
+        portENTER_CRITICAL_ISR(&stopStatsMux);
+        stopStats.glitchesRejected++;
+        portEXIT_CRITICAL_ISR(&stopStatsMux);
+        return;
+    }
+
+    stopForHardStop();
+
+    portENTER_CRITICAL_ISR(&stopStatsMux);
+    stopStats.hardStops++;
+    recordStopLatency(entryUs);
+    portEXIT_CRITICAL_ISR(&stopStatsMux);
+}
+
+//* ************************************************************************
+//* ************************** PUBLIC FUNCTIONS ****************************
+//* ************************************************************************
+
+void setupStopInterrupts(FastAccelStepper* cutMotor, FastAccelStepper* feedMotor) {
+    isrCutMotor = cutMotor;
+    isrFeedMotor = feedMotor;
+    resetStopInterruptStats();
+
+    pinMode(HARD_STOP_INPUT, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(CUT_MOTOR_HOME_SWITCH), cutHomeSwitchISR, RISING);
+    attachInterrupt(digitalPinToInterrupt(FEED_MOTOR_HOME_SENSOR), feedHomeSensorISR, FALLING);
+    attachInterrupt(digitalPinToInterrupt(HARD_STOP_INPUT), hardStopISR, RISING);
+
+    // Already open at boot (pressed or wire broken) - there is no edge to catch
+    if (isHardStopInputActive()) {
+        stopForHardStop();
+        portENTER_CRITICAL(&stopStatsMux);
+        stopStats.hardStops++;
+        portEXIT_CRITICAL(&stopStatsMux);
+    }
+}
+
+void armCutHomeStop() {
+    portENTER_CRITICAL(&stopStatsMux);
+    cutHomeStopReady = false;
+    portEXIT_CRITICAL(&stopStatsMux);
+    cutHomeStopArmed = true;
+}
+
+void disarmCutHomeStop() {
+    cutHomeStopArmed = false;
+}
+
+void armHomeLatch(HomeLatchInput input) {
+    if (input >= HOME_LATCH_COUNT) return;
+    portENTER_CRITICAL(&stopStatsMux);
+    homeLatchReady[input] = false;
+    homeLatchArmed[input] = true;
+    portEXIT_CRITICAL(&stopStatsMux);
+}
+
+void disarmHomeLatch(HomeLatchInput input) {
+    if (input >= HOME_LATCH_COUNT) return;
+    portENTER_CRITICAL(&stopStatsMux);
+    homeLatchArmed[input] = false;
+    homeLatchReady[input] = false;
+    portEXIT_CRITICAL(&stopStatsMux);
+}
+
+bool takeHomeLatch(HomeLatchInput input, long& position) {
+    if (input >= HOME_LATCH_COUNT) return false;
+    bool ready;
+    portENTER_CRITICAL(&stopStatsMux);
+    ready = homeLatchReady[input];
+    if (ready) {
+        position = homeLatchPosition[input];
+        homeLatchReady[input] = false;
+    }
+    portEXIT_CRITICAL(&stopStatsMux);
+    return ready;
+}
+
+void recordCutHomePollStop(long position) {
+    portENTER_CRITICAL(&stopStatsMux);
+    stopStats.cutHomePollStops++;
+    if (!cutHomeStopReady) {
+        cutHomeStopPosition = position;
+        cutHomeStopPolled = true;
+        cutHomeStopReady = true;
+    }
+    portEXIT_CRITICAL(&stopStatsMux);
+}
+
+bool takeCutHomeStop(long& position, bool& polled) {
+    bool ready;
+    portENTER_CRITICAL(&stopStatsMux);
+    ready = cutHomeStopReady;
+    if (ready) {
+        position = cutHomeStopPosition;
+        polled = cutHomeStopPolled;
+        cutHomeStopReady = false;
+    }
+    portEXIT_CRITICAL(&stopStatsMux);
+    return ready;
+}
+
+bool consumeHardStopEvent() {
+    if (!hardStopEventPending) return false;
+    hardStopEventPending = false;
+    return true;
+}
+
+uint32_t getHardStopCount() {
+    return hardStopCount;
+}
+
+bool isHardStopInputActive() {
+    return digitalRead(HARD_STOP_INPUT) == HIGH;
+}
+
+void getStopInterruptStats(StopInterruptStats& stats) {
+    portENTER_CRITICAL(&stopStatsMux);
+    stats = stopStats;
+    portEXIT_CRITICAL(&stopStatsMux);
+}
+
+void resetStopInterruptStats() {
+    portENTER_CRITICAL(&stopStatsMux);
+    memset(&stopStats, 0, sizeof(stopStats));
+    portEXIT_CRITICAL(&stopStatsMux);
+}
+
+void printStopInterruptReport(Print& out) {
+    StopInterruptStats stats;
+    getStopInterruptStats(stats);
+
+    out.println("Stop interrupts:");
+    out.printf("  Cut home stops (ISR):      %lu\n", stats.cutHomeStops);
+    out.printf("  Cut home stops (polled):   %lu\n", stats.cutHomePollStops);
+    out.printf("  Hard stops:                %lu\n", stats.hardStops);
+    out.printf("  Glitches rejected:         %lu\n", stats.glitchesRejected);
+    out.printf("  Last cut home position:    %ld steps\n", stats.lastCutHomePosition);
+    out.printf("  Home latches cut/feed:     %lu / %lu\n", stats.homeLatches[HOME_LATCH_CUT], stats.homeLatches[HOME_LATCH_FEED]);
+    out.printf("  ISR entry to stop last/max: %lu / %lu us (edge to ISR entry not measured)\n",
+               stats.lastStopLatencyUs, stats.maxStopLatencyUs);
+    out.printf("  Hard stop input:           %s\n", isHardStopInputActive() ? "ACTIVE" : "clear");
+}
@@ -0,0 +1,206 @@
+#include "StateMachine/FUNCTIONS/Cut_Stroke.h"
+#include "StateMachine/StateManager.h"
+#include "StateMachine/STATES/States_Config.h"
+#include "Tasks/Task_Layout.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* **************************** CUT STROKE ********************************
+//* ************************************************************************
+
+static const char* const CUT_ZONE_NAMES[CUT_ZONE_COUNT] = {
+    "approach",
+    "cut",
+    "exit"
+};
+
+static CutStrokePlan cutStrokePlan;
+static CutZone currentCutZone = CUT_ZONE_CUT;
+static uint64_t cutZoneStartUs[CUT_ZONE_COUNT];
+static uint64_t cutStrokeStartUs = 0;
+
+//* ************************************************************************
+//* ***************************** PLANNING *********************************
+//* ************************************************************************
+
+// Steps needed to slow from one speed to another at the cut acceleration
+static long cutDecelerationSteps(uint32_t fromSpeed, uint32_t toSpeed) {
+    if (fromSpeed <= toSpeed) return 0;
+    float from = fromSpeed;
+    float to = toSpeed;
+    return (long)((from * from - to * to) / (2.0f * CUT_MOTOR_NORMAL_ACCELERATION)) + 1;
+}
+
+void planCutStroke(const MaterialRecipe& recipe, CutStrokePlan& plan) {
+    plan.endSteps = CUT_TRAVEL_DISTANCE * CUT_MOTOR_STEPS_PER_INCH;
+    plan.approachSpeed = (uint32_t)CUT_MOTOR_APPROACH_SPEED;
+    plan.cutSpeed = (uint32_t)recipe.cutFeedSpeed;
+    plan.exitSpeed = (uint32_t)CUT_MOTOR_EXIT_SPEED;
+
+    plan.contactSteps = recipe.bladeContactInches * CUT_MOTOR_STEPS_PER_INCH;
+    plan.clearSteps = recipe.bladeClearInches * CUT_MOTOR_STEPS_PER_INCH;
+    if (plan.contactSteps < 0) plan.contactSteps = 0;
+    if (plan.clearSteps > plan.endSteps) plan.clearSteps = plan.endSteps;
+    if (plan.clearSteps < plan.contactSteps) {
+        // Inconsistent recipe - cut feed for the whole stroke
+        plan.contactSteps = 0;
+        plan.clearSteps = plan.endSteps;
+    }
+
+    long planningMarginSteps = (long)plan.approachSpeed * CUT_ZONE_PLANNING_MARGIN_MS / 1000;
+    plan.slowdownSteps = plan.contactSteps - cutDecelerationSteps(plan.approachSpeed, plan.cutSpeed)
+                         - planningMarginSteps;
+    plan.hasApproach = plan.approachSpeed > plan.cutSpeed && plan.slowdownSteps > 0;
+    if (!plan.hasApproach) plan.slowdownSteps = 0;
+
+    plan.hasExit = plan.exitSpeed > plan.cutSpeed && plan.clearSteps < plan.endSteps;
+    if (!plan.hasExit) plan.clearSteps = plan.endSteps;
+}
+
+//* ************************************************************************
+//* *************************** SPEED PROFILE ******************************
+//* ************************************************************************
+// The planned speed is the lowest of the zone speed and the ramps that bound it,
+// all at CUT_MOTOR_NORMAL_ACCELERATION. Lead positions walk back from the need
+// position one step at a time, adding each step's planned time.
+
+float getPlannedCutSpeedAt(const CutStrokePlan& plan, float positionSteps) {
+    const float accel = CUT_MOTOR_NORMAL_ACCELERATION;
+    float cut = plan.cutSpeed;
+    float zoneSpeed = cut;
+
+    if (plan.hasApproach && positionSteps < plan.slowdownSteps) {
+        zoneSpeed = plan.approachSpeed;
+    } else if (plan.hasExit && positionSteps >= plan.clearSteps) {
+        zoneSpeed = min((float)plan.exitSpeed, sqrtf(cut * cut + 2.0f * accel * (positionSteps - plan.clearSteps)));
+    } else if (plan.hasApproach) {
+        // The slow-down shows up one planning margin after the approach zone ends
+        float approach = plan.approachSpeed;
+        float rampStart = plan.slowdownSteps + approach * CUT_ZONE_PLANNING_MARGIN_MS / 1000.0f;
+        float rampSquared = approach * approach - 2.0f * accel * max(0.0f, positionSteps - rampStart);
+        zoneSpeed = max(cut, sqrtf(max(0.0f, rampSquared)));
+    }
+
+    float fromRest = sqrtf(2.0f * accel * max(0.0f, positionSteps));
+    float toEnd = sqrtf(2.0f * accel * max(0.0f, plan.endSteps - positionSteps));
+    return min(zoneSpeed, min(fromRest, toEnd));
+}
+
+// Time (us) for the step from positionSteps to positionSteps + 1. Near rest the
+// speed at the middle of a step badly understates its time (the last step into the
+// end of travel takes sqrt(2/a) ~ 10.8 ms, not the 7.7 ms at its midpoint speed), so
+// the ramps from rest and down to the end use the exact time, t = sqrt(2d/a).
+static float plannedStepTimeUs(const CutStrokePlan& plan, long positionSteps) {
+    const float accel = CUT_MOTOR_NORMAL_ACCELERATION;
+    float speed = getPlannedCutSpeedAt(plan, positionSteps + 0.5f);
+    float stepUs = 1000000.0f / max(speed, 1.0f);
+
+    float fromRest = max(0.0f, (float)positionSteps);
+    float rampUs = 1000000.0f * (sqrtf(2.0f * (fromRest + 1.0f) / accel) - sqrtf(2.0f * fromRest / accel));
+    if (rampUs > stepUs) stepUs = rampUs;
+    float toEnd = max(0.0f, (float)(plan.endSteps - positionSteps - 1));
+    rampUs = 1000000.0f * (sqrtf(2.0f * (toEnd + 1.0f) / accel) - sqrtf(2.0f * toEnd / accel));
+    if (rampUs > stepUs) stepUs = rampUs;
+    return stepUs;
+}
+
+long planActuatorLeadSteps(const CutStrokePlan& plan, long needSteps, unsigned long latencyMs) {
+    float leadUs = latencyMs * 1000.0f;
+    float elapsedUs = 0.0f;
+    long position = needSteps;
+
+    while (position > 0 && elapsedUs < leadUs) {
+        position--;
+        elapsedUs += plannedStepTimeUs(plan, position);
+    }
+    return position;
+}
+
+unsigned long planCutTimeToMs(const CutStrokePlan& plan, long positionSteps) {
+    float elapsedUs = 0.0f;
+    for (long position = 0; position < positionSteps; position++) {
+        elapsedUs += plannedStepTimeUs(plan, position);
+    }
+    return (unsigned long)(elapsedUs / 1000.0f);
+}
+
+//* ************************************************************************
+//* ***************************** STROKE ***********************************
+//* ************************************************************************
+
+static void enterCutZone(CutZone zone, uint32_t speed) {
+    FastAccelStepper* cutMotor = getCutMotor();
+    currentCutZone = zone;
+    cutZoneStartUs[zone] = nowUs();
+    if (cutMotor) {
+        cutMotor->setSpeedInHz(speed);
+        cutMotor->applySpeedAcceleration();     // Takes effect on the running move - no stop
+    }
+}
+
+void startCutStroke() {
+    FastAccelStepper* cutMotor = getCutMotor();
+    planCutStroke(getActiveRecipe(), cutStrokePlan);
+
+    cutStrokeStartUs = nowUs();
+    for (int i = 0; i < CUT_ZONE_COUNT; i++) cutZoneStartUs[i] = 0;
+
+    currentCutZone = cutStrokePlan.hasApproach ? CUT_ZONE_APPROACH : CUT_ZONE_CUT;
+    cutZoneStartUs[currentCutZone] = cutStrokeStartUs;
+    if (cutMotor) {
+        cutMotor->setSpeedInHz(cutStrokePlan.hasApproach ? cutStrokePlan.approachSpeed : cutStrokePlan.cutSpeed);
+        cutMotor->setAcceleration((uint32_t)CUT_MOTOR_NORMAL_ACCELERATION);
+        cutMotor->setLinearAcceleration(0);     // The plan assumes constant acceleration
+        cutMotor->moveTo(cutStrokePlan.endSteps);
+    }
+}
+
+void serviceCutStroke() {
+    FastAccelStepper* cutMotor = getCutMotor();
+    if (!cutMotor) return;
+    long position = cutMotor->getCurrentPosition();
+
+    if (currentCutZone == CUT_ZONE_APPROACH && position >= cutStrokePlan.slowdownSteps) {
+        enterCutZone(CUT_ZONE_CUT, cutStrokePlan.cutSpeed);
+    }
+    if (currentCutZone == CUT_ZONE_CUT && cutStrokePlan.hasExit && position >= cutStrokePlan.clearSteps) {
+        enterCutZone(CUT_ZONE_EXIT, cutStrokePlan.exitSpeed);
+    }
+}
+
+void finishCutStroke() {
+    uint64_t endUs = nowUs();
+    unsigned long zoneMs[CUT_ZONE_COUNT] = {0, 0, 0};
+
+    // Each zone runs until the next one that was entered, the last one until now
+    for (int i = 0; i < CUT_ZONE_COUNT; i++) {
+        if (cutZoneStartUs[i] == 0) continue;
+        uint64_t zoneEndUs = endUs;
+        for (int j = i + 1; j < CUT_ZONE_COUNT; j++) {
+            if (cutZoneStartUs[j] != 0) { zoneEndUs = cutZoneStartUs[j]; break; }
+        }
+        zoneMs[i] = (unsigned long)((zoneEndUs - cutZoneStartUs[i]) / 1000);
+    }
+
+    logMessage("Cut stroke %lu ms: approach %lu ms, cut %lu ms, exit %lu ms (%s)",
+               (unsigned long)((endUs - cutStrokeStartUs) / 1000),
+               zoneMs[CUT_ZONE_APPROACH], zoneMs[CUT_ZONE_CUT], zoneMs[CUT_ZONE_EXIT],
+               getActiveRecipe().name);
+}
+
+//* ************************************************************************
+//* ************************** ACCESS FUNCTIONS ****************************
+//* ************************************************************************
+
+CutZone getCutZone() {
+    return currentCutZone;
+}
+
+const CutStrokePlan& getCutStrokePlan() {
+    return cutStrokePlan;
+}
+
+const char* getCutZoneName(CutZone zone) {
+    if (zone >= CUT_ZONE_COUNT) return "UNKNOWN";
+    return CUT_ZONE_NAMES[zone];
+}
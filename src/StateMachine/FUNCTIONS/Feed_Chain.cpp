@@ -0,0 +1,250 @@
+#include "StateMachine/FUNCTIONS/Feed_Chain.h"
+#include <atomic>
+#include <esp_timer.h>
+#include "StateMachine/StateManager.h"
+#include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Safety/Stop_Interrupts.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ***************************** FEED CHAIN *******************************
+//* ************************************************************************
+
+static esp_timer_handle_t feedChainTimer = NULL;
+
+// Written by the control task before the chain starts, read-only while it runs
+static FeedChainEntry feedChainEntries[FEED_CHAIN_MAX_ENTRIES];
+static uint8_t feedChainCount = 0;
+static uint32_t feedChainHardStopCount = 0;
+
+// Timer task state while running
+static std::atomic<uint8_t> feedChainPhase(FEED_CHAIN_IDLE);
+static std::atomic<uint8_t> feedChainNext(0);
+static uint64_t feedChainWaitStartUs = 0;
+static uint64_t feedChainScheduledForUs = 0;
+static uint64_t feedChainLastSeenMovingUs = 0;
+
+static FeedChainStats feedChainStats;
+static portMUX_TYPE feedChainStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+//* ************************************************************************
+//* ************************** TIMER TASK **********************************
+//* ************************************************************************
+
+static bool feedMotorMoving(FastAccelStepper* feedMotor) {
+    return feedMotor && (feedMotor->isRunning() || feedMotor->isRampGeneratorActive());
+}
+
+// Next look at a moving feed: one short poll before it can cover what is left at
+// the current speed (the real stop, ramping down, comes later still), within the
+// poll limits - so the last look before the stop is at most a short poll early
+static uint64_t feedStopPollUs(FastAccelStepper* feedMotor) {
+    long remaining = labs(feedMotor->targetPos() - feedMotor->getCurrentPosition());
+    float speed = fabsf((float)feedMotor->getCurrentSpeedInMilliHz(true) / 1000.0f);
+    float untilUs = speed > 0.0f ? remaining * 1000000.0f / speed - FEED_CHAIN_MIN_POLL_US : 0.0f;
+    if (untilUs < FEED_CHAIN_MIN_POLL_US) return FEED_CHAIN_MIN_POLL_US;
+    if (untilUs > FEED_CHAIN_MAX_POLL_US) return FEED_CHAIN_MAX_POLL_US;
+    return (uint64_t)untilUs;
+}
+
+static void finishFeedChain(FeedChainStatus status) {
+    portENTER_CRITICAL(&feedChainStatsMux);
+    if (status == FEED_CHAIN_DONE) feedChainStats.completed++; else feedChainStats.aborted++;
+    portEXIT_CRITICAL(&feedChainStatsMux);
+    feedChainPhase.store(status, std::memory_order_release);
+}
+
+static void onFeedChainTimer(void* arg) {
+    // Claim it - loses to cancelFeedChain()
+    uint8_t expected = FEED_CHAIN_RUNNING;
+    if (!feedChainPhase.compare_exchange_strong(expected, FEED_CHAIN_EXECUTING, std::memory_order_acq_rel)) return;
+
+    uint64_t now = nowUs();
+    unsigned long latencyUs = now > feedChainScheduledForUs ? (unsigned long)(now - feedChainScheduledForUs) : 0;
+    portENTER_CRITICAL(&feedChainStatsMux);
+    if (latencyUs > feedChainStats.maxCallbackLatencyUs) feedChainStats.maxCallbackLatencyUs = latencyUs;
+    portEXIT_CRITICAL(&feedChainStatsMux);
+
+    // The hard stop ISR has already stopped the motor - issue nothing more
+    if (getHardStopCount() != feedChainHardStopCount) {
+        finishFeedChain(FEED_CHAIN_ABORTED);
+        return;
+    }
+
+    FastAccelStepper* feedMotor = getFeedMotor();
+    uint8_t next = feedChainNext.load(std::memory_order_relaxed);
+    uint64_t delayUs = 0;
+
+    while (next < feedChainCount && delayUs == 0) {
+        const FeedChainEntry& entry = feedChainEntries[next];
+        // The hard stop ISR can fire mid-callback - look again before anything moves
+        if ((entry.op == FEED_CHAIN_MOVE_TO || entry.op == FEED_CHAIN_ACTION) &&
+            getHardStopCount() != feedChainHardStopCount) {
+            finishFeedChain(FEED_CHAIN_ABORTED);
+            return;
+        }
+        switch (entry.op) {
+            case FEED_CHAIN_WAIT_IDLE:
+                if (feedMotorMoving(feedMotor)) {
+                    feedChainLastSeenMovingUs = nowUs();
+                    delayUs = feedStopPollUs(feedMotor);
+                    continue;
+                }
+                if (feedChainLastSeenMovingUs != 0) {
+                    unsigned long detectUs = (unsigned long)(nowUs() - feedChainLastSeenMovingUs);
+                    portENTER_CRITICAL(&feedChainStatsMux);
+                    feedChainStats.stopsSeen++;
+                    feedChainStats.lastStopDetectUs = detectUs;
+                    if (detectUs > feedChainStats.maxStopDetectUs) feedChainStats.maxStopDetectUs = detectUs;
+                    portEXIT_CRITICAL(&feedChainStatsMux);
+                    feedChainLastSeenMovingUs = 0;
+                }
+                break;
+            case FEED_CHAIN_WAIT_US:
+                if (feedChainWaitStartUs == 0) feedChainWaitStartUs = nowUs();
+                if (nowUs() - feedChainWaitStartUs < (uint64_t)entry.value) {
+                    delayUs = (uint64_t)entry.value - (nowUs() - feedChainWaitStartUs);
+                    continue;
+                }
+                feedChainWaitStartUs = 0;
+                break;
+            case FEED_CHAIN_ACTION:
+                if (entry.action) entry.action();
+                break;
+            case FEED_CHAIN_SPEED:
+                configureFeedMotorForSlowOperation(entry.value / 1000.0f);
+                break;
+            case FEED_CHAIN_MOVE_TO:
+                if (feedMotor) feedMotor->moveTo(entry.value);
+                portENTER_CRITICAL(&feedChainStatsMux);
+                feedChainStats.movesIssued++;
+                portEXIT_CRITICAL(&feedChainStatsMux);
+                break;
+        }
+        next++;
+        feedChainNext.store(next, std::memory_order_release);
+    }
+
+    if (next >= feedChainCount) {
+        finishFeedChain(FEED_CHAIN_DONE);
+        return;
+    }
+
+    feedChainScheduledForUs = nowUs() + delayUs;
+    feedChainPhase.store(FEED_CHAIN_RUNNING, std::memory_order_release);
+    if (esp_timer_start_once(feedChainTimer, delayUs) != ESP_OK) {
+        // Claim it back for the abort - a cancel may have got there first
+        expected = FEED_CHAIN_RUNNING;
+        if (feedChainPhase.compare_exchange_strong(expected, FEED_CHAIN_EXECUTING, std::memory_order_acq_rel)) {
+            finishFeedChain(FEED_CHAIN_ABORTED);
+        }
+    }
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+void setupFeedChain() {
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = onFeedChainTimer;
+    timerArgs.arg = NULL;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "feed_chain";
+    esp_timer_create(&timerArgs, &feedChainTimer);
+}
+
+bool startFeedChain(const FeedChainEntry* entries, uint8_t count) {
+    if (!feedChainTimer || count == 0 || count > FEED_CHAIN_MAX_ENTRIES) return false;
+    if (feedChainPhase.load(std::memory_order_acquire) != FEED_CHAIN_IDLE) return false;
+
+    memcpy(feedChainEntries, entries, count * sizeof(FeedChainEntry));
+    feedChainCount = count;
+    feedChainHardStopCount = getHardStopCount();
+    feedChainWaitStartUs = 0;
+    feedChainLastSeenMovingUs = 0;
+    feedChainNext.store(0, std::memory_order_relaxed);
+
+    feedChainScheduledForUs = nowUs();
+    feedChainPhase.store(FEED_CHAIN_RUNNING, std::memory_order_release);
+    if (esp_timer_start_once(feedChainTimer, 1) != ESP_OK) {
+        feedChainPhase.store(FEED_CHAIN_IDLE, std::memory_order_release);
+        return false;
+    }
+
+    portENTER_CRITICAL(&feedChainStatsMux);
+    feedChainStats.started++;
+    portEXIT_CRITICAL(&feedChainStatsMux);
+    return true;
+}
+
+void cancelFeedChain() {
+    if (!feedChainTimer) return;
+    esp_timer_stop(feedChainTimer);
+
+    for (;;) {
+        uint8_t phase = feedChainPhase.load(std::memory_order_acquire);
+        if (phase == FEED_CHAIN_EXECUTING) {
+            vTaskDelay(1);      // Callback mid-run on the timer task - a few microseconds of work
+            continue;
+        }
+        if (phase == FEED_CHAIN_RUNNING) {
+            esp_timer_stop(feedChainTimer);
+            if (!feedChainPhase.compare_exchange_strong(phase, FEED_CHAIN_IDLE, std::memory_order_acq_rel)) continue;
+            portENTER_CRITICAL(&feedChainStatsMux);
+            feedChainStats.cancelled++;
+            portEXIT_CRITICAL(&feedChainStatsMux);
+            return;
+        }
+        feedChainPhase.store(FEED_CHAIN_IDLE, std::memory_order_release);
+        return;
+    }
+}
+
+void releaseFeedChain() {
+    uint8_t phase = feedChainPhase.load(std::memory_order_acquire);
+    if (phase == FEED_CHAIN_DONE || phase == FEED_CHAIN_ABORTED) {
+        feedChainPhase.store(FEED_CHAIN_IDLE, std::memory_order_release);
+    }
+}
+
+FeedChainStatus getFeedChainStatus() {
+    uint8_t phase = feedChainPhase.load(std::memory_order_acquire);
+    return phase == FEED_CHAIN_EXECUTING ? FEED_CHAIN_RUNNING : (FeedChainStatus)phase;
+}
+
+uint8_t getFeedChainStep() {
+    uint8_t next = feedChainNext.load(std::memory_order_acquire);
+    if (next >= feedChainCount) return next ? feedChainEntries[feedChainCount - 1].sourceStep : 0;
+    return feedChainEntries[next].sourceStep;
+}
+
+bool isFeedChainWaitingForIdle() {
+    uint8_t next = feedChainNext.load(std::memory_order_acquire);
+    return next < feedChainCount && feedChainEntries[next].op == FEED_CHAIN_WAIT_IDLE;
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void resetFeedChainStats() {
+    portENTER_CRITICAL(&feedChainStatsMux);
+    memset(&feedChainStats, 0, sizeof(feedChainStats));
+    portEXIT_CRITICAL(&feedChainStatsMux);
+}
+
+void printFeedChainReport(Print& out) {
+    FeedChainStats stats;
+    portENTER_CRITICAL(&feedChainStatsMux);
+    stats = feedChainStats;
+    portEXIT_CRITICAL(&feedChainStatsMux);
+
+    out.println("Feed chains (motion table feed runs on the timer task):");
+    out.printf("  Started / completed:       %lu / %lu\n", stats.started, stats.completed);
+    out.printf("  Aborted / cancelled:       %lu / %lu\n", stats.aborted, stats.cancelled);
+    out.printf("  Moves issued:              %lu\n", stats.movesIssued);
+    out.printf("  Feed stops seen:           %lu\n", stats.stopsSeen);
+    out.printf("  Stop detect (last/max):    %lu / %lu us\n", stats.lastStopDetectUs, stats.maxStopDetectUs);
+    out.printf("  Callback latency (max):    %lu us\n", stats.maxCallbackLatencyUs);
+}
@@ -6,6 +6,11 @@
 #include "StateMachine/FUNCTIONS/General_Functions.h"
 #include "StateMachine/STATES/States_Config.h"
 #include "StateMachine/StateManager.h"
+#include "Tasks/Task_Layout.h"
+#include "Timing/Timer_Wheel.h"
+#include "Events/Input_Events.h"
+#include "Timing/Timebase.h"
+#include "Config/Material_Recipes.h"
 
 // External motor object references from main.cpp
 extern FastAccelStepper* cutMotor;
@@ -17,30 +22,26 @@ extern Bounce cutHomingSwitch;
 //* ************************************************************************
 // Contains functions related to signaling other stages or components.
 
+static WheelTimer taSignalTimer;
+
+// Timer callback - end of the TA pulse
+static void onTASignalTimeout() {
+  digitalWrite(TRANSFER_ARM_SIGNAL_PIN, LOW); // Return to inactive state (LOW)
+  signalTAActive = false;
+  postInputEvent(EVENT_TIMER_EXPIRED, EVENT_TIMER_TA_SIGNAL);
+  //serial.println("Signal to Transfer Arm (TA) completed"); 
+}
+
 void sendSignalToTA() {
   // Set the signal pin HIGH to trigger Transfer Arm (active HIGH)
   digitalWrite(TRANSFER_ARM_SIGNAL_PIN, HIGH);
-  signalTAStartTime = millis();
+  signalTAStartTime = nowUs();
   signalTAActive = true;
+  scheduleTimer(taSignalTimer, TA_SIGNAL_DURATION, onTASignalTimeout);
   //serial.println("TA Signal activated (HIGH).");
 
   // Only activate servo if it hasn't been activated early
-  if (!rotationServoIsActiveAndTiming) {
-    Servo* servo = getRotationServo();
-    if (servo) {
-      // Force servo write with robust control - no attach checks, just send the command
-      servo->write(ROTATION_SERVO_ACTIVE_POSITION);
-      //Serial.printf("FORCED Servo command sent: %d degrees (attach status ignored)\n", ROTATION_SERVO_ACTIVE_POSITION);
-    }
-    
-    rotationServoActiveStartTime = millis();
-    rotationServoIsActiveAndTiming = true;
-    //Serial.print("Rotation servo moved to ");
-    //Serial.print(ROTATION_SERVO_ACTIVE_POSITION);
-    //Serial.println(" degrees with TA signal.");
-  } else {
-    //Serial.println("Rotation servo already activated early - skipping normal activation.");
-  }
+  activateRotationServo();
 }
 
 //* ************************************************************************
@@ -74,11 +75,21 @@ void retract2x4SecureClamp() {
     //serial.println("2x4 Secure Clamp Retracted");
 }
 
+static WheelTimer rotationClampRetractTimer;
+
+// Timer callback - automatic retract after ROTATION_CLAMP_EXTEND_DURATION_MS
+static void onRotationClampTimeout() {
+    retractRotationClamp();
+    postInputEvent(EVENT_TIMER_EXPIRED, EVENT_TIMER_ROTATION_CLAMP);
+}
+
 void extendRotationClamp() {
     // Rotation clamp extends when HIGH
     digitalWrite(ROTATION_CLAMP, HIGH); // Extended 
-    rotationClampExtendTime = millis();
+    rotationClampExtendTime = nowUs();
     rotationClampIsExtended = true;
+    // Retract automatically after ROTATION_CLAMP_EXTEND_DURATION_MS
+    scheduleTimer(rotationClampRetractTimer, ROTATION_CLAMP_EXTEND_DURATION_MS, onRotationClampTimeout);
     //serial.println("Rotation Clamp Extended");
 }
 
@@ -86,6 +97,7 @@ void retractRotationClamp() {
     // Rotation clamp retracts when LOW
     digitalWrite(ROTATION_CLAMP, LOW); // Retracted 
     rotationClampIsExtended = false; // Assuming we want to clear the flag when explicitly retracting
+    cancelTimer(rotationClampRetractTimer);
     //serial.println("Rotation Clamp Retracted");
 }
 
@@ -186,11 +198,11 @@ void allLedsOff() {
 }
 
 void handleHomingLedBlink() {
-    static unsigned long blinkTimer = 0;
-    if (millis() - blinkTimer > 500) {
+    static uint64_t blinkTimer = 0;
+    if (msSince(blinkTimer) > 500) {
         blinkState = !blinkState;
         if (blinkState) turnBlueLedOn(); else turnBlueLedOff();
-        blinkTimer = millis();
+        blinkTimer = nowUs();
     }
 }
 
@@ -198,39 +210,59 @@ void handleHomingLedBlink() {
 //* *********************** MOTOR CONTROL FUNCTIONS ************************
 //* ************************************************************************
 
+// Acceleration and ramp shape for one move. S-curve runs the higher peak with a
+// jerk-limited start and stop; trapezoid clears any ramp left from an S-curve move.
+static void applyMotionProfile(FastAccelStepper* motor, MotionProfile profile,
+                               float trapezoidAcceleration, float sCurveAcceleration,
+                               uint32_t linearAccelerationSteps) {
+    if (profile == MOTION_PROFILE_S_CURVE) {
+        motor->setAcceleration((int32_t)sCurveAcceleration);
+        motor->setLinearAcceleration(linearAccelerationSteps);
+    } else {
+        motor->setAcceleration((int32_t)trapezoidAcceleration);
+        motor->setLinearAcceleration(0);
+    }
+}
+
 void configureCutMotorForCutting() {
     if (cutMotor) {
         cutMotor->setSpeedInHz((uint32_t)CUT_MOTOR_NORMAL_SPEED);
-        cutMotor->setAcceleration((uint32_t)CUT_MOTOR_NORMAL_ACCELERATION);
+        // Always trapezoid - the cut stroke plan assumes constant acceleration
+        applyMotionProfile(cutMotor, MOTION_PROFILE_TRAPEZOID, CUT_MOTOR_NORMAL_ACCELERATION,
+                           CUT_MOTOR_NORMAL_ACCELERATION, 0);
     }
 }
 
-void configureCutMotorForReturn() {
+void configureCutMotorForReturn(MotionProfile profile) {
     if (cutMotor) {
         cutMotor->setSpeedInHz((uint32_t)CUT_MOTOR_RETURN_SPEED);
-        cutMotor->setAcceleration((uint32_t)CUT_MOTOR_NORMAL_ACCELERATION);
+        applyMotionProfile(cutMotor, profile, CUT_MOTOR_NORMAL_ACCELERATION,
+                           CUT_MOTOR_RETURN_S_CURVE_ACCELERATION, CUT_MOTOR_LINEAR_ACCELERATION_STEPS);
     }
 }
 
-void configureFeedMotorForNormalOperation() {
+void configureFeedMotorForNormalOperation(MotionProfile profile) {
     if (feedMotor) {
         feedMotor->setSpeedInHz((uint32_t)FEED_MOTOR_NORMAL_SPEED);
-        feedMotor->setAcceleration((uint32_t)FEED_MOTOR_NORMAL_ACCELERATION);
+        applyMotionProfile(feedMotor, profile, FEED_MOTOR_NORMAL_ACCELERATION,
+                           FEED_MOTOR_S_CURVE_ACCELERATION, FEED_MOTOR_LINEAR_ACCELERATION_STEPS);
     }
 }
 
-void configureFeedMotorForReturn() {
+void configureFeedMotorForReturn(MotionProfile profile) {
     if (feedMotor) {
         feedMotor->setSpeedInHz((uint32_t)FEED_MOTOR_RETURN_SPEED);
-        feedMotor->setAcceleration((uint32_t)FEED_MOTOR_RETURN_ACCELERATION);
+        applyMotionProfile(feedMotor, profile, FEED_MOTOR_RETURN_ACCELERATION,
+                           FEED_MOTOR_RETURN_S_CURVE_ACCELERATION, FEED_MOTOR_LINEAR_ACCELERATION_STEPS);
     }
 }
 
-void configureFeedMotorForSlowOperation(float speedMultiplier) {
+void configureFeedMotorForSlowOperation(float speedMultiplier, MotionProfile profile) {
     if (feedMotor) {
         // Apply speed multiplier to normal speed and acceleration
         feedMotor->setSpeedInHz((uint32_t)(FEED_MOTOR_NORMAL_SPEED * speedMultiplier));
-        feedMotor->setAcceleration((uint32_t)(FEED_MOTOR_NORMAL_ACCELERATION * speedMultiplier));
+        applyMotionProfile(feedMotor, profile, FEED_MOTOR_NORMAL_ACCELERATION * speedMultiplier,
+                           FEED_MOTOR_S_CURVE_ACCELERATION * speedMultiplier, FEED_MOTOR_LINEAR_ACCELERATION_STEPS);
     }
 }
 
@@ -250,7 +282,7 @@ void moveCutMotorToHome() {
 
 void moveFeedMotorToTravel() {
     if (feedMotor) {
-        feedMotor->moveTo(FEED_TRAVEL_DISTANCE * FEED_MOTOR_STEPS_PER_INCH);
+        feedMotor->moveTo(getActiveRecipe().feedTravelDistanceInches * FEED_MOTOR_STEPS_PER_INCH);
     }
 }
 
@@ -278,162 +310,6 @@ void stopFeedMotor() {
     }
 }
 
-// Basic blocking homing function for Cut Motor - can be expanded
-void homeCutMotorBlocking(Bounce& homingSwitch, unsigned long timeout) {
-    if (!cutMotor) {
-        //serial.println("ERROR: cutMotor is NULL in homeCutMotorBlocking!");
-        return;
-    }
-    
-    //serial.println("Starting cut motor homing sequence...");
-    Serial.print("Initial switch state: ");
-    //serial.println(homingSwitch.read() == HIGH ? "HIGH" : "LOW");
-    
-    unsigned long startTime = millis();
-    cutMotor->setSpeedInHz((uint32_t)CUT_MOTOR_HOMING_SPEED);
-    cutMotor->moveTo(-40000);
-    
-    Serial.print("Cut motor homing speed set to: ");
-    //serial.println(CUT_MOTOR_HOMING_SPEED);
-    //serial.println("Cut motor moving to -40000 steps...");
-
-    while (homingSwitch.read() != HIGH) {
-        homingSwitch.update();
-        
-        // Add periodic status updates
-        static unsigned long lastStatusTime = 0;
-        if (millis() - lastStatusTime >= 500) {
-            Serial.print("Homing in progress... Switch: ");
-            Serial.print(homingSwitch.read() == HIGH ? "HIGH" : "LOW");
-            Serial.print(", Position: ");
-            Serial.print(cutMotor->getCurrentPosition());
-            Serial.print(", Running: ");
-            //serial.println(cutMotor->isRunning() ? "YES" : "NO");
-            lastStatusTime = millis();
-        }
-        
-        if (millis() - startTime > timeout) {
-            //serial.println("Cut motor homing timeout!");
-            cutMotor->forceStopAndNewPosition(cutMotor->getCurrentPosition());
-            return;
-        }
-    }
-    
-    //serial.println("HOME SWITCH DETECTED! Stopping motor immediately...");
-    // Use forceStopAndNewPosition for immediate stopping and set position to 0
-    cutMotor->forceStopAndNewPosition(0);
-    
-    // Add a small delay to ensure motor has fully stopped
-    delay(50);
-    
-    // Verify the switch is still pressed after stopping
-    homingSwitch.update();
-    if (homingSwitch.read() == HIGH) {
-        //serial.println("Cut motor homed successfully - switch confirmed HIGH after stop.");
-    } else {
-        //serial.println("WARNING: Switch not HIGH after homing - possible contact issue.");
-    }
-}
-
-// Basic blocking homing function for Feed Motor - can be expanded
-void homeFeedMotorBlocking(Bounce& homingSwitch) {
-    if (!feedMotor) {
-        //serial.println("ERROR: feedMotor is NULL in homeFeedMotorBlocking!");
-        return;
-    }
-    
-    //serial.println("Starting feed motor homing sequence...");
-    Serial.print("Initial feed sensor state: ");
-    //serial.println(homingSwitch.read() == LOW ? "ACTIVE" : "INACTIVE");
-    
-    // Debug motor setup
-    Serial.print("FEED_MOTOR_STEPS_PER_INCH value: ");
-    //serial.println(FEED_MOTOR_STEPS_PER_INCH);
-    Serial.print("FEED_MOTOR_HOMING_SPEED value: ");
-    //serial.println(FEED_MOTOR_HOMING_SPEED);
-    
-    // Step 1: Move toward home sensor until it triggers
-    feedMotor->setSpeedInHz((uint32_t)FEED_MOTOR_HOMING_SPEED);
-    
-    // Try using runForward() instead of moveTo() for more reliable operation
-    //serial.println("Starting feed motor forward run...");
-    feedMotor->runForward();
-    
-    // Verify motor started
-    delay(100); // Small delay to let motor start
-    Serial.print("Motor started - Running: ");
-    Serial.print(feedMotor->isRunning() ? "YES" : "NO");
-    Serial.print(", Position: ");
-    //serial.println(feedMotor->getCurrentPosition());
-
-    // Add timeout for feed motor homing
-    unsigned long startTime = millis();
-    const unsigned long FEED_HOME_TIMEOUT = 30000; // 30 seconds timeout
-
-    while (homingSwitch.read() != LOW) {
-        homingSwitch.update();
-        
-        // Add periodic status updates
-        static unsigned long lastStatusTime = 0;
-        if (millis() - lastStatusTime >= 1000) {
-            Serial.print("Feed homing in progress... Sensor: ");
-            Serial.print(homingSwitch.read() == LOW ? "ACTIVE" : "INACTIVE");
-            Serial.print(", Position: ");
-            Serial.print(feedMotor->getCurrentPosition());
-            Serial.print(", Running: ");
-            //serial.println(feedMotor->isRunning() ? "YES" : "NO");
-            lastStatusTime = millis();
-            
-            // If motor stopped running unexpectedly, restart it
-            if (!feedMotor->isRunning()) {
-                //serial.println("Motor stopped unexpectedly! Restarting...");
-                feedMotor->runForward();
-            }
-        }
-        
-        // Check for timeout
-        if (millis() - startTime > FEED_HOME_TIMEOUT) {
-            //serial.println("Feed motor homing timeout!");
-            feedMotor->forceStopAndNewPosition(feedMotor->getCurrentPosition());
-            return;
-        }
-    }
-    
-    //serial.println("FEED HOME SENSOR DETECTED! Stopping motor...");
-    feedMotor->forceStopAndNewPosition(FEED_TRAVEL_DISTANCE * FEED_MOTOR_STEPS_PER_INCH);
-    //serial.println("Feed motor hit home sensor.");
-    
-    // Step 2: Move to -0.3 inch from home sensor to establish working zero
-    //serial.println("Moving feed motor to -0.3 inch from home sensor...");
-    feedMotor->moveTo(FEED_TRAVEL_DISTANCE * FEED_MOTOR_STEPS_PER_INCH - FEED_MOTOR_OFFSET_FROM_SENSOR * FEED_MOTOR_STEPS_PER_INCH);
-    
-    // Wait for move to complete with timeout
-    unsigned long moveStartTime = millis();
-    while (feedMotor->isRunning()) {
-        if (millis() - moveStartTime > 10000) { // 10 second timeout for positioning
-            //serial.println("Feed motor positioning timeout!");
-            feedMotor->forceStopAndNewPosition(feedMotor->getCurrentPosition());
-            break;
-        }
-    }
-    
-    // Step 3: Set this position (-0.3 inch from sensor) as the new zero
-    feedMotor->setCurrentPosition(FEED_TRAVEL_DISTANCE * FEED_MOTOR_STEPS_PER_INCH);
-    //serial.println("Feed motor homed: 0.3 inch from sensor set as working zero.");
-    
-    configureFeedMotorForNormalOperation();
-    //serial.println("Feed motor homed successfully.");
-}
-
-void moveFeedMotorToInitialAfterHoming() {
-    if (feedMotor) {
-        configureFeedMotorForNormalOperation();
-        moveFeedMotorToHome();
-        while(feedMotor->isRunning()){
-        }
-    }
-}
-
 // Complex conditional logic
 // Checks the cut motor homing switch multiple times and recalibrates if detected.
 // Returns true if home detected and recalibrated, false otherwise.
@@ -443,7 +319,7 @@ bool checkAndRecalibrateCutMotorHome(int attempts) {
     bool sensorDetectedHome = false;
     for (int i = 0; i < attempts; i++) {
         cutHomingSwitch.update();
-        Serial.print("Cut position switch read attempt "); Serial.print(i + 1); Serial.print(": "); //serial.println(cutHomingSwitch.read());
+        logMessage("Cut position switch read attempt %d: %d", i + 1, cutHomingSwitch.read());
         if (cutHomingSwitch.read() == HIGH) {
             sensorDetectedHome = true;
             cutMotor->setCurrentPosition(0);
@@ -480,7 +356,7 @@ void handleReloadMode() {
 void handleErrorAcknowledgement() {
     // This handles the general error acknowledgement via reloadSwitch
     // It was present in the main loop and also within the CUTTING state's homePositionErrorDetected block.
-    if (reloadSwitch.rose() && (currentState == ERROR || currentState == CUTTING)) { // Check if in ERROR or if a cutting error is active
+    if (inputEventThisPass(EVENT_RELOAD_SWITCH_ON) && (currentState == ERROR || currentState == CUTTING)) { // Check if in ERROR or if a cutting error is active
         // For CUTTING state, the homePositionErrorDetected flag logic needs to remain there,
         // but the transition to ERROR_RESET can be centralized if errorAcknowledged is set.
         if (currentState == ERROR) {
@@ -500,7 +376,7 @@ void handleStartSwitchSafety() {
     // Original logic from setup() and main loop for startSwitchSafe
     // Call this once in setup() after startCycleSwitch.update()
     // And continuously in the main loop before checking shouldStartCycle()
-    if (!startSwitchSafe && startCycleSwitch.fell()) {
+    if (!startSwitchSafe && inputEventThisPass(EVENT_START_SWITCH_OFF)) {
         startSwitchSafe = true;
         //serial.println("Start switch is now safe to use (cycled OFF).");
     }
@@ -530,11 +406,62 @@ void handleStartSwitchContinuousMode(){
 
 bool shouldStartCycle() {
     // Condition from IDLE state to start a cycle
-    return ((startCycleSwitch.rose() || (continuousModeActive && !cuttingCycleInProgress))
+    return ((inputEventThisPass(EVENT_START_SWITCH_ON) || (continuousModeActive && !cuttingCycleInProgress))
             && !woodSuctionError && startSwitchSafe);
 }
 
 // Rotation Servo Timing
+// After the hold time the servo waits for the transfer arm suction sensor, then
+// returns home after ROTATION_SERVO_RETURN_DELAY_MS. If suction took longer than
+// ROTATION_SERVO_EXTENDED_WAIT_THRESHOLD_MS an extra safety delay comes first so the
+// operator can move their hand away. Each stage is one timer callback.
+
+static WheelTimer rotationServoTimer;
+
+static void onRotationServoReturnDelayExpired();
+
+// Shared by every stage: back off and poll again while the wood is not grabbed
+static bool rotationServoWaitingForSuction(TimerCallback stage) {
+    if (getSuctionSensorBounce()->read() == HIGH) return false;
+    //serial.println("Waiting for WAS_WOOD_SUCTIONED_SENSOR to read HIGH before returning rotation servo...");
+    scheduleTimer(rotationServoTimer, ROTATION_SERVO_SUCTION_POLL_MS, stage);
+    return true;
+}
+
+static void startRotationServoReturnDelay() {
+    setRotationServoReturnDelayStartTime(nowUs());
+    scheduleTimer(rotationServoTimer, ROTATION_SERVO_RETURN_DELAY_MS, onRotationServoReturnDelayExpired);
+    //serial.println("Starting 150ms return delay before returning servo to home.");
+}
+
+static void onRotationServoReturnDelayExpired() {
+    if (rotationServoWaitingForSuction(onRotationServoReturnDelayExpired)) return;
+    handleRotationServoReturn();
+    //serial.println("Return delay complete. Returning rotation servo to home position.");
+    rotationServoIsActiveAndTiming = false;
+    setRotationServoSafetyDelayActive(false);
+    postInputEvent(EVENT_TIMER_EXPIRED, EVENT_TIMER_ROTATION_SERVO);
+}
+
+static void onRotationServoSafetyDelayExpired() {
+    if (rotationServoWaitingForSuction(onRotationServoSafetyDelayExpired)) return;
+    startRotationServoReturnDelay();
+}
+
+static void onRotationServoHoldExpired() {
+    if (rotationServoWaitingForSuction(onRotationServoHoldExpired)) return;
+
+    if (msSince(rotationServoActiveStartTime) >= ROTATION_SERVO_EXTENDED_WAIT_THRESHOLD_MS) {
+        // We've been waiting for extended time due to failure to suction - apply safety delay
+        setRotationServoSafetyDelayActive(true);
+        setRotationServoSafetyDelayStartTime(nowUs());
+        scheduleTimer(rotationServoTimer, ROTATION_SERVO_SAFETY_DELAY_MS, onRotationServoSafetyDelayExpired);
+        //serial.println("Servo was waiting for extended time due to failure to suction. Starting safety delay before returning to home.");
+    } else {
+        startRotationServoReturnDelay();
+    }
+}
+
 void activateRotationServo() {
     // Activate rotation servo without sending TA signal
     if (!rotationServoIsActiveAndTiming) {
@@ -545,10 +472,11 @@ void activateRotationServo() {
             //Serial.printf("FORCED Servo command sent: %d degrees (attach status ignored)\n", ROTATION_SERVO_ACTIVE_POSITION);
         }
         
-        rotationServoActiveStartTime = millis();
+        rotationServoActiveStartTime = nowUs();
         rotationServoIsActiveAndTiming = true;
         // Reset safety delay flag for new activation cycle
         setRotationServoSafetyDelayActive(false);
+        scheduleTimer(rotationServoTimer, ROTATION_SERVO_ACTIVE_HOLD_DURATION_MS, onRotationServoHoldExpired);
         //Serial.print("Rotation servo activated to ");
         //Serial.print(ROTATION_SERVO_ACTIVE_POSITION);
         //Serial.println(" degrees.");
@@ -571,36 +499,10 @@ void handleRotationServoReturn() {
     //Serial.println(" degrees).");
 }
 
-void handleTASignalTiming() { 
-  if (signalTAActive && millis() - signalTAStartTime >= TA_SIGNAL_DURATION) {
-    digitalWrite(TRANSFER_ARM_SIGNAL_PIN, LOW); // Return to inactive state (LOW)
-    signalTAActive = false;
-    //serial.println("Signal to Transfer Arm (TA) completed"); 
-  }
-}
-
-void handleRotationClampRetract() {
-    if (rotationClampIsExtended && (millis() - rotationClampExtendTime >= ROTATION_CLAMP_EXTEND_DURATION_MS)) {
-        retractRotationClamp();
-        //serial.println("Rotation Clamp retracted after 1 second.");
-    }
-}
-
 void moveFeedMotorToPostCutHome() {
     if (feedMotor) {
         feedMotor->moveTo(0);
         //serial.println("Feed motor moving to post-cut home position (0 inches)");
     }
 }
-
-//* ************************************************************************
-//* ************************* FLAG MANAGEMENT FUNCTIONS ********************
-//* ************************************************************************
-
-bool getComingFromNoWoodWithSensorsClear() {
-    return comingFromNoWoodWithSensorsClear;
-}
-
-void setComingFromNoWoodWithSensorsClear(bool value) {
-    comingFromNoWoodWithSensorsClear = value;
-} 
\ No newline at end of file
+ 
\ No newline at end of file
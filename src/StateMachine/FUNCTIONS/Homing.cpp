@@ -0,0 +1,459 @@
+#include "StateMachine/FUNCTIONS/Homing.h"
+#include "StateMachine/STATES/States_Config.h"
+#include "StateMachine/StateManager.h"
+#include "Events/Input_Events.h"
+#include "Safety/Stop_Interrupts.h"
+#include "Tasks/Control_Executive.h"
+#include "Timing/Deadline.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ******************************* HOMING *********************************
+//* ************************************************************************
+
+const unsigned long HOMING_PARK_TIMEOUT_MS = 10000;     // Feed move to the working zero
+const unsigned long HOMING_POLL_DETECT_US = 5000;       // Longest home input debounce (main.cpp) - polled find
+
+struct HomingAxisConfig {
+    FastAccelStepper* motor;
+    Bounce* input;
+    int activeLevel;            // Home input level when made
+    int direction;              // Toward the home input
+    HomeLatchInput latchInput;  // Edge interrupt that latches the position (HOMING_ISR_LATCH)
+    float approachSpeed;        // ISR latch: capped so the stop fits in the overtravel
+    float acceleration;         // The axis's normal acceleration - the stop after the latch uses it
+    float latchSpeed;
+    long backoffSteps;
+    long overtravelSteps;       // ISR latch: stopping distance allowed past the input
+    long homeSteps;             // Position set where the input is made
+    long parkSteps;             // Where the axis ends (feed: working zero off the sensor)
+    bool rezeroAtPark;          // Feed: set back to homeSteps once parked
+};
+
+struct HomingAxisRun {
+    HomingPhase phase;
+    bool waitForCutHome;
+    unsigned long timeoutMs;
+    uint64_t startUs;           // startHomingAxis()
+    uint64_t releasedUs;        // Left the interlock - approach starts
+    uint64_t foundUs;           // Home input first made
+    long latchedSteps;          // ISR latch position, in the axis's frame before the zero is set
+    bool rebased;               // Found by polling, not the edge latch - zero comes from the slow latch
+    uint32_t savedAcceleration; // Restored once the overtravel stop is done
+    Deadline timeout;
+};
+
+static HomingAxisRun homingRuns[HOMING_AXIS_COUNT];
+static bool axisReferenced[HOMING_AXIS_COUNT] = {false, false};    // Homed at least once since boot
+
+static HomingStats homingStats;
+static portMUX_TYPE homingStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Built on each call - the constants live in another translation unit
+static HomingAxisConfig getHomingAxisConfig(HomingAxis axis) {
+    HomingAxisConfig config;
+    if (axis == HOMING_AXIS_CUT) {
+        config.motor = getCutMotor();
+        config.input = getCutHomingSwitch();
+        config.activeLevel = HIGH;
+        config.direction = CUT_HOMING_DIRECTION;
+        config.latchInput = HOME_LATCH_CUT;
+        config.approachSpeed = CUT_MOTOR_HOMING_SPEED;
+        config.acceleration = CUT_MOTOR_NORMAL_ACCELERATION;
+        config.latchSpeed = CUT_MOTOR_HOMING_LATCH_SPEED;
+        config.backoffSteps = (long)(CUT_MOTOR_HOMING_BACKOFF_INCHES * CUT_MOTOR_STEPS_PER_INCH);
+        config.overtravelSteps = (long)(CUT_MOTOR_HOMING_OVERTRAVEL_INCHES * CUT_MOTOR_STEPS_PER_INCH);
+        config.homeSteps = 0;
+        config.parkSteps = 0;
+        config.rezeroAtPark = false;
+    } else {
+        config.motor = getFeedMotor();
+        config.input = getFeedHomingSwitch();
+        config.activeLevel = LOW;
+        config.direction = FEED_HOMING_DIRECTION;
+        config.latchInput = HOME_LATCH_FEED;
+        config.approachSpeed = FEED_MOTOR_HOMING_SPEED;
+        config.acceleration = FEED_MOTOR_NORMAL_ACCELERATION;
+        config.latchSpeed = FEED_MOTOR_HOMING_LATCH_SPEED;
+        config.backoffSteps = (long)(FEED_MOTOR_HOMING_BACKOFF_INCHES * FEED_MOTOR_STEPS_PER_INCH);
+        config.overtravelSteps = (long)(FEED_MOTOR_HOMING_OVERTRAVEL_INCHES * FEED_MOTOR_STEPS_PER_INCH);
+        config.homeSteps = (long)(FEED_TRAVEL_DISTANCE * FEED_MOTOR_STEPS_PER_INCH);
+        config.parkSteps = config.homeSteps - (long)(FEED_MOTOR_OFFSET_FROM_SENSOR * FEED_MOTOR_STEPS_PER_INCH);
+        config.rezeroAtPark = true;
+    }
+    // Fastest approach that still stops inside the overtravel at the normal
+    // acceleration once the input is seen: v*detect + v^2/(2a) = overtravel.
+    // Seen within a control pass with the edge latch, after the debounce without it.
+    float detectSeconds = (CONTROL_TICK_PERIOD_US + (HOMING_ISR_LATCH ? 0 : HOMING_POLL_DETECT_US)) / 1000000.0f;
+    float a = config.acceleration;
+    float maxSpeed = a * (sqrtf(detectSeconds * detectSeconds + 2.0f * config.overtravelSteps / a) - detectSeconds);
+    if (config.approachSpeed > maxSpeed) config.approachSpeed = maxSpeed;
+    return config;
+}
+
+const char* getHomingAxisName(HomingAxis axis) {
+    switch (axis) {
+        case HOMING_AXIS_CUT:  return "cut";
+        case HOMING_AXIS_FEED: return "feed";
+        default:               return "?";
+    }
+}
+
+const char* getHomingPhaseName(HomingPhase phase) {
+    switch (phase) {
+        case HOMING_PHASE_IDLE:     return "idle";
+        case HOMING_PHASE_HELD:     return "held";
+        case HOMING_PHASE_APPROACH: return "approach";
+        case HOMING_PHASE_BACKOFF:  return "back-off";
+        case HOMING_PHASE_LATCH:    return "latch";
+        case HOMING_PHASE_OVERTRAVEL: return "overtravel";
+        case HOMING_PHASE_PARK:     return "park";
+        case HOMING_PHASE_DONE:     return "done";
+        case HOMING_PHASE_FAILED:   return "failed";
+        default:                    return "?";
+    }
+}
+
+//* ************************************************************************
+//* ************************** PHASE MACHINE *******************************
+//* ************************************************************************
+
+static bool homingMotorMoving(FastAccelStepper* motor) {
+    return motor->isRunning() || motor->isRampGeneratorActive();
+}
+
+static bool isHomingPhaseActive(HomingPhase phase) {
+    return phase != HOMING_PHASE_IDLE && phase != HOMING_PHASE_DONE && phase != HOMING_PHASE_FAILED;
+}
+
+static void recordHomingRun(HomingAxis axis, const HomingAxisRun& run, bool success) {
+    uint64_t now = nowUs();
+    unsigned long heldMs = (unsigned long)((run.releasedUs ? run.releasedUs : now) - run.startUs) / 1000;
+    unsigned long approachMs = run.releasedUs ? (unsigned long)((run.foundUs ? run.foundUs : now) - run.releasedUs) / 1000 : 0;
+    unsigned long latchMs = run.foundUs ? (unsigned long)(now - run.foundUs) / 1000 : 0;
+    unsigned long totalMs = approachMs + latchMs;
+
+    portENTER_CRITICAL(&homingStatsMux);
+    HomingAxisStats& stats = homingStats.axes[axis];
+    stats.runs++;
+    if (!success) stats.failures++;
+    stats.lastHeldMs = heldMs;
+    stats.lastApproachMs = approachMs;
+    stats.lastLatchMs = latchMs;
+    stats.lastTotalMs = totalMs;
+    if (success && totalMs > stats.maxTotalMs) stats.maxTotalMs = totalMs;
+    portEXIT_CRITICAL(&homingStatsMux);
+
+    if (success) {
+        logMessage("%s axis homed in %lu ms (approach %lu ms, found to zero set %lu ms, held %lu ms)",
+                   getHomingAxisName(axis), totalMs, approachMs, latchMs, heldMs);
+    }
+}
+
+// Where the input tripped against the zero the axis held when the run started.
+// Only meaningful once the axis has been homed before and the run did not reset
+// the position on the way (fallback path).
+static void recordHomingLatch(HomingAxis axis, const HomingAxisRun& run, const HomingAxisConfig& config, long overtravelSteps) {
+    // Where the last homing left the input: the feed's park re-zero shifts it by the park offset
+    long expectedSteps = config.homeSteps + (config.rezeroAtPark ? config.homeSteps - config.parkSteps : 0);
+    long offsetSteps = run.latchedSteps - expectedSteps;
+    bool measured = axisReferenced[axis] && !run.rebased;
+
+    portENTER_CRITICAL(&homingStatsMux);
+    HomingAxisStats& stats = homingStats.axes[axis];
+    stats.lastOvertravelSteps = overtravelSteps;
+    if (overtravelSteps > stats.maxOvertravelSteps) stats.maxOvertravelSteps = overtravelSteps;
+    if (measured) {
+        if (stats.latchSamples == 0 || offsetSteps < stats.minLatchOffsetSteps) stats.minLatchOffsetSteps = offsetSteps;
+        if (stats.latchSamples == 0 || offsetSteps > stats.maxLatchOffsetSteps) stats.maxLatchOffsetSteps = offsetSteps;
+        stats.lastLatchOffsetSteps = offsetSteps;
+        stats.latchSamples++;
+    }
+    portEXIT_CRITICAL(&homingStatsMux);
+
+    if (measured) {
+        logMessage("%s axis home latched %ld steps from the previous zero, %ld steps overtravel",
+                   getHomingAxisName(axis), offsetSteps, overtravelSteps);
+    }
+}
+
+// Ends the run and posts its result - except for an abort, which the caller asked for
+static void finishHomingAxis(HomingAxis axis, bool success, const char* reason, bool postResult = true) {
+    HomingAxisRun& run = homingRuns[axis];
+    if (!success) {
+        logMessage("%s axis homing failed in %s: %s", getHomingAxisName(axis), getHomingPhaseName(run.phase), reason);
+    }
+    clearDeadline(run.timeout);
+    HomingAxisConfig config = getHomingAxisConfig(axis);
+    disarmHomeLatch(config.latchInput);
+    if (run.savedAcceleration && config.motor) {
+        config.motor->setAcceleration(run.savedAcceleration);
+        run.savedAcceleration = 0;
+    }
+    if (success) axisReferenced[axis] = true;
+    recordHomingRun(axis, run, success);
+    run.phase = success ? HOMING_PHASE_DONE : HOMING_PHASE_FAILED;
+    if (postResult) postInputEvent(success ? EVENT_HOMING_DONE : EVENT_HOMING_FAILED, axis);
+}
+
+static void failHomingAxis(HomingAxis axis, FastAccelStepper* motor, const char* reason, bool postResult = true) {
+    if (motor && homingMotorMoving(motor)) motor->forceStopAndNewPosition(motor->getCurrentPosition());
+    finishHomingAxis(axis, false, reason, postResult);
+}
+
+// Cut axis has found its home switch - the blade stays within the back-off of home
+static bool isCutHomeConfirmed() {
+    HomingPhase cutPhase = homingRuns[HOMING_AXIS_CUT].phase;
+    return cutPhase == HOMING_PHASE_BACKOFF || cutPhase == HOMING_PHASE_LATCH ||
+           cutPhase == HOMING_PHASE_OVERTRAVEL || cutPhase == HOMING_PHASE_PARK || cutPhase == HOMING_PHASE_DONE;
+}
+
+static void beginHomingApproach(HomingAxisRun& run, const HomingAxisConfig& config) {
+    run.releasedUs = nowUs();
+    startDeadline(run.timeout, run.timeoutMs);
+    config.motor->setLinearAcceleration(0);     // Plain ramp - stop short once the input is found
+    config.motor->setSpeedInHz((uint32_t)config.approachSpeed);
+    run.savedAcceleration = config.motor->getAcceleration();
+    config.motor->setAcceleration((uint32_t)config.acceleration);
+    if (HOMING_ISR_LATCH) armHomeLatch(config.latchInput);
+    if (config.direction > 0) config.motor->runForward(); else config.motor->runBackward();
+    run.phase = HOMING_PHASE_APPROACH;
+}
+
+// Zero set - end here, or move to where the axis parks
+static void beginHomingPark(HomingAxis axis, HomingAxisRun& run, const HomingAxisConfig& config) {
+    if (config.motor->getCurrentPosition() == config.parkSteps && !config.rezeroAtPark) {
+        finishHomingAxis(axis, true, NULL);
+        return;
+    }
+    config.motor->setSpeedInHz((uint32_t)config.approachSpeed);
+    config.motor->moveTo(config.parkSteps);
+    startDeadline(run.timeout, HOMING_PARK_TIMEOUT_MS);
+    run.phase = HOMING_PHASE_PARK;
+}
+
+static void serviceHomingAxis(HomingAxis axis) {
+    HomingAxisRun& run = homingRuns[axis];
+    if (!isHomingPhaseActive(run.phase)) return;
+
+    HomingAxisConfig config = getHomingAxisConfig(axis);
+    if (!config.motor || !config.input) {
+        finishHomingAxis(axis, false, "motor or home input missing");
+        return;
+    }
+    bool inputMade = config.input->read() == config.activeLevel;
+
+    if (run.phase != HOMING_PHASE_HELD && run.phase != HOMING_PHASE_PARK && isDeadlineExpired(run.timeout)) {
+        failHomingAxis(axis, config.motor, "timeout");
+        return;
+    }
+
+    switch (run.phase) {
+        case HOMING_PHASE_HELD: {
+            HomingPhase cutPhase = homingRuns[HOMING_AXIS_CUT].phase;
+            if (cutPhase == HOMING_PHASE_FAILED || cutPhase == HOMING_PHASE_IDLE) {
+                finishHomingAxis(axis, false, "cut axis did not find home");
+            } else if (isCutHomeConfirmed()) {
+                beginHomingApproach(run, config);
+            }
+            break;
+        }
+
+        case HOMING_PHASE_APPROACH:
+            if (HOMING_ISR_LATCH && takeHomeLatch(config.latchInput, run.latchedSteps)) {
+                // Position is held - let the axis ramp down past the input
+                run.foundUs = nowUs();
+                config.motor->stopMove();
+                run.phase = HOMING_PHASE_OVERTRAVEL;
+            } else if (inputMade) {
+                // Found by polling (no edge latch, or already on the input at the start).
+                // Ramp down as well - no dead stop at approach speed - then set the zero
+                // with a back-off and slow latch.
+                disarmHomeLatch(config.latchInput);
+                run.latchedSteps = config.motor->getCurrentPosition();
+                run.rebased = true;
+                run.foundUs = nowUs();
+                config.motor->stopMove();
+                run.phase = HOMING_PHASE_OVERTRAVEL;
+            } else if (!homingMotorMoving(config.motor)) {
+                failHomingAxis(axis, config.motor, "motor stopped before the home input was made");
+            }
+            break;
+
+        case HOMING_PHASE_BACKOFF:
+            if (homingMotorMoving(config.motor)) break;
+            if (inputMade) {
+                failHomingAxis(axis, config.motor, "home input still made after the back-off");
+                break;
+            }
+            config.motor->setSpeedInHz((uint32_t)config.latchSpeed);
+            if (HOMING_ISR_LATCH) armHomeLatch(config.latchInput);
+            config.motor->moveTo(config.homeSteps + config.direction * config.backoffSteps);
+            run.phase = HOMING_PHASE_LATCH;
+            break;
+
+        case HOMING_PHASE_LATCH:
+            if (HOMING_ISR_LATCH && takeHomeLatch(config.latchInput, run.latchedSteps)) {
+                // Slow enough to stop dead - the steps since the edge stay counted
+                config.motor->forceStopAndNewPosition(config.homeSteps + config.motor->getCurrentPosition() - run.latchedSteps);
+                recordHomingLatch(axis, run, config, labs(config.motor->getCurrentPosition() - config.homeSteps));
+                beginHomingPark(axis, run, config);
+            } else if (inputMade) {
+                config.motor->forceStopAndNewPosition(config.homeSteps);
+                beginHomingPark(axis, run, config);
+            } else if (!homingMotorMoving(config.motor)) {
+                failHomingAxis(axis, config.motor, "home input not made again on the latch");
+            }
+            break;
+
+        case HOMING_PHASE_OVERTRAVEL: {
+            if (homingMotorMoving(config.motor)) break;
+            // Zero from the latched position: the input is where the ISR saw it
+            // (polled: roughly, until the slow latch sets it)
+            long overtravelSteps = config.motor->getCurrentPosition() - run.latchedSteps;
+            config.motor->setCurrentPosition(config.homeSteps + overtravelSteps);
+            if (labs(overtravelSteps) > config.overtravelSteps) {
+                logMessage("WARNING: %s axis ran %ld steps past home (allowed %ld)", getHomingAxisName(axis),
+                           labs(overtravelSteps), config.overtravelSteps);
+            }
+            if (run.rebased) {
+                config.motor->moveTo(config.homeSteps - config.direction * config.backoffSteps);
+                run.phase = HOMING_PHASE_BACKOFF;
+                break;
+            }
+            if (run.savedAcceleration) config.motor->setAcceleration(run.savedAcceleration);
+            run.savedAcceleration = 0;
+            recordHomingLatch(axis, run, config, labs(overtravelSteps));
+            beginHomingPark(axis, run, config);
+            break;
+        }
+
+        case HOMING_PHASE_PARK:
+            if (homingMotorMoving(config.motor)) {
+                if (isDeadlineExpired(run.timeout)) failHomingAxis(axis, config.motor, "park move timeout");
+                break;
+            }
+            if (config.rezeroAtPark) {
+                // Working zero is FEED_MOTOR_OFFSET_FROM_SENSOR off the sensor
+                config.motor->setCurrentPosition(config.homeSteps);
+                configureFeedMotorForNormalOperation();
+            }
+            finishHomingAxis(axis, true, NULL);
+            break;
+
+        default:
+            break;
+    }
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+void startHomingAxis(HomingAxis axis, unsigned long timeoutMs, bool waitForCutHome) {
+    if (axis >= HOMING_AXIS_COUNT) return;
+    HomingAxisRun& run = homingRuns[axis];
+    run.waitForCutHome = waitForCutHome && axis != HOMING_AXIS_CUT;
+    run.timeoutMs = timeoutMs;
+    run.startUs = nowUs();
+    run.releasedUs = 0;
+    run.foundUs = 0;
+    run.latchedSteps = 0;
+    run.rebased = false;
+    run.savedAcceleration = 0;
+    clearDeadline(run.timeout);
+    run.phase = HOMING_PHASE_HELD;
+
+    HomingAxisConfig config = getHomingAxisConfig(axis);
+    if (!config.motor || !config.input) {
+        finishHomingAxis(axis, false, "motor or home input missing");
+        return;
+    }
+    logMessage("%s axis homing - home input %s%s", getHomingAxisName(axis),
+               config.input->read() == config.activeLevel ? "made" : "clear",
+               run.waitForCutHome ? ", held for the cut home interlock" : "");
+    if (!run.waitForCutHome) beginHomingApproach(run, config);
+}
+
+bool serviceHoming() {
+    bool anyActive = false;
+    for (int i = 0; i < HOMING_AXIS_COUNT; i++) {
+        serviceHomingAxis((HomingAxis)i);
+        if (isHomingPhaseActive(homingRuns[i].phase)) anyActive = true;
+    }
+    return anyActive;
+}
+
+HomingPhase getHomingPhase(HomingAxis axis) {
+    return axis < HOMING_AXIS_COUNT ? homingRuns[axis].phase : HOMING_PHASE_IDLE;
+}
+
+bool isHomingAxisDone(HomingAxis axis) {
+    return getHomingPhase(axis) == HOMING_PHASE_DONE;
+}
+
+void abortHoming() {
+    for (int i = 0; i < HOMING_AXIS_COUNT; i++) {
+        if (!isHomingPhaseActive(homingRuns[i].phase)) continue;
+        failHomingAxis((HomingAxis)i, getHomingAxisConfig((HomingAxis)i).motor, "aborted", false);
+    }
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void recordHomingSequence(unsigned long totalMs) {
+    portENTER_CRITICAL(&homingStatsMux);
+    homingStats.lastSequenceMs = totalMs;
+    if (totalMs > homingStats.maxSequenceMs) homingStats.maxSequenceMs = totalMs;
+    portEXIT_CRITICAL(&homingStatsMux);
+}
+
+void getHomingStats(HomingStats& stats) {
+    portENTER_CRITICAL(&homingStatsMux);
+    stats = homingStats;
+    portEXIT_CRITICAL(&homingStatsMux);
+}
+
+void resetHomingStats() {
+    portENTER_CRITICAL(&homingStatsMux);
+    memset(&homingStats, 0, sizeof(homingStats));
+    portEXIT_CRITICAL(&homingStatsMux);
+}
+
+void printHomingReport(Print& out) {
+    HomingStats stats;
+    getHomingStats(stats);
+
+    out.println(HOMING_ISR_LATCH ? "Homing (edge-latched zero, stop past the input; cut and feed in parallel):"
+                                 : "Homing (fast approach, back-off, slow latch; cut and feed in parallel):");
+    HomingAxisConfig cut = getHomingAxisConfig(HOMING_AXIS_CUT);
+    HomingAxisConfig feed = getHomingAxisConfig(HOMING_AXIS_FEED);
+    out.printf("  Cut speeds:                %.0f approach / %.0f latch steps/s, %.2f in back-off\n",
+               cut.approachSpeed, cut.latchSpeed, CUT_MOTOR_HOMING_BACKOFF_INCHES);
+    out.printf("  Feed speeds:               %.0f approach / %.0f latch steps/s, %.2f in back-off\n",
+               feed.approachSpeed, feed.latchSpeed, FEED_MOTOR_HOMING_BACKOFF_INCHES);
+    if (HOMING_ISR_LATCH) {
+        out.printf("  Stop past input (cut/feed): %.0f / %.0f steps/s^2 within %ld / %ld steps\n",
+                   cut.acceleration, feed.acceleration, cut.overtravelSteps, feed.overtravelSteps);
+    }
+    for (int i = 0; i < HOMING_AXIS_COUNT; i++) {
+        const HomingAxisStats& axis = stats.axes[i];
+        const char* name = getHomingAxisName((HomingAxis)i);
+        out.printf("  %-4s runs / failures:       %lu / %lu (now %s)\n", name, axis.runs, axis.failures,
+                   getHomingPhaseName(homingRuns[i].phase));
+        out.printf("  %-4s last held/approach/latch: %lu / %lu / %lu ms (total %lu, max %lu)\n", name,
+                   axis.lastHeldMs, axis.lastApproachMs, axis.lastLatchMs, axis.lastTotalMs, axis.maxTotalMs);
+        out.printf("  %-4s overtravel (last/max):  %ld / %ld steps\n", name,
+                   axis.lastOvertravelSteps, axis.maxOvertravelSteps);
+        if (axis.latchSamples > 0) {
+            out.printf("  %-4s latch vs zero:          last %ld, min %ld, max %ld, spread %ld steps (%lu)\n", name,
+                       axis.lastLatchOffsetSteps, axis.minLatchOffsetSteps, axis.maxLatchOffsetSteps,
+                       axis.maxLatchOffsetSteps - axis.minLatchOffsetSteps, axis.latchSamples);
+        } else {
+            out.printf("  %-4s latch vs zero:          no repeat homing yet\n", name);
+        }
+    }
+    out.printf("  Homing state (last/max):   %lu / %lu ms\n", stats.lastSequenceMs, stats.maxSequenceMs);
+}
@@ -0,0 +1,457 @@
+#include "StateMachine/FUNCTIONS/Motion_Table.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "StateMachine/StateManager.h"
+#include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Config/Pins_Definitions.h"
+#include "Tasks/Task_Layout.h"
+#include "Safety/State_Watchdog.h"
+#include "Config/Material_Recipes.h"
+#include "StateMachine/FUNCTIONS/Feed_Chain.h"
+#include "StateMachine/STATES/States_Config.h"
+
+//* ************************************************************************
+//* *************************** MOTION TABLES ******************************
+//* ************************************************************************
+
+const UBaseType_t MOTION_TABLE_QUEUE_LENGTH = 2;
+const int MOTION_MAX_STEPS_PER_PASS = 32;   // Per branch - bounds the work done in one control pass
+
+static const MotionTable* const BUILT_IN_MOTION_TABLES[MOTION_TABLE_COUNT] = {
+    &FEED_FIRST_CUT_MOTION_TABLE,
+    &FEED_WOOD_FWD_ONE_MOTION_TABLE,
+    &RETURNING_NO_2X4_MOTION_TABLE
+};
+
+static QueueHandle_t motionTableQueue = NULL;
+
+// Control task owned. A queued table lands in pending and is only promoted to
+// active by startMotionTable(), so a runner never sees its table change mid-run.
+static LoadedMotionTable pendingMotionTables[MOTION_TABLE_COUNT];
+static bool pendingMotionTableValid[MOTION_TABLE_COUNT];
+static LoadedMotionTable activeMotionTables[MOTION_TABLE_COUNT];
+static bool activeMotionTableLoaded[MOTION_TABLE_COUNT];
+
+//* ************************************************************************
+//* ************************** STEP EXECUTION ******************************
+//* ************************************************************************
+
+static FastAccelStepper* getMotionMotor(uint8_t motor) {
+    return motor == MOTION_MOTOR_CUT ? getCutMotor() : getFeedMotor();
+}
+
+static int readMotionSensor(uint8_t sensor) {
+    switch (sensor) {
+        case MOTION_SENSOR_2X4_PRESENT:  return digitalRead(_2x4_PRESENT_SENSOR);
+        case MOTION_SENSOR_WOOD_SUCTION: return digitalRead(WOOD_SUCTION_CONFIRM_SENSOR);
+        case MOTION_SENSOR_FEED_HOME:    return digitalRead(FEED_MOTOR_HOME_SENSOR);
+    }
+    return -1;
+}
+
+static void applyMotionClamp(uint8_t clamp, bool extend) {
+    if (clamp == MOTION_CLAMP_2X4_SECURE) {
+        if (extend) extend2x4SecureClamp(); else retract2x4SecureClamp();
+    } else {
+        if (extend) extendFeedClamp(); else retractFeedClamp();
+    }
+}
+
+static bool forkedBranchesActive(const MotionRunner& runner) {
+    for (uint8_t i = 1; i < MOTION_MAX_BRANCHES; i++) {
+        if (runner.branches[i].active) return true;
+    }
+    return false;
+}
+
+static void forkMotionBranch(MotionRunner& runner, uint8_t stepIndex) {
+    for (uint8_t i = 1; i < MOTION_MAX_BRANCHES; i++) {
+        MotionBranch& branch = runner.branches[i];
+        if (branch.active) continue;
+        branch.nextStep = stepIndex;
+        branch.active = true;
+        clearDeadline(branch.wait);
+        return;
+    }
+    // validateMotionTable() keeps loaded tables within the branch limit
+    logMessage("Motion table: no free branch for fork to step %u - skipped", stepIndex);
+}
+
+// A main-branch wait that is not met yet opens a watchdog step (once per wait)
+static void watchMotionWait(MotionRunner& runner, uint8_t branchIndex) {
+    uint8_t stepIndex = runner.branches[0].nextStep;
+    if (branchIndex != 0 || runner.watchedStep == stepIndex) return;
+    runner.watchedStep = stepIndex;
+    beginWatchdogStep(runner.name, stepIndex, MOTION_WAIT_WATCHDOG_MS);
+}
+
+static void releaseMotionWatch(MotionRunner& runner) {
+    if (runner.watchedStep == MOTION_NO_WATCHED_STEP) return;
+    runner.watchedStep = MOTION_NO_WATCHED_STEP;
+    endWatchdogStep();
+}
+
+//* ************************************************************************
+//* **************************** FEED CHAINS *******************************
+//* ************************************************************************
+
+static void (*motionClampAction(uint8_t clamp, bool extend))() {
+    if (clamp == MOTION_CLAMP_2X4_SECURE) return extend ? extend2x4SecureClamp : retract2x4SecureClamp;
+    return extend ? extendFeedClamp : retractFeedClamp;
+}
+
+// Compile the main branch from its current step (a feed motor-idle wait) up to the
+// first step a chain cannot run. Returns the entry count; endStep = first step left over.
+static uint8_t compileFeedChain(const MotionRunner& runner, FeedChainEntry* entries, uint8_t& endStep) {
+    uint8_t count = 0;
+    uint8_t index = runner.branches[0].nextStep;
+
+    for (; index < runner.stepCount && count < FEED_CHAIN_MAX_ENTRIES; index++) {
+        const MotionStep& step = runner.steps[index];
+        FeedChainEntry& entry = entries[count];
+        entry.sourceStep = index;
+        entry.action = NULL;
+        entry.value = 0;
+
+        if (step.op == MOTION_WAIT_MOTOR_IDLE && step.target == MOTION_MOTOR_FEED) {
+            entry.op = FEED_CHAIN_WAIT_IDLE;
+        } else if (step.op == MOTION_WAIT_MS) {
+            entry.op = FEED_CHAIN_WAIT_US;
+            entry.value = (int32_t)(step.value * 1000.0f);
+        } else if (step.op == MOTION_CLAMP) {
+            entry.op = FEED_CHAIN_ACTION;
+            entry.action = motionClampAction(step.target, step.value != 0.0f);
+        } else if (step.op == MOTION_FEED_SPEED) {
+            entry.op = FEED_CHAIN_SPEED;
+            entry.value = (int32_t)(step.value * 1000.0f);
+        } else if (step.op == MOTION_FEED_MOVE_TO) {
+            entry.op = FEED_CHAIN_MOVE_TO;
+            entry.value = (int32_t)(step.value * FEED_MOTOR_STEPS_PER_INCH);
+        } else if (step.op == MOTION_FEED_MOVE_TO_TRAVEL) {
+            // The recipe only changes in IDLE, so it is fixed for the whole chain
+            entry.op = FEED_CHAIN_MOVE_TO;
+            entry.value = (int32_t)(getActiveRecipe().feedTravelDistanceInches * FEED_MOTOR_STEPS_PER_INCH);
+        } else {
+            break;
+        }
+        count++;
+    }
+    endStep = index;
+    return count;
+}
+
+// Main branch at a feed wait with the feed moving: hand the run to the timer task
+static bool startMotionFeedChain(MotionRunner& runner) {
+    if (forkedBranchesActive(runner)) return false;     // A fork may drive the clamps too
+
+    static FeedChainEntry entries[FEED_CHAIN_MAX_ENTRIES];     // Control task only
+    uint8_t endStep = 0;
+    uint8_t count = compileFeedChain(runner, entries, endStep);
+    if (count < 2) return false;                        // Nothing follows the wait
+    if (!startFeedChain(entries, count)) return false;
+
+    runner.chainEndStep = endStep;
+    return true;
+}
+
+// Follow a running chain. True once it has ended and the branch can carry on.
+static bool followMotionFeedChain(MotionRunner& runner) {
+    MotionBranch& branch = runner.branches[0];
+    FeedChainStatus status = getFeedChainStatus();
+
+    if (status == FEED_CHAIN_RUNNING) {
+        uint8_t step = getFeedChainStep();
+        if (runner.watchedStep != MOTION_NO_WATCHED_STEP && runner.watchedStep != step) releaseMotionWatch(runner);
+        branch.nextStep = step;
+        if (isFeedChainWaitingForIdle()) watchMotionWait(runner, 0);
+        return false;
+    }
+
+    if (status == FEED_CHAIN_ABORTED) {
+        // Hard stop - the motors are stopped and ERROR takes over. Hold the branch
+        // where the chain stopped; stopMotionTable() releases it.
+        return false;
+    }
+
+    releaseFeedChain();
+    releaseMotionWatch(runner);
+    branch.nextStep = runner.chainEndStep;
+    runner.chainEndStep = MOTION_NO_CHAIN;
+    return true;
+}
+
+// Execute steps on one branch until it waits or ends
+static void runMotionBranch(MotionRunner& runner, uint8_t branchIndex) {
+    MotionBranch& branch = runner.branches[branchIndex];
+
+    if (branchIndex == 0 && runner.chainEndStep != MOTION_NO_CHAIN && !followMotionFeedChain(runner)) return;
+
+    for (int executed = 0; branch.active && executed < MOTION_MAX_STEPS_PER_PASS; executed++) {
+        if (branch.nextStep >= runner.stepCount) {
+            branch.active = false;      // Ran off the end - same as MOTION_END
+            return;
+        }
+        const MotionStep& step = runner.steps[branch.nextStep];
+
+        switch (step.op) {
+            case MOTION_END:
+                branch.active = false;
+                return;
+            case MOTION_FEED_MOVE_TO:
+                moveFeedMotorToPosition(step.value);
+                break;
+            case MOTION_FEED_MOVE_TO_TRAVEL:
+                moveFeedMotorToPosition(getActiveRecipe().feedTravelDistanceInches);
+                break;
+            case MOTION_FEED_SPEED:
+                configureFeedMotorForSlowOperation(step.value);
+                break;
+            case MOTION_CLAMP:
+                applyMotionClamp(step.target, step.value != 0.0f);
+                break;
+            case MOTION_WAIT_MS:
+                if (!waitForDeadline(branch.wait, (unsigned long)step.value)) return;
+                break;
+            case MOTION_WAIT_MOTOR_IDLE:
+                if (!motorIdle(getMotionMotor(step.target))) {
+                    if (branchIndex == 0 && step.target == MOTION_MOTOR_FEED && startMotionFeedChain(runner)) {
+                        followMotionFeedChain(runner);
+                        return;
+                    }
+                    watchMotionWait(runner, branchIndex);
+                    return;
+                }
+                break;
+            case MOTION_WAIT_SENSOR:
+                if (readMotionSensor(step.target) != (int)step.value) {
+                    watchMotionWait(runner, branchIndex);
+                    return;
+                }
+                break;
+            case MOTION_FORK:
+                forkMotionBranch(runner, (uint8_t)step.value);
+                break;
+            case MOTION_JOIN:
+                if (branchIndex == 0 && forkedBranchesActive(runner)) {
+                    watchMotionWait(runner, branchIndex);
+                    return;
+                }
+                break;
+        }
+        if (branchIndex == 0 && runner.watchedStep == branch.nextStep) releaseMotionWatch(runner);
+        branch.nextStep++;
+    }
+}
+
+//* ************************************************************************
+//* ************************** INTERPRETER *********************************
+//* ************************************************************************
+
+void startMotionTable(MotionRunner& runner, MotionTableId id) {
+    if (pendingMotionTableValid[id]) {
+        activeMotionTables[id] = pendingMotionTables[id];
+        activeMotionTableLoaded[id] = pendingMotionTables[id].stepCount > 0;
+        pendingMotionTableValid[id] = false;
+        logMessage("Motion table %s: using %s table", BUILT_IN_MOTION_TABLES[id]->name,
+                   activeMotionTableLoaded[id] ? "loaded" : "built-in");
+    }
+
+    runner.name = BUILT_IN_MOTION_TABLES[id]->name;
+    runner.watchedStep = MOTION_NO_WATCHED_STEP;
+    runner.chainEndStep = MOTION_NO_CHAIN;
+    if (activeMotionTableLoaded[id]) {
+        runner.steps = activeMotionTables[id].steps;
+        runner.stepCount = activeMotionTables[id].stepCount;
+    } else {
+        runner.steps = BUILT_IN_MOTION_TABLES[id]->steps;
+        runner.stepCount = BUILT_IN_MOTION_TABLES[id]->stepCount;
+    }
+
+    for (uint8_t i = 0; i < MOTION_MAX_BRANCHES; i++) {
+        runner.branches[i].nextStep = 0;
+        runner.branches[i].active = (i == 0);
+        clearDeadline(runner.branches[i].wait);
+    }
+}
+
+SequenceStatus runMotionTable(MotionRunner& runner) {
+    if (!runner.steps) return SEQUENCE_DONE;
+
+    // Main branch first so a fork issued this pass also gets its first steps this pass
+    for (uint8_t i = 0; i < MOTION_MAX_BRANCHES; i++) {
+        if (runner.branches[i].active) runMotionBranch(runner, i);
+    }
+
+    if (runner.branches[0].active || forkedBranchesActive(runner)) return SEQUENCE_RUNNING;
+    releaseMotionWatch(runner);
+    return SEQUENCE_DONE;
+}
+
+void stopMotionTable(MotionRunner& runner) {
+    if (runner.chainEndStep != MOTION_NO_CHAIN) {
+        cancelFeedChain();
+        runner.chainEndStep = MOTION_NO_CHAIN;
+    }
+    releaseMotionWatch(runner);
+    for (uint8_t i = 0; i < MOTION_MAX_BRANCHES; i++) {
+        runner.branches[i].active = false;
+        clearDeadline(runner.branches[i].wait);
+    }
+}
+
+void serviceMotionTableLoads() {
+    if (!motionTableQueue) return;
+    static LoadedMotionTable received;     // Too big for a comfortable stack copy every pass
+    while (xQueueReceive(motionTableQueue, &received, 0) == pdTRUE) {
+        if (received.id >= MOTION_TABLE_COUNT) continue;
+        pendingMotionTables[received.id] = received;
+        pendingMotionTableValid[received.id] = true;
+    }
+}
+
+//* ************************************************************************
+//* ************************** LOADING (CONSOLE) ***************************
+//* ************************************************************************
+
+void setupMotionTables() {
+    motionTableQueue = xQueueCreate(MOTION_TABLE_QUEUE_LENGTH, sizeof(LoadedMotionTable));
+}
+
+const MotionTable& getBuiltInMotionTable(MotionTableId id) {
+    return *BUILT_IN_MOTION_TABLES[id];
+}
+
+bool findMotionTableId(const char* name, MotionTableId& id) {
+    for (int i = 0; i < MOTION_TABLE_COUNT; i++) {
+        if (strcmp(name, BUILT_IN_MOTION_TABLES[i]->name) == 0) {
+            id = (MotionTableId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse the number after a token prefix; the whole rest of the token must be numeric
+static bool parseMotionValue(const char* text, float& value) {
+    if (*text == '\0') return false;
+    char* end = NULL;
+    value = strtof(text, &end);
+    return end && *end == '\0';
+}
+
+static bool parseSensorLevel(const char* text, float& value) {
+    if (strcmp(text, "0") == 0) { value = 0.0f; return true; }
+    if (strcmp(text, "1") == 0) { value = 1.0f; return true; }
+    return false;
+}
+
+bool parseMotionStep(const char* token, MotionStep& step) {
+    step.target = 0;
+    step.value = 0.0f;
+
+    if (strcmp(token, "end") == 0)  { step.op = MOTION_END; return true; }
+    if (strcmp(token, "join") == 0) { step.op = MOTION_JOIN; return true; }
+    if (strcmp(token, "ft") == 0)   { step.op = MOTION_FEED_MOVE_TO_TRAVEL; return true; }
+    if (strcmp(token, "fc+") == 0 || strcmp(token, "fc-") == 0) {
+        step = motionClamp(MOTION_CLAMP_FEED, token[2] == '+');
+        return true;
+    }
+    if (strcmp(token, "sc+") == 0 || strcmp(token, "sc-") == 0) {
+        step = motionClamp(MOTION_CLAMP_2X4_SECURE, token[2] == '+');
+        return true;
+    }
+    if (strcmp(token, "wf") == 0) { step = motionWaitMotorIdle(MOTION_MOTOR_FEED); return true; }
+    if (strcmp(token, "wc") == 0) { step = motionWaitMotorIdle(MOTION_MOTOR_CUT); return true; }
+
+    if (strncmp(token, "fork", 4) == 0) {
+        step.op = MOTION_FORK;
+        return parseMotionValue(token + 4, step.value) && step.value >= 0.0f;
+    }
+    if (strncmp(token, "fm", 2) == 0) {
+        step.op = MOTION_FEED_MOVE_TO;
+        return parseMotionValue(token + 2, step.value);
+    }
+    if (strncmp(token, "fs", 2) == 0) {
+        step.op = MOTION_FEED_SPEED;
+        return parseMotionValue(token + 2, step.value) && step.value > 0.0f;
+    }
+    if (strncmp(token, "ms", 2) == 0) {
+        step.op = MOTION_WAIT_MS;
+        return parseMotionValue(token + 2, step.value) && step.value >= 0.0f;
+    }
+    if (strncmp(token, "w2x4=", 5) == 0) {
+        step.op = MOTION_WAIT_SENSOR;
+        step.target = MOTION_SENSOR_2X4_PRESENT;
+        return parseSensorLevel(token + 5, step.value);
+    }
+    if (strncmp(token, "wsuc=", 5) == 0) {
+        step.op = MOTION_WAIT_SENSOR;
+        step.target = MOTION_SENSOR_WOOD_SUCTION;
+        return parseSensorLevel(token + 5, step.value);
+    }
+    if (strncmp(token, "wfh=", 4) == 0) {
+        step.op = MOTION_WAIT_SENSOR;
+        step.target = MOTION_SENSOR_FEED_HOME;
+        return parseSensorLevel(token + 4, step.value);
+    }
+    return false;
+}
+
+void formatMotionStep(const MotionStep& step, char* buffer, size_t bufferSize) {
+    static const char* const SENSOR_TOKENS[] = {"w2x4=", "wsuc=", "wfh="};
+
+    switch (step.op) {
+        case MOTION_END:                 snprintf(buffer, bufferSize, "end"); return;
+        case MOTION_JOIN:                snprintf(buffer, bufferSize, "join"); return;
+        case MOTION_FEED_MOVE_TO_TRAVEL: snprintf(buffer, bufferSize, "ft"); return;
+        case MOTION_FEED_MOVE_TO:        snprintf(buffer, bufferSize, "fm%g", step.value); return;
+        case MOTION_FEED_SPEED:          snprintf(buffer, bufferSize, "fs%g", step.value); return;
+        case MOTION_WAIT_MS:             snprintf(buffer, bufferSize, "ms%lu", (unsigned long)step.value); return;
+        case MOTION_FORK:                snprintf(buffer, bufferSize, "fork%u", (unsigned)step.value); return;
+        case MOTION_CLAMP:
+            snprintf(buffer, bufferSize, "%s%c", step.target == MOTION_CLAMP_2X4_SECURE ? "sc" : "fc",
+                     step.value != 0.0f ? '+' : '-');
+            return;
+        case MOTION_WAIT_MOTOR_IDLE:
+            snprintf(buffer, bufferSize, "%s", step.target == MOTION_MOTOR_CUT ? "wc" : "wf");
+            return;
+        case MOTION_WAIT_SENSOR:
+            snprintf(buffer, bufferSize, "%s%d", step.target <= MOTION_SENSOR_FEED_HOME ? SENSOR_TOKENS[step.target] : "w?=",
+                     (int)step.value);
+            return;
+    }
+    snprintf(buffer, bufferSize, "?");
+}
+
+bool validateMotionTable(const MotionStep* steps, uint8_t stepCount, char* error, size_t errorSize) {
+    if (stepCount == 0 || stepCount > MOTION_TABLE_MAX_STEPS) {
+        snprintf(error, errorSize, "table needs 1-%u steps", MOTION_TABLE_MAX_STEPS);
+        return false;
+    }
+    if (steps[stepCount - 1].op != MOTION_END) {
+        snprintf(error, errorSize, "last step must be end");
+        return false;
+    }
+
+    int forks = 0;
+    for (uint8_t i = 0; i < stepCount; i++) {
+        if (steps[i].op != MOTION_FORK) continue;
+        uint8_t target = (uint8_t)steps[i].value;
+        // Forward only - a branch can never run back over the fork that started it
+        if (target <= i || target >= stepCount) {
+            snprintf(error, errorSize, "step %u: fork target %u must be after it", i, target);
+            return false;
+        }
+        forks++;
+    }
+    if (forks > MOTION_MAX_BRANCHES - 1) {
+        snprintf(error, errorSize, "at most %u forks", MOTION_MAX_BRANCHES - 1);
+        return false;
+    }
+    return true;
+}
+
+bool submitMotionTable(const LoadedMotionTable& table) {
+    if (!motionTableQueue) return false;
+    return xQueueSend(motionTableQueue, &table, 0) == pdTRUE;
+}
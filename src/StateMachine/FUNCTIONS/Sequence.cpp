@@ -0,0 +1,18 @@
+#include "StateMachine/FUNCTIONS/Sequence.h"
+
+//* ************************************************************************
+//* ************************** SEQUENCE ENGINE *****************************
+//* ************************************************************************
+
+void resetSequence(Sequence& sequence) {
+    sequence.resumeLine = 0;
+    clearDeadline(sequence.wait);
+}
+
+bool isSequenceRunning(const Sequence& sequence) {
+    return sequence.resumeLine != 0;
+}
+
+bool motorIdle(FastAccelStepper* motor) {
+    return motor && !motor->isRunning();
+}
@@ -1,6 +1,8 @@
 #include "StateMachine/00_STARTUP.h"
 #include "StateMachine/StateManager.h"
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Tasks/Task_Layout.h"
+#include "Timing/Deadline.h"
 #include <WiFi.h>
 
 //* ************************************************************************
@@ -20,21 +22,29 @@
 //! STEP 3: TRANSITION TO HOMING STATE
 //! ************************************************************************
 
+// Hold in STARTUP long enough for the IP address to be seen
+const unsigned long STARTUP_IP_DISPLAY_MS = 1000;
+
+static Deadline ipDisplayDeadline = {0, 0, false};
+
 void executeStartupState() {
-    turnBlueLedOn();  // Blue LED on during startup/homing
-    
-    // Display IP address on startup
-    Serial.print("IP Address: ");
-    Serial.println(WiFi.localIP());
+    if (!isDeadlineArmed(ipDisplayDeadline)) {
+        turnBlueLedOn();  // Blue LED on during startup/homing
+        
+        // Display IP address on startup
+        logMessage("IP Address: %s", WiFi.localIP().toString().c_str());
+    }
     
-    // Small delay to ensure IP is visible
-    delay(1000);
+    // Small non-blocking delay to ensure IP is visible
+    if (!waitForDeadline(ipDisplayDeadline, STARTUP_IP_DISPLAY_MS)) {
+        return;
+    }
     
     changeState(HOMING);
 }
 
 void onEnterStartupState() {
-    // No specific entry actions for startup state
+    clearDeadline(ipDisplayDeadline);
 }
 
 void onExitStartupState() {
@@ -1,6 +1,12 @@
 #include "StateMachine/01_HOMING.h"
 #include "StateMachine/StateManager.h"
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Tasks/Task_Layout.h"
+#include "Safety/State_Watchdog.h"
+#include "Timing/Timebase.h"
+#include "StateMachine/FUNCTIONS/Homing.h"
+#include "StateMachine/FUNCTIONS/Sequence.h"
+#include "Events/Input_Events.h"
 
 //* ************************************************************************
 //* ************************** HOMING STATE ********************************
@@ -12,130 +18,134 @@
 //! ************************************************************************
 
 //! ************************************************************************
-//! STEP 2: HOME THE CUT MOTOR (BLOCKING) - RETRY ON FAILURE
+//! STEP 2: RETRACT FEED CLAMP, HOME CUT AND FEED MOTORS IN PARALLEL
+//! - FEED HELD UNTIL THE CUT HOME SWITCH IS FOUND
+//! - RESULTS ARRIVE AS EVENTS, RETRY UP TO HOMING_MAX_ATTEMPTS THEN ERROR
 //! ************************************************************************
 
 //! ************************************************************************
-//! STEP 3: HOME THE FEED MOTOR (BLOCKING) - RETRACT FEED CLAMP FIRST
+//! STEP 3: MOVE FEED MOTOR TO FEED_TRAVEL_DISTANCE - RE-EXTEND FEED CLAMP
 //! ************************************************************************
 
 //! ************************************************************************
-//! STEP 4: MOVE FEED MOTOR TO FEED_TRAVEL_DISTANCE - RE-EXTEND FEED CLAMP
+//! STEP 4: SET ISHOMED FLAG TO TRUE WHEN ALL HOMING COMPLETE
 //! ************************************************************************
 
 //! ************************************************************************
-//! STEP 5: SET ISHOMED FLAG TO TRUE WHEN ALL HOMING COMPLETE
+//! STEP 5: TURN OFF BLUE LED, TURN ON GREEN LED
 //! ************************************************************************
 
 //! ************************************************************************
-//! STEP 6: TURN OFF BLUE LED, TURN ON GREEN LED
+//! STEP 6: ENSURE SERVO IS AT 2 DEGREES
 //! ************************************************************************
 
 //! ************************************************************************
-//! STEP 7: ENSURE SERVO IS AT 2 DEGREES
-//! ************************************************************************
-
-//! ************************************************************************
-//! STEP 8: TRANSITION TO IDLE STATE
+//! STEP 7: TRANSITION TO IDLE STATE
 //! ************************************************************************
 
 // Static variables for homing state tracking
-static bool cutMotorHomed = false;
-static bool feedMotorHomed = false;
-static bool feedMotorMoved = false;
-static bool feedHomingPhaseInitiated = false;
-static unsigned long blinkTimer = 0;
+static Sequence homingSequence;
+static uint8_t homingAttempt = 0;
+static bool axisHomed[HOMING_AXIS_COUNT];
+static bool homingRunFailed = false;
+static uint64_t blinkTimer = 0;
+static uint64_t homingStartTime = 0;
+
+static SequenceStatus runHomingSequence() {
+    FastAccelStepper* feedMotor = getFeedMotor();
+    SEQ_BEGIN(homingSequence);
+
+    //! STEP 2: HOME BOTH AXES, RETRYING A FAILED ATTEMPT
+    for (homingAttempt = 1; ; homingAttempt++) {
+        axisHomed[HOMING_AXIS_CUT] = false;
+        axisHomed[HOMING_AXIS_FEED] = false;
+        homingRunFailed = false;
+        retractFeedClamp();
+        startHomingAxis(HOMING_AXIS_CUT, CUT_HOME_TIMEOUT, false);
+        startHomingAxis(HOMING_AXIS_FEED, FEED_HOME_TIMEOUT, true);
+        SEQ_AWAIT(homingRunFailed || (axisHomed[HOMING_AXIS_CUT] && axisHomed[HOMING_AXIS_FEED]));
+        if (!homingRunFailed) break;
+
+        abortHoming();      // The other axis may still be moving
+        if (homingAttempt >= HOMING_MAX_ATTEMPTS) {
+            logMessage("HOMING failed after %u attempts - cut: %s, feed: %s", homingAttempt,
+                       getHomingPhaseName(getHomingPhase(HOMING_AXIS_CUT)),
+                       getHomingPhaseName(getHomingPhase(HOMING_AXIS_FEED)));
+            setErrorStartTime(nowUs());
+            changeState(ERROR);
+            SEQ_EXIT();
+        }
+        logMessage("HOMING attempt %u failed - retrying", homingAttempt);
+    }
+
+    //! STEP 3: MOVE FEED MOTOR TO FEED_TRAVEL_DISTANCE - RE-EXTEND FEED CLAMP
+    extendFeedClamp();
+    moveFeedMotorToTravel();
+    SEQ_AWAIT_STEP(motorIdle(feedMotor), "feed move to travel", FEED_MOVE_WATCHDOG_MS);
+
+    SEQ_END;
+}
 
 void onEnterHomingState() {
     // Reset homing state variables when entering
-    cutMotorHomed = false;
-    feedMotorHomed = false;
-    feedMotorMoved = false;
-    feedHomingPhaseInitiated = false;
+    resetSequence(homingSequence);
+    homingAttempt = 0;
     blinkTimer = 0;
+    homingStartTime = nowUs();
 }
 
 void executeHomingState() {
     // Blink blue LED to indicate homing in progress
-    if (millis() - blinkTimer > 500) {
+    if (msSince(blinkTimer) > 500) {
         bool blinkState = getBlinkState();
         blinkState = !blinkState;
         setBlinkState(blinkState);
         if (blinkState) turnBlueLedOn(); else turnBlueLedOff();
-        blinkTimer = millis();
+        blinkTimer = nowUs();
     }
 
     // Debug output to track homing progress
-    static unsigned long lastDebugTime = 0;
-    if (millis() - lastDebugTime >= 2000) {
-        Serial.print("HOMING STATE DEBUG - cutMotorHomed: ");
-        Serial.print(cutMotorHomed);
-        Serial.print(", feedMotorHomed: ");
-        Serial.print(feedMotorHomed);
-        Serial.print(", feedMotorMoved: ");
-        Serial.print(feedMotorMoved);
-        Serial.print(", feedHomingPhaseInitiated: ");
-        //serial.println(feedHomingPhaseInitiated);
-        lastDebugTime = millis();
+    static uint64_t lastDebugTime = 0;
+    if (msSince(lastDebugTime) >= 2000) {
+        logMessage("HOMING STATE DEBUG - attempt %u, cut: %s, feed: %s", homingAttempt,
+                   getHomingPhaseName(getHomingPhase(HOMING_AXIS_CUT)),
+                   getHomingPhaseName(getHomingPhase(HOMING_AXIS_FEED)));
+        lastDebugTime = nowUs();
     }
 
-    if (!cutMotorHomed) {
-        //serial.println("Starting cut motor homing phase (blocking)...");
-        extern const unsigned long CUT_HOME_TIMEOUT; // This is in main.cpp
-        homeCutMotorBlocking(*getCutHomingSwitch(), CUT_HOME_TIMEOUT);
-        if (getCutMotor() && getCutMotor()->getCurrentPosition() == 0) { // Check if homing was successful
-            cutMotorHomed = true;
-            //serial.println("Cut motor homing marked as successful.");
-        } else {
-            //serial.println("Cut motor homing failed or timed out. Retrying or error.");
-        }
-    } else if (!feedMotorHomed) {
-        if (!feedHomingPhaseInitiated) {
-            //serial.println("Starting feed motor homing phase (blocking)..."); 
-            retractFeedClamp(); 
-            //serial.println("Feed clamp retracted for homing."); 
-            feedHomingPhaseInitiated = true;
-        }
-        //serial.println("Calling homeFeedMotorBlocking...");
-        homeFeedMotorBlocking(*getFeedHomingSwitch());
-        feedMotorHomed = true; 
-        feedHomingPhaseInitiated = false; // Reset for next potential homing cycle
-        //serial.println("Feed motor homing marked as successful.");
-    } else if (!feedMotorMoved) {
-        //serial.println("Moving feed motor to travel distance...");
-        extendFeedClamp();
-        //serial.println("Feed clamp re-extended.");
-        moveFeedMotorToTravel();
-        while(getFeedMotor()->isRunning()){
-            // Wait for feed motor to reach FEED_TRAVEL_DISTANCE
-        }
-        feedMotorMoved = true;
-        //serial.println("Feed motor moved to FEED_TRAVEL_DISTANCE (blocking complete).");
-    } else {
-        //serial.println("All homing steps complete! Transitioning to IDLE..."); 
-        cutMotorHomed = false; 
-        feedMotorHomed = false;
-        feedMotorMoved = false;
-        
-        extern bool isHomed; // This is in main.cpp
-        isHomed = true; 
-        //serial.println("isHomed flag set to true.");
-
-        turnBlueLedOff();
-        turnGreenLedOn();
-        //serial.println("LEDs updated: Blue OFF, Green ON.");
-
-        // SAFETY CHANGE: Do NOT automatically home the rotation servo on startup
-        // This prevents ramming stuck wood pieces into the blade during emergency restart
-        // The servo will only be homed when manually starting a cut cycle
-        //serial.println("Servo homing skipped on startup for safety - will home when cut cycle starts.");
-        
-        //serial.println("Changing state to IDLE...");
-        changeState(IDLE);
-        //serial.println("State change to IDLE completed.");
+    if (runHomingSequence() != SEQUENCE_DONE || getCurrentState() != HOMING) return;
+
+    //! STEP 4: SET ISHOMED FLAG TO TRUE WHEN ALL HOMING COMPLETE
+    extern bool isHomed; // This is in main.cpp
+    isHomed = true; 
+    unsigned long homingMs = (unsigned long)msSince(homingStartTime);
+    recordHomingSequence(homingMs);
+    logMessage("Homing complete in %lu ms (%u attempt%s)", homingMs, homingAttempt, homingAttempt == 1 ? "" : "s");
+
+    //! STEP 5: TURN OFF BLUE LED, TURN ON GREEN LED
+    turnBlueLedOff();
+    turnGreenLedOn();
+
+    //! STEP 6: SERVO
+    // SAFETY CHANGE: Do NOT automatically home the rotation servo on startup
+    // This prevents ramming stuck wood pieces into the blade during emergency restart
+    // The servo will only be homed when manually starting a cut cycle
+
+    //! STEP 7: TRANSITION TO IDLE STATE
+    changeState(IDLE);
+}
+
+void handleHomingEvent(const InputEvent& event) {
+    if (event.detail >= HOMING_AXIS_COUNT) return;
+    if (event.type == EVENT_HOMING_DONE) {
+        axisHomed[event.detail] = true;
+    } else if (event.type == EVENT_HOMING_FAILED) {
+        homingRunFailed = true;
     }
 }
 
 void onExitHomingState() {
-    // No specific cleanup needed for HOMING state
-} 
\ No newline at end of file
+    // Leaving mid-run (hard stop, watchdog): stop any axis still homing
+    abortHoming();
+    resetSequence(homingSequence);
+}
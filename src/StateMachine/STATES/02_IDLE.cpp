@@ -1,6 +1,9 @@
 #include "StateMachine/02_IDLE.h"
 #include "StateMachine/StateManager.h"
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "Events/Input_Events.h"
+#include "Tasks/Task_Layout.h"
+#include "Config/Material_Recipes.h"
 
 //* ************************************************************************
 //* ************************** IDLE STATE **********************************
@@ -48,14 +51,60 @@ void executeIdleState() {
     // Handle reload mode logic first
     handleReloadModeLogic();
     
-    // Check for FeedFirstCut conditions if not in reload mode
+    // Continuous mode can start a cycle without a switch edge
     if (!getIsReloadMode()) {
+        checkStartConditions(false);
+    }
+}
+
+// Switch edges arrive here (STATE_TABLE: PUSHWOOD_PRESSED, START_SWITCH_ON)
+void handleIdleEvent(const InputEvent& event) {
+    // Events are dispatched before executeIdleState() - settle reload mode first as the polled version did
+    handleReloadModeLogic();
+    if (getIsReloadMode()) return;
+
+    if (event.type == EVENT_PUSHWOOD_PRESSED) {
         checkFirstCutConditions();
-        checkStartConditions();
+    } else if (event.type == EVENT_START_SWITCH_ON) {
+        checkStartConditions(true);
     }
 }
 
+// Console / network commands arrive here (STATE_TABLE: START_CYCLE, SELECT_RECIPE).
+// A refused command returns false so it is counted as rejected.
+bool handleIdleCommand(const ControlCommand& command) {
+    handleReloadModeLogic();
+
+    if (command.type == CONTROL_CMD_START_CYCLE) {
+        if (getIsReloadMode()) {
+            logMessage("Start command refused - reload mode is on");
+            return false;
+        }
+        // Same checks as the start switch edge (suction error, start switch safety)
+        checkStartConditions(true);
+        if (getCurrentState() != CUTTING) {
+            logMessage("Start command refused - start conditions not met");
+            return false;
+        }
+        return true;
+    }
+
+    if (command.type == CONTROL_CMD_SELECT_RECIPE) {
+        if (!selectRecipe(command.arg)) {
+            logMessage("Recipe %u does not exist", command.arg);
+            return false;
+        }
+        logMessage("Recipe %s selected", getActiveRecipe().name);
+        return true;
+    }
+    return false;
+}
+
 void onEnterIdleState() {
+    // A stop command has done its job once the machine is back in IDLE
+    setCycleStopRequested(false);
+    
+
     // Check if coming from no2x4 with no wood detected - if so, keep secure clamp extended
     if (!getComingFromNoWoodWithSensorsClear()) {
         // Only retract secure clamp if not coming from no2x4 with no wood
@@ -99,27 +148,24 @@ void handleReloadModeLogic() {
 }
 
 void checkFirstCutConditions() {
-    // Check for pushwood forward switch press and FIRST_CUT_OR_WOOD_FWD_ONE sensor state
-    extern Bounce pushwoodForwardSwitch;
+    // Pushwood forward switch was pressed - the FIRST_CUT_OR_WOOD_FWD_ONE sensor picks the sequence
     extern const int FIRST_CUT_OR_WOOD_FWD_ONE;
-    bool pushwoodPressed = pushwoodForwardSwitch.rose();
     bool firstCutSensorHigh = (digitalRead(FIRST_CUT_OR_WOOD_FWD_ONE) == HIGH);
     bool firstCutSensorLow = (digitalRead(FIRST_CUT_OR_WOOD_FWD_ONE) == LOW);
     
-    if (pushwoodPressed && firstCutSensorHigh) {
+    if (firstCutSensorHigh) {
         //serial.println("Idle: Manual feed switch pressed with FIRST_CUT_OR_WOOD_FWD_ONE sensor HIGH - transitioning to FEED_FIRST_CUT");
         changeState(FEED_FIRST_CUT);
     }
-    else if (pushwoodPressed && firstCutSensorLow) {
+    else if (firstCutSensorLow) {
         //serial.println("Idle: Manual feed switch pressed with FIRST_CUT_OR_WOOD_FWD_ONE sensor LOW - transitioning to FEED_WOOD_FWD_ONE");
         changeState(FEED_WOOD_FWD_ONE);
     }
 }
 
-void checkStartConditions() {
+void checkStartConditions(bool startCycleRose) {
     turnGreenLedOn();
     
-    bool startCycleRose = getStartCycleSwitch()->rose();
     bool continuousModeActive = getContinuousModeActive();
     bool cuttingCycleInProgress = getCuttingCycleInProgress();
     bool woodSuctionError = getWoodSuctionError();
@@ -2,26 +2,128 @@
 #include "StateMachine/StateManager.h"
 #include "StateMachine/FUNCTIONS/General_Functions.h"
 #include "StateMachine/STATES/States_Config.h"
+#include "Tasks/Task_Layout.h"
+#include "Events/Input_Events.h"
+#include "Timing/Timebase.h"
+#include "Config/Material_Recipes.h"
+#include "StateMachine/FUNCTIONS/Cut_Stroke.h"
+#include "Timing/Position_Triggers.h"
+#include "Config/Pins_Definitions.h"
+#include "Timing/Deadline.h"
 
 //* ************************************************************************
 //* ************************** CUTTING STATE *******************************
 //* ************************************************************************
 // Handles the wood cutting operation with a clean 3-step process:
-// Step 0: Initialize cutting sequence - extend clamps and configure motors
+// Step 0: Initialize cutting sequence - extend clamps and start the zoned cut stroke
+//         (held if a rapid approach would reach the wood before the feed clamp closes)
 // Step 1: Check suction sensor and start cut motor movement
-// Step 2: Monitor cut motor position, activate rotation components, and complete cut
+// Step 2: Rotation clamp, rotation servo and TA fire from position triggers; complete cut
+// The stroke's speed zones (approach / cut / exit) are switched every pass in
+// steps 1 and 2 - see StateMachine/FUNCTIONS/Cut_Stroke.h.
 // 
 // After cutting completion, transitions to appropriate RETURNING state based on wood detection.
 // All post-cutting logic (return sequences, homing, continuous mode) is handled by RETURNING states.
 
 // Static variables for cutting state tracking
 static int cuttingStep = 0;
-static unsigned long stepStartTime = 0;
+static uint64_t stepStartTime = 0;
 static bool homePositionErrorDetected = false;
 static bool rotationClampActivatedThisCycle = false;
 static bool rotationServoActivatedThisCycle = false;
 static bool transferArmSignalSentThisCycle = false;
-static unsigned long lastWoodSensorCheckTime = 0;
+static uint64_t lastWoodSensorCheckTime = 0;
+static Deadline feedClampLeadDeadline = {0, 0, false};
+
+//* ************************************************************************
+//* ************************** POSITION TRIGGERS ***************************
+//* ************************************************************************
+// Armed when the suction check passes (step 1 -> 2) and fired from the planned
+// cut trajectory (Timing/Position_Triggers.h). The outputs run on the timer task
+// and only write the pin / servo; the actuator functions then run on the control
+// task for their timers and flags, rewriting the same output level.
+
+static PositionTrigger rotationClampTrigger;
+static PositionTrigger rotationServoTrigger;
+static PositionTrigger taSignalTrigger;
+
+static void writeRotationClampExtended() {
+    digitalWrite(ROTATION_CLAMP, HIGH);
+}
+
+static void writeRotationServoActive() {
+    Servo* servo = getRotationServo();
+    if (servo) servo->write(ROTATION_SERVO_ACTIVE_POSITION);
+}
+
+static void writeTASignalHigh() {
+    digitalWrite(TRANSFER_ARM_SIGNAL_PIN, HIGH);
+}
+
+static void logTriggerFired(const char* what, const PositionTrigger& trigger) {
+    logMessage("%s fired at %.3f inches (target %.3f, error %ld steps%s)", what,
+               (float)trigger.firedPositionSteps / CUT_MOTOR_STEPS_PER_INCH,
+               (float)trigger.targetSteps / CUT_MOTOR_STEPS_PER_INCH,
+               (trigger.firedPositionSteps - trigger.targetSteps) * trigger.direction,
+               trigger.firedByPoll ? ", polled" : "");
+}
+
+static void onRotationClampTriggered(const PositionTrigger& trigger) {
+    extendRotationClamp();
+    rotationClampActivatedThisCycle = true;
+    logTriggerFired("Rotation clamp", trigger);
+}
+
+static void onRotationServoTriggered(const PositionTrigger& trigger) {
+    activateRotationServo();
+    rotationServoActivatedThisCycle = true;
+    logTriggerFired("Rotation servo", trigger);
+}
+
+static void onTASignalTriggered(const PositionTrigger& trigger) {
+    sendSignalToTA();
+    transferArmSignalSentThisCycle = true;
+    logTriggerFired("TA signal", trigger);
+}
+
+void setupCuttingTriggers() {
+    registerPositionTrigger(rotationClampTrigger, "rotation_clamp", TRIGGER_AXIS_CUT, 1,
+                            writeRotationClampExtended, onRotationClampTriggered);
+    registerPositionTrigger(rotationServoTrigger, "rotation_servo", TRIGGER_AXIS_CUT, 1,
+                            writeRotationServoActive, onRotationServoTriggered);
+    registerPositionTrigger(taSignalTrigger, "ta_signal", TRIGGER_AXIS_CUT, 1,
+                            writeTASignalHigh, onTASignalTriggered);
+}
+
+// Arm a trigger early enough, at the planned stroke speed, for an actuator taking
+// responseMs to be done when the carriage reaches needSteps
+static void armLeadTrigger(PositionTrigger& trigger, const char* what, long needSteps, unsigned long responseMs) {
+    long activationSteps = planActuatorLeadSteps(getCutStrokePlan(), needSteps, responseMs);
+    armPositionTrigger(trigger, activationSteps);
+
+    FastAccelStepper* cutMotor = getCutMotor();
+    long armedAtSteps = cutMotor ? cutMotor->getCurrentPosition() : 0;
+    if (activationSteps <= armedAtSteps) {
+        logMessage("WARNING: %s needs %lu ms lead, from %.3f inches - already passed at arming, fires now",
+                   what, responseMs, (float)activationSteps / CUT_MOTOR_STEPS_PER_INCH);
+    } else {
+        logMessage("%s: %lu ms lead, fires at %.3f inches to be done at %.3f inches", what, responseMs,
+                   (float)activationSteps / CUT_MOTOR_STEPS_PER_INCH, (float)needSteps / CUT_MOTOR_STEPS_PER_INCH);
+    }
+}
+
+static void armCuttingTriggers() {
+    long endSteps = getCutStrokePlan().endSteps;
+    armLeadTrigger(rotationClampTrigger, "Rotation clamp", getRotationClampClosedSteps(), ROTATION_CLAMP_RESPONSE_MS);
+    armLeadTrigger(rotationServoTrigger, "Rotation servo", endSteps, ROTATION_SERVO_RESPONSE_MS);
+    armLeadTrigger(taSignalTrigger, "TA signal", endSteps, TA_SIGNAL_RESPONSE_MS);
+}
+
+static void disarmCuttingTriggers() {
+    disarmPositionTrigger(rotationClampTrigger);
+    disarmPositionTrigger(rotationServoTrigger);
+    disarmPositionTrigger(taSignalTrigger);
+}
 
 void onEnterCuttingState() {
     resetCuttingSteps();
@@ -37,6 +139,11 @@ void executeCuttingState() {
         return;
     }
 
+    // Zone edges are checked before the step logic so a speed change is never a pass late
+    if (cuttingStep > 0) {
+        serviceCutStroke();
+    }
+
     switch (cuttingStep) {
         case 0: 
             handleCuttingStep0();
@@ -50,23 +157,48 @@ void executeCuttingState() {
     }
 }
 
+// The feed clamp has to be closed before the blade reaches the wood. A rapid
+// approach can get there sooner than FEED_CLAMP_RESPONSE_MS; the stroke start is
+// held for the difference. A single cut-feed stroke has no measured contact point
+// and starts with the clamp, as it always has.
+static unsigned long getFeedClampHoldMs() {
+    CutStrokePlan plan;
+    planCutStroke(getActiveRecipe(), plan);
+    if (!plan.hasApproach) return 0;
+
+    unsigned long contactMs = planCutTimeToMs(plan, plan.contactSteps);
+    return contactMs >= FEED_CLAMP_RESPONSE_MS ? 0 : FEED_CLAMP_RESPONSE_MS - contactMs;
+}
+
 void handleCuttingStep0() {
-    Serial.println("Starting cut motion");
-        
-    extend2x4SecureClamp();
-    extendFeedClamp();
+    if (!isDeadlineArmed(feedClampLeadDeadline)) {
+        logMessage("Starting cut motion");
 
-    // Only home rotation servo if wood is properly grabbed (safety check)
-    Bounce* suctionSensor = getSuctionSensorBounce();
-    if (suctionSensor && suctionSensor->read() == HIGH) {
-        handleRotationServoReturn();
-        Serial.println("Rotation servo homed for cut cycle - wood properly grabbed by transfer arm");
-    } else {
-        Serial.println("WARNING: Wood not properly grabbed by transfer arm - rotation servo NOT homed for safety");
+        extend2x4SecureClamp();
+        extendFeedClamp();
+
+        // Only home rotation servo if wood is properly grabbed (safety check)
+        Bounce* suctionSensor = getSuctionSensorBounce();
+        if (suctionSensor && suctionSensor->read() == HIGH) {
+            handleRotationServoReturn();
+            logMessage("Rotation servo homed for cut cycle - wood properly grabbed by transfer arm");
+        } else {
+            logMessage("WARNING: Wood not properly grabbed by transfer arm - rotation servo NOT homed for safety");
+        }
+
+        unsigned long holdMs = getFeedClampHoldMs();
+        if (holdMs > 0) {
+            logMessage("Cut stroke held %lu ms for the feed clamp to close before blade contact", holdMs);
+            startDeadline(feedClampLeadDeadline, holdMs);
+            return;
+        }
+    } else if (!isDeadlineExpired(feedClampLeadDeadline)) {
+        return;
     }
+    clearDeadline(feedClampLeadDeadline);
 
-    configureCutMotorForCutting();
-    moveCutMotorToCut();
+    // Approach / cut / exit zones from the active recipe, one move to CUT_TRAVEL_DISTANCE
+    startCutStroke();
     
     rotationClampActivatedThisCycle = false;
     cuttingStep = 1;
@@ -76,7 +208,7 @@ void handleCuttingStep1() {
     extern const int WOOD_SUCTION_CONFIRM_SENSOR;
     
     if (stepStartTime == 0) {
-        stepStartTime = millis();
+        stepStartTime = nowUs();
     }
 
     //! ************************************************************************
@@ -105,7 +237,8 @@ void handleCuttingStep1() {
             stepStartTime = 0;
             return;
         } else {
-            // Suction OK - continue cutting
+            // Suction OK - continue cutting; the rotation components now fire on position
+            armCuttingTriggers();
             cuttingStep = 2;
             stepStartTime = 0;
         }
@@ -121,50 +254,23 @@ void handleCuttingStep2() {
     //! ************************************************************************
     checkWoodPresentSensor();
     
-    static unsigned long lastDebugTime = 0;
-    if (millis() - lastDebugTime >= 1000) {
+    static uint64_t lastDebugTime = 0;
+    if (msSince(lastDebugTime) >= 1000) {
         if (cutMotor) {
             long currentPosition = cutMotor->getCurrentPosition();
             float currentPositionInches = (float)currentPosition / CUT_MOTOR_STEPS_PER_INCH;
-            Serial.print("Cut position: ");
-            Serial.print(currentPositionInches, 2);
-            Serial.print("/");
-            Serial.print(CUT_TRAVEL_DISTANCE);
-            Serial.print(" inches, Running: ");
-            Serial.println(cutMotor->isRunning() ? "YES" : "NO");
+            logMessage("Cut position: %.2f/%.2f inches, Running: %s, Zone: %s",
+                       currentPositionInches, CUT_TRAVEL_DISTANCE, cutMotor->isRunning() ? "YES" : "NO",
+                       getCutZoneName(getCutZone()));
         }
-        lastDebugTime = millis();
-    }
-    
-    if (!rotationClampActivatedThisCycle && cutMotor &&
-        cutMotor->getCurrentPosition() >= ROTATION_CLAMP_ACTIVATION_POSITION_STEPS) {
-        extendRotationClamp();
-        rotationClampActivatedThisCycle = true;
-        Serial.print("Rotation clamp activated at ");
-        Serial.print((float)ROTATION_CLAMP_ACTIVATION_POSITION_STEPS / CUT_MOTOR_STEPS_PER_INCH, 2);
-        Serial.println(" inches");
-    }
-    
-    if (!rotationServoActivatedThisCycle && cutMotor &&
-        cutMotor->getCurrentPosition() >= ROTATION_SERVO_ACTIVATION_POSITION_STEPS) {
-        activateRotationServo();
-        rotationServoActivatedThisCycle = true;
-        Serial.print("Rotation servo activated at ");
-        Serial.print((float)ROTATION_SERVO_ACTIVATION_POSITION_STEPS / CUT_MOTOR_STEPS_PER_INCH, 2);
-        Serial.println(" inches");
-    }
-    
-    if (!transferArmSignalSentThisCycle && cutMotor &&
-        cutMotor->getCurrentPosition() >= TA_SIGNAL_ACTIVATION_POSITION_STEPS) {
-        sendSignalToTA();
-        transferArmSignalSentThisCycle = true;
-        Serial.print("TA signal sent at ");
-        Serial.print((float)TA_SIGNAL_ACTIVATION_POSITION_STEPS / CUT_MOTOR_STEPS_PER_INCH, 2);
-        Serial.println(" inches (early activation)");
+        lastDebugTime = nowUs();
     }
     
     if (cutMotor && !cutMotor->isRunning()) {
-        Serial.println("Cut cycle complete - transitioning to return sequence");
+        logMessage("Cut cycle complete - transitioning to return sequence");
+        // Any target passed since handleCommonOperations() fires before the triggers are disarmed
+        servicePositionTriggers();
+        finishCutStroke();
         configureCutMotorForReturn();
         transferArmSignalSentThisCycle = false;
 
@@ -181,15 +287,15 @@ void handleCuttingStep2() {
 
 
 void handleHomePositionError() {
-    unsigned long lastErrorBlinkTime = getLastErrorBlinkTime();
+    uint64_t lastErrorBlinkTime = getLastErrorBlinkTime();
     bool errorBlinkState = getErrorBlinkState();
     
-    if (millis() - lastErrorBlinkTime > 100) { 
+    if (msSince(lastErrorBlinkTime) > 100) { 
         errorBlinkState = !errorBlinkState;
         setErrorBlinkState(errorBlinkState);
         if(errorBlinkState) turnRedLedOn(); else turnRedLedOff();
         if(!errorBlinkState) turnYellowLedOn(); else turnYellowLedOff();
-        setLastErrorBlinkTime(millis());
+        setLastErrorBlinkTime(nowUs());
     }
     
     FastAccelStepper* cutMotor = getCutMotor();
@@ -199,7 +305,7 @@ void handleHomePositionError() {
     
     extend2x4SecureClamp();
     
-    if (getReloadSwitch()->rose()) {
+    if (inputEventThisPass(EVENT_RELOAD_SWITCH_ON)) { // Polling shim - CUTTING has no event handler yet
         homePositionErrorDetected = false;
         changeState(ERROR_RESET);
         setErrorAcknowledged(true);
@@ -214,6 +320,8 @@ void resetCuttingSteps() {
     rotationServoActivatedThisCycle = false;
     transferArmSignalSentThisCycle = false;
     lastWoodSensorCheckTime = 0;
+    clearDeadline(feedClampLeadDeadline);
+    disarmCuttingTriggers();
 }
 
 //* ************************************************************************
@@ -226,7 +334,7 @@ void checkWoodPresentSensor() {
     extern const int _2x4_PRESENT_SENSOR;
     
     // Check every 100ms
-    if (millis() - lastWoodSensorCheckTime >= 100) {
+    if (msSince(lastWoodSensorCheckTime) >= 100) {
         int sensorValue = digitalRead(_2x4_PRESENT_SENSOR);
         bool woodPresent = (sensorValue == LOW); // Active LOW sensor
         
@@ -236,6 +344,6 @@ void checkWoodPresentSensor() {
             turnYellowLedOn(); // No wood - yellow LED
         }
         
-        lastWoodSensorCheckTime = millis();
+        lastWoodSensorCheckTime = nowUs();
     }
 } 
\ No newline at end of file
@@ -6,6 +6,12 @@
 #include "../../../include/StateMachine/FUNCTIONS/General_Functions.h"
 #include "../../../include/Config/Pins_Definitions.h"
 #include "../../../include/StateMachine/STATES/States_Config.h"
+#include "../../../include/Tasks/Task_Layout.h"
+#include "../../../include/StateMachine/FUNCTIONS/Sequence.h"
+#include "../../../include/Safety/Stop_Interrupts.h"
+#include "../../../include/Safety/Home_Drift.h"
+#include "../../../include/Timing/Timebase.h"
+#include "../../../include/Config/Material_Recipes.h"
 
 //* ************************************************************************
 //* ******************** RETURNING YES 2X4 STATE **************************
@@ -15,20 +21,26 @@
 // Includes final feed wood movement to 3.4 inches before transitioning to next cycle or IDLE.
 // 
 // Feed clamp extension occurs immediately after feed motor completion.
+// The move to feed travel starts as soon as the returning blade is clear of the wood
+// (CUT_RETURN_BLADE_CLEAR_INCHES) and runs while the cut motor finishes homing; if the
+// home switch then cannot be verified, the feed move is stopped until it is.
+//
+// Where the cut axis found home is recorded before it is re-zeroed (Safety/Home_Drift.h);
+// drift past the re-home limit sends the machine to HOMING instead of the next cycle.
 
-// Static variables for returning yes 2x4 state tracking
-static int returningYes2x4SubStep = 0;
-static int feedMotorReturnSubStep = 0; // For initial feed motor return sequence
+// Sequence state for returning yes 2x4
+static Sequence returningYes2x4Sequence;
 
-// Cut motor homing recovery timing
-static unsigned long cutMotorHomingAttemptStartTime = 0;
-static bool cutMotorHomingAttemptInProgress = false;
+// Cut motor homing recovery - total distance moved by incremental recovery moves
 static float cutMotorIncrementalMoveTotalInches = 0.0;
 
-// Feed wood movement sequence tracking
-static int feedMotorHomingSubStep = 0;
+// Cut motor home switch verification - up to 3 reads spaced by SENSOR_STABILIZATION_DELAY_MS
+const int CUT_HOME_VERIFICATION_ATTEMPTS = 3;
+static int cutHomeVerificationAttempt = 0;
 
-// Feed clamp extension variables (no delay needed)
+// Feed move to travel started at blade clear, and stopped again because home was not verified
+static bool feedTravelStartedEarly = false;
+static bool feedTravelHeld = false;
 
 void executeReturningYes2x4State() {
     handleReturningYes2x4Sequence();
@@ -45,17 +57,17 @@ void onEnterReturningYes2x4State() {
     // Enable cut motor homing sensor monitoring during return
     extern bool cutMotorInReturningYes2x4Return;
     cutMotorInReturningYes2x4Return = true;
+    armCutHomeStop();
     
     moveCutMotorToHome();
     retract2x4SecureClamp();
     
     // Initialize step tracking
-    returningYes2x4SubStep = 0;
-    feedMotorReturnSubStep = 0;
-    cutMotorHomingAttemptStartTime = 0;
-    cutMotorHomingAttemptInProgress = false;
+    resetSequence(returningYes2x4Sequence);
     cutMotorIncrementalMoveTotalInches = 0.0;
-    feedMotorHomingSubStep = 0;
+    cutHomeVerificationAttempt = 0;
+    feedTravelStartedEarly = false;
+    feedTravelHeld = false;
 }
 
 void onExitReturningYes2x4State() {
@@ -65,204 +77,178 @@ void onExitReturningYes2x4State() {
 //* ************************************************************************
 //* ******************** MAIN SEQUENCE HANDLER ****************************
 //* ************************************************************************
-// Manages the complete RETURNING_YES_2x4 sequence through multiple substeps
+// The feed motor return runs while the cut motor is still returning home (started
+// in onEnter), then the sequence waits for the cut motor and verifies home.
 
 void handleReturningYes2x4Sequence() {
+    runReturningYes2x4Sequence();
+}
+
+// True once the returning cut motor is below the blade clear position, or has stopped
+static bool cutBladeClearOnReturn(FastAccelStepper* cutMotor) {
+    if (motorIdle(cutMotor)) return true;
+    if (CUT_RETURN_BLADE_CLEAR_INCHES <= 0.0f) return false;
+    return cutMotor->getCurrentPosition() <= (long)(CUT_RETURN_BLADE_CLEAR_INCHES * CUT_MOTOR_STEPS_PER_INCH);
+}
+
+static void startFeedToTravel() {
+    retract2x4SecureClamp();
+    configureFeedMotorForNormalOperation();
+    moveFeedMotorToPosition(getActiveRecipe().feedTravelDistanceInches);
+}
+
+SequenceStatus runReturningYes2x4Sequence() {
     FastAccelStepper* feedMotor = getFeedMotor();
     FastAccelStepper* cutMotor = getCutMotor();
-    extern const float FEED_TRAVEL_DISTANCE;
     extern bool cutMotorInReturningYes2x4Return;
+    bool sensorDetectedHome = false;
     
-    switch (returningYes2x4SubStep) {
-        case 0: // Execute feed motor return sequence (without homing)
-            handleFeedMotorReturnSequence();
-            break;
-            
-        case 1: // Wait for feed motor to complete return movement (no homing)
-            if (feedMotor && !feedMotor->isRunning()) {
-                //! ************************************************************************
-                //! STEP 2: FEED MOTOR RETURN COMPLETE - EXTEND FEED CLAMP IMMEDIATELY
-                //! ************************************************************************
-                extendFeedClamp();
-                returningYes2x4SubStep = 2;
-            }
-            break;
+    SEQ_BEGIN(returningYes2x4Sequence);
 
-        case 2: // Wait for cut motor completion
-            // Wait for cut motor to complete return home, then execute homing sequence
-            if (cutMotor && !cutMotor->isRunning() && !cutMotorHomingAttemptInProgress) {
-                //! ************************************************************************
-                //! STEP 3: CUT MOTOR RETURN COMPLETE - START HOMING VERIFICATION SEQUENCE
-                //! ************************************************************************
-                cutMotorInReturningYes2x4Return = false;
-                
-                bool sensorDetectedHome = false;
-                
-                // Execute homing verification sequence - 3-attempt verification
-                for (int i = 0; i < 3; i++) {
-                    delay(30);
-                    getCutHomingSwitch()->update();
-                    bool sensorReading = getCutHomingSwitch()->read();
-                    
-                    if (sensorReading == HIGH) {
-                        sensorDetectedHome = true;
-                        break;
-                    }
-                }
-                
-                if (sensorDetectedHome) {
-                //! ************************************************************************
-                //! STEP 4: HOMING VERIFIED - SET POSITION TO 0 AND PROCEED WITH FEED WOOD MOVEMENT
-                //! ************************************************************************
-                    if (cutMotor) cutMotor->setCurrentPosition(0);
-                    cutMotorIncrementalMoveTotalInches = 0.0; // Reset on success
-                    
-                    retract2x4SecureClamp();
-                    configureFeedMotorForNormalOperation();
-                    moveFeedMotorToPosition(FEED_TRAVEL_DISTANCE);
-                    returningYes2x4SubStep = 3;
-                } else {
-                    // Home switch not detected - try incremental move recovery
-                    extern const float CUT_MOTOR_INCREMENTAL_MOVE_INCHES;
-                    extern const float CUT_MOTOR_MAX_INCREMENTAL_MOVE_INCHES;
-                    extern const float CUT_MOTOR_STEPS_PER_INCH;
-                    
-                    if (cutMotorIncrementalMoveTotalInches < CUT_MOTOR_MAX_INCREMENTAL_MOVE_INCHES) {
-                        Serial.print("Attempting incremental move. Total moved: ");
-                        Serial.print(cutMotorIncrementalMoveTotalInches);
-                        Serial.println(" inches.");
-                        if (cutMotor) {
-                            cutMotor->move(-CUT_MOTOR_INCREMENTAL_MOVE_INCHES * CUT_MOTOR_STEPS_PER_INCH);
-                            cutMotorIncrementalMoveTotalInches += CUT_MOTOR_INCREMENTAL_MOVE_INCHES;
-                        }
-                        // Stay in same step to re-check sensor after move
-                    } else {
-                        // Max incremental moves exceeded - transition to error
-                        Serial.println("ERROR: Cut motor position switch did not detect home after MAX incremental moves!");
-                        if (cutMotor) cutMotor->forceStop();
-                        if (feedMotor) feedMotor->forceStop();
-                        extend2x4SecureClamp();
-                        turnRedLedOn();
-                        turnYellowLedOff();
-                        changeState(ERROR);
-                        setErrorStartTime(millis());
-                        resetReturningYes2x4Steps();
-                        return;
-                    }
-                }
-            }
-            break;
-            
-        case 3: // Execute feed wood movement to 3.4 inches
-            handleFeedWoodMovement();
-            break;
-            
-        case 4: // Complete sequence - check for continuous operation or return to IDLE
-            if (feedMotor && !feedMotor->isRunning()) {
-                //! ************************************************************************
-                //! STEP 5: SEQUENCE COMPLETE - CHECK FOR CONTINUOUS OPERATION OR RETURN TO IDLE
-                //! ************************************************************************
-                extend2x4SecureClamp();
-                turnYellowLedOff();
-                setCuttingCycleInProgress(false);
-                
-                // Reset consecutive yeswood counter only when it reaches 3
-                if (getConsecutiveYeswoodCount() >= 3) {
-                    resetConsecutiveYeswoodCount();
-                }
-                
-                // Check for continuous operation mode
-                if (getStartCycleSwitch()->read() == HIGH && getStartSwitchSafe()) {
-                    extendFeedClamp();
-                    configureCutMotorForCutting();
-                    turnYellowLedOn();
-                    setCuttingCycleInProgress(true);
-                    changeState(CUTTING);
-                    resetReturningYes2x4Steps();
-                } else {
-                    changeState(IDLE);
-                    resetReturningYes2x4Steps();
-                }
-            }
-            break;
+    //! ************************************************************************
+    //! STEP 6: MOVE FEED MOTOR RETURN DISTANCE
+    //! ************************************************************************
+    configureFeedMotorForReturn();
+    if (feedMotor) {
+        feedMotor->move(-FEED_MOTOR_RETURN_DISTANCE * FEED_MOTOR_STEPS_PER_INCH);
     }
-}
+    SEQ_AWAIT_STEP(motorIdle(feedMotor), "feed return move", SEQUENCE_AWAIT_WATCHDOG_MS);
 
-//* ************************************************************************
-//* ****************** FEED MOTOR RETURN SEQUENCE **************************
-//* ************************************************************************
-// Handles the feed motor return sequence during simultaneous operation (no homing)
+    //! ************************************************************************
+    //! STEP 7: RETRACT FEED CLAMP AND EXTEND 2X4 SECURE CLAMP
+    //! ************************************************************************
+    retractFeedClamp();
+    extend2x4SecureClamp();
 
-void handleFeedMotorReturnSequence() {
-    FastAccelStepper* feedMotor = getFeedMotor();
-    
-    switch (feedMotorReturnSubStep) {
-        case 0: // Move feed motor back specified distance
-            //! ************************************************************************
-            //! STEP 6: MOVE FEED MOTOR RETURN DISTANCE
-            //! ************************************************************************
-            configureFeedMotorForReturn();
-            if (feedMotor) {
-                feedMotor->move(-FEED_MOTOR_RETURN_DISTANCE * FEED_MOTOR_STEPS_PER_INCH);
-            }
-            feedMotorReturnSubStep = 1;
-            break;
-            
-        case 1: // Wait for move completion then adjust clamps
-            if (feedMotor && !feedMotor->isRunning()) {
-                //! ************************************************************************
-                //! STEP 7: RETRACT FEED CLAMP AND EXTEND 2X4 SECURE CLAMP
-                //! ************************************************************************
-                retractFeedClamp();
-                extend2x4SecureClamp();
-                feedMotorReturnSubStep = 2;
-            }
-            break;
-            
-        case 2: // Start feed motor return to home
-            //! ************************************************************************
-            //! STEP 8: RETURN FEED MOTOR TO HOME POSITION
-            //! ************************************************************************
-            if (feedMotor) {
-                moveFeedMotorToHome();
-            }
-            returningYes2x4SubStep = 1;
-            break;
+    //! ************************************************************************
+    //! STEP 8: RETURN FEED MOTOR TO HOME POSITION
+    //! ************************************************************************
+    moveFeedMotorToHome();
+    SEQ_AWAIT_STEP(motorIdle(feedMotor), "feed to home", SEQUENCE_AWAIT_WATCHDOG_MS);
+
+    //! ************************************************************************
+    //! STEP 2: FEED MOTOR RETURN COMPLETE - EXTEND FEED CLAMP IMMEDIATELY
+    //! ************************************************************************
+    extendFeedClamp();
+
+    //! ************************************************************************
+    //! STEP 3: BLADE CLEAR - START THE FEED MOVE WHILE THE CUT MOTOR FINISHES HOMING
+    //! ************************************************************************
+    SEQ_AWAIT_STEP(cutBladeClearOnReturn(cutMotor), "cut blade clear", SEQUENCE_AWAIT_WATCHDOG_MS);
+    if (!motorIdle(cutMotor)) {
+        logMessage("Blade clear at %.2f inches - feed move to travel started during cut return",
+                   (float)cutMotor->getCurrentPosition() / CUT_MOTOR_STEPS_PER_INCH);
+        startFeedToTravel();
+        feedTravelStartedEarly = true;
     }
-}
 
-//* ************************************************************************
-//* ****************** FEED WOOD MOVEMENT SEQUENCE *************************
-//* ************************************************************************
-// Handles the feed wood movement to 3.4 inches with feed clamp extended
+    //! ************************************************************************
+    //! STEP 3B: CUT MOTOR RETURN COMPLETE - START HOMING VERIFICATION SEQUENCE
+    //! ************************************************************************
+    SEQ_AWAIT_STEP(motorIdle(cutMotor), "cut return", SEQUENCE_AWAIT_WATCHDOG_MS);
+    cutMotorInReturningYes2x4Return = false;
+    disarmCutHomeStop();
 
-void handleFeedWoodMovement() {
-    FastAccelStepper* feedMotor = getFeedMotor();
-    extern const float FEED_MOTOR_HOMING_SPEED;
-    extern const float FEED_TRAVEL_DISTANCE;
-    extern const float FEED_MOTOR_STEPS_PER_INCH;
-    
-    // Non-blocking feed wood movement to 3.4 inches
-    switch (feedMotorHomingSubStep) {
-        case 0: // Start feed wood movement to 3.4 inches
-            if (feedMotor) {
-                configureFeedMotorForNormalOperation();
-                feedMotor->moveTo(3.4 * FEED_MOTOR_STEPS_PER_INCH);
-            }
-            feedMotorHomingSubStep = 1;
-            break;
-            
-        case 1: // Wait for movement to complete
-            if (feedMotor && !feedMotor->isRunning()) {
-                feedMotorHomingSubStep = 2;
-            }
-            break;
-            
-        case 2: // Movement complete - transition to final step
+    for (;;) {
+        // 3-attempt verification - each attempt waits for the switch to settle without blocking the loop
+        for (cutHomeVerificationAttempt = 0; cutHomeVerificationAttempt < CUT_HOME_VERIFICATION_ATTEMPTS; cutHomeVerificationAttempt++) {
+            SEQ_AWAIT_MS(SENSOR_STABILIZATION_DELAY_MS);
+            getCutHomingSwitch()->update();
+            if (getCutHomingSwitch()->read() == HIGH) break;
+        }
+        sensorDetectedHome = (cutHomeVerificationAttempt < CUT_HOME_VERIFICATION_ATTEMPTS);
+        if (sensorDetectedHome) break;
+
+        // Home not verified - the blade may not be clear after all, hold the early feed move
+        if (feedTravelStartedEarly && !feedTravelHeld) {
+            if (feedMotor) feedMotor->stopMove();
+            feedTravelHeld = true;
+            logMessage("Cut home not verified - feed move to travel stopped until it is");
+        }
+
+        // Home switch not detected - try incremental move recovery
+        extern const float CUT_MOTOR_INCREMENTAL_MOVE_INCHES;
+        extern const float CUT_MOTOR_MAX_INCREMENTAL_MOVE_INCHES;
+        extern const float CUT_MOTOR_STEPS_PER_INCH;
+        
+        if (cutMotorIncrementalMoveTotalInches >= CUT_MOTOR_MAX_INCREMENTAL_MOVE_INCHES) {
+            // Max incremental moves exceeded - transition to error
+            logMessage("ERROR: Cut motor position switch did not detect home after MAX incremental moves!");
+            if (cutMotor) cutMotor->forceStop();
+            if (feedMotor) feedMotor->forceStop();
             extend2x4SecureClamp();
-            returningYes2x4SubStep = 4; // Move to final completion step
-            break;
+            turnRedLedOn();
+            turnYellowLedOff();
+            changeState(ERROR);
+            setErrorStartTime(nowUs());
+            resetReturningYes2x4Steps();
+            SEQ_EXIT();
+        }
+
+        logMessage("Attempting incremental move. Total moved: %.2f inches.", cutMotorIncrementalMoveTotalInches);
+        if (cutMotor) {
+            cutMotor->move(-CUT_MOTOR_INCREMENTAL_MOVE_INCHES * CUT_MOTOR_STEPS_PER_INCH);
+            cutMotorIncrementalMoveTotalInches += CUT_MOTOR_INCREMENTAL_MOVE_INCHES;
+        }
+        // Re-check the sensor once the move is done
+        SEQ_AWAIT_STEP(motorIdle(cutMotor), "cut incremental move", SEQUENCE_AWAIT_WATCHDOG_MS);
+    }
+
+    //! ************************************************************************
+    //! STEP 4: HOMING VERIFIED - RECORD THE DRIFT, SET POSITION TO 0 AND PROCEED WITH FEED WOOD MOVEMENT
+    //! ************************************************************************
+    if (cutMotor) {
+        // The stop re-zeroed at the switch and kept where it tripped; without one the
+        // axis is still counting from the last zero
+        long homePosition;
+        bool polled;
+        if (takeCutHomeStop(homePosition, polled)) {
+            recordCutHomeDrift(homePosition, polled);
+        } else {
+            recordCutHomeDrift(cutMotor->getCurrentPosition(), true);
+        }
+        cutMotor->setCurrentPosition(0);
     }
+    cutMotorIncrementalMoveTotalInches = 0.0; // Reset on success
+    
+    if (!feedTravelStartedEarly || feedTravelHeld) {
+        // Not started at blade clear, or stopped while home was unverified - moveTo resumes it
+        SEQ_AWAIT_STEP(motorIdle(feedMotor), "feed hold stop", SEQUENCE_AWAIT_WATCHDOG_MS);
+        startFeedToTravel();
+    }
+    SEQ_AWAIT_STEP(motorIdle(feedMotor), "feed to travel", SEQUENCE_AWAIT_WATCHDOG_MS);
+    extend2x4SecureClamp();
+
+    //! ************************************************************************
+    //! STEP 5: SEQUENCE COMPLETE - CHECK FOR CONTINUOUS OPERATION OR RETURN TO IDLE
+    //! ************************************************************************
+    turnYellowLedOff();
+    setCuttingCycleInProgress(false);
+    
+    // Reset consecutive yeswood counter only when it reaches 3
+    if (getConsecutiveYeswoodCount() >= 3) {
+        resetConsecutiveYeswoodCount();
+    }
+    
+    // Drift past the re-home limit - the cut position is not trusted for another cycle
+    if (takeCutHomeRehomeRequest()) {
+        logMessage("Cut home drift past the re-home limit - homing before the next cycle");
+        changeState(HOMING);
+        SEQ_EXIT();
+    }
+
+    // Check for continuous operation mode
+    if (getStartCycleSwitch()->read() == HIGH && getStartSwitchSafe()) {
+        extendFeedClamp();
+        configureCutMotorForCutting();
+        turnYellowLedOn();
+        setCuttingCycleInProgress(true);
+        changeState(CUTTING);
+    } else {
+        changeState(IDLE);
+    }
+
+    SEQ_END;
 }
 
 //* ************************************************************************
@@ -270,10 +256,10 @@ void handleFeedWoodMovement() {
 //* ************************************************************************
 
 void resetReturningYes2x4Steps() {
-    returningYes2x4SubStep = 0;
-    feedMotorReturnSubStep = 0;
-    cutMotorHomingAttemptStartTime = 0;
-    cutMotorHomingAttemptInProgress = false;
+    resetSequence(returningYes2x4Sequence);
     cutMotorIncrementalMoveTotalInches = 0.0;
-    feedMotorHomingSubStep = 0;
-} 
\ No newline at end of file
+    cutHomeVerificationAttempt = 0;
+    feedTravelStartedEarly = false;
+    feedTravelHeld = false;
+    disarmCutHomeStop();
+}
@@ -1,6 +1,8 @@
 #include "StateMachine/07_FEED_WOOD_FWD_ONE.h"
 #include "StateMachine/StateManager.h"
 #include "StateMachine/FUNCTIONS/General_Functions.h"
+#include "StateMachine/FUNCTIONS/Sequence.h"
+#include "StateMachine/FUNCTIONS/Motion_Table.h"
 
 //* ************************************************************************
 //* ********************* FEED WOOD FWD ONE STATE **************************
@@ -8,125 +10,80 @@
 // Handles the feed wood forward one sequence when fix position switch is pressed
 // in idle state AND 2x4 sensor reads LOW.
 
-//! ************************************************************************
-//! STEP 1: RETRACT FEED CLAMP
-//! ************************************************************************
+// Timing constants for this state
+const unsigned long FEED_WOOD_FWD_ONE_CLAMP_DELAY_MS = 200; // Delay after extending feed clamp and retracting secure clamp
 
-//! ************************************************************************
-//! STEP 2: MOVE POSITION MOTOR TO ZERO
-//! ************************************************************************
-
-//! ************************************************************************
-//! STEP 3: EXTEND FEED CLAMP AND RETRACT SECURE WOOD CLAMP
-//! ************************************************************************
-
-//! ************************************************************************
-//! STEP 4: WAIT 200MS
-//! ************************************************************************
-
-//! ************************************************************************
-//! STEP 5: MOVE TO TRAVEL DISTANCE
-//! ************************************************************************
-
-//! ************************************************************************
-//! STEP 6: CHECK START CYCLE SWITCH AND TRANSITION TO APPROPRIATE STATE
-//! ************************************************************************
+//* ************************************************************************
+//* ********************* FEED WOOD FWD ONE MOTION *************************
+//* ************************************************************************
+constexpr MotionStep FEED_WOOD_FWD_ONE_STEPS[] = {
+    //! STEP 1: RETRACT FEED CLAMP
+    motionClamp(MOTION_CLAMP_FEED, false),
+    //! STEP 2: MOVE POSITION MOTOR TO ZERO
+    motionWaitMotorIdle(MOTION_MOTOR_FEED),
+    motionMoveFeedTo(0.0f),
+    //! STEP 3: EXTEND FEED CLAMP AND RETRACT SECURE WOOD CLAMP
+    motionWaitMotorIdle(MOTION_MOTOR_FEED),
+    motionClamp(MOTION_CLAMP_FEED, true),
+    motionClamp(MOTION_CLAMP_2X4_SECURE, false),
+    //! STEP 4: WAIT 200MS
+    motionWaitMs(FEED_WOOD_FWD_ONE_CLAMP_DELAY_MS),
+    //! STEP 5: MOVE TO TRAVEL DISTANCE
+    motionMoveFeedToTravel(),
+    motionWaitMotorIdle(MOTION_MOTOR_FEED),
+    motionEnd()
+};
+static_assert(sizeof(FEED_WOOD_FWD_ONE_STEPS) / sizeof(FEED_WOOD_FWD_ONE_STEPS[0]) <= MOTION_TABLE_MAX_STEPS, "Table must fit a console load slot");
 
-// Static variables for feed wood fwd one state tracking
-enum FeedWoodFwdOneStep {
-    RETRACT_FEED_CLAMP,
-    MOVE_POSITION_MOTOR_TO_ZERO,
-    EXTEND_FEED_CLAMP_RETRACT_SECURE,
-    WAIT_200MS,
-    MOVE_TO_TRAVEL_DISTANCE,
-    CHECK_START_CYCLE_SWITCH
+extern const MotionTable FEED_WOOD_FWD_ONE_MOTION_TABLE = {
+    "feed_wood_fwd_one", FEED_WOOD_FWD_ONE_STEPS, sizeof(FEED_WOOD_FWD_ONE_STEPS) / sizeof(FEED_WOOD_FWD_ONE_STEPS[0])
 };
 
-static FeedWoodFwdOneStep currentStep = RETRACT_FEED_CLAMP;
-static unsigned long stepStartTime = 0;
+// Sequence state for feed wood fwd one
+static Sequence feedWoodFwdOneSequence;
+static MotionRunner feedWoodFwdOneMotion;
 
 void executeFeedWoodFwdOneState() {
     executeFeedWoodFwdOneStep();
 }
 
 void onEnterFeedWoodFwdOneState() {
-    currentStep = RETRACT_FEED_CLAMP;
-    stepStartTime = 0;
+    resetSequence(feedWoodFwdOneSequence);
     //serial.println("FeedWoodFwdOne: Starting feed wood forward one sequence");
 }
 
 void onExitFeedWoodFwdOneState() {
-    currentStep = RETRACT_FEED_CLAMP;
-    stepStartTime = 0;
+    resetSequence(feedWoodFwdOneSequence);
+    stopMotionTable(feedWoodFwdOneMotion);
     //serial.println("FeedWoodFwdOne: Feed clamp retracted");
 }
 
 void executeFeedWoodFwdOneStep() {
-    FastAccelStepper* feedMotor = getFeedMotor();
-    extern const float FEED_TRAVEL_DISTANCE;
-
-    switch (currentStep) {
-        case RETRACT_FEED_CLAMP:
-            retractFeedClamp();
-            //serial.println("FeedWoodFwdOne: Feed clamp retracted");
-            advanceToNextFeedWoodFwdOneStep();
-            break;
-
-        case MOVE_POSITION_MOTOR_TO_ZERO:
-            if (feedMotor && !feedMotor->isRunning()) {
-                moveFeedMotorToHome();
-                //serial.println("FeedWoodFwdOne: Moving feed motor to 0");
-                advanceToNextFeedWoodFwdOneStep();
-            }
-            break;
-
-        case EXTEND_FEED_CLAMP_RETRACT_SECURE:
-            if (feedMotor && !feedMotor->isRunning()) {
-                extendFeedClamp();
-                retract2x4SecureClamp();
-                //serial.println("FeedWoodFwdOne: Feed clamp extended, secure 2x4 clamp retracted");
-                stepStartTime = millis();
-                advanceToNextFeedWoodFwdOneStep();
-            }
-            break;
-
-        case WAIT_200MS:
-            if (millis() - stepStartTime >= 200) {
-                //serial.println("FeedWoodFwdOne: Waiting 200ms");
-                advanceToNextFeedWoodFwdOneStep();
-            }
-            break;
-
-        case MOVE_TO_TRAVEL_DISTANCE:
-            if (feedMotor && !feedMotor->isRunning()) {
-                moveFeedMotorToPosition(FEED_TRAVEL_DISTANCE);
-                //serial.println("FeedWoodFwdOne: Moving feed motor to travel distance");
-                advanceToNextFeedWoodFwdOneStep();
-            }
-            break;
+    runFeedWoodFwdOneSequence();
+}
 
-        case CHECK_START_CYCLE_SWITCH:
-            if (feedMotor && !feedMotor->isRunning()) {
-                //serial.println("FeedWoodFwdOne: Checking start cycle switch for next state");
-                
-                // Check the start cycle switch state
-                if (getStartCycleSwitch()->read() == HIGH) {
-                    //serial.println("FeedWoodFwdOne: Start cycle switch HIGH - transitioning to CUTTING state");
-                    changeState(CUTTING);
-                    setCuttingCycleInProgress(true);
-                    configureCutMotorForCutting();
-                    turnYellowLedOn();
-                    extendFeedClamp();
-                } else {
-                    //serial.println("FeedWoodFwdOne: Start cycle switch LOW - transitioning to IDLE state");
-                    changeState(IDLE);
-                }
-            }
-            break;
+SequenceStatus runFeedWoodFwdOneSequence() {
+    SEQ_BEGIN(feedWoodFwdOneSequence);
+
+    //! STEPS 1-5: FEED MOVES FROM THE MOTION TABLE
+    startMotionTable(feedWoodFwdOneMotion, MOTION_TABLE_FEED_WOOD_FWD_ONE);
+    SEQ_AWAIT(runMotionTable(feedWoodFwdOneMotion) == SEQUENCE_DONE);
+
+    //! STEP 6: CHECK START CYCLE SWITCH AND TRANSITION TO APPROPRIATE STATE
+    //serial.println("FeedWoodFwdOne: Checking start cycle switch for next state");
+    
+    // Check the start cycle switch state (a stop command during the feed ends in IDLE)
+    if (getStartCycleSwitch()->read() == HIGH && !getCycleStopRequested()) {
+        //serial.println("FeedWoodFwdOne: Start cycle switch HIGH - transitioning to CUTTING state");
+        changeState(CUTTING);
+        setCuttingCycleInProgress(true);
+        configureCutMotorForCutting();
+        turnYellowLedOn();
+        extendFeedClamp();
+    } else {
+        //serial.println("FeedWoodFwdOne: Start cycle switch LOW - transitioning to IDLE state");
+        changeState(IDLE);
     }
-}
 
-void advanceToNextFeedWoodFwdOneStep() {
-    currentStep = static_cast<FeedWoodFwdOneStep>(static_cast<int>(currentStep) + 1);
-    stepStartTime = 0; // Reset step timer
-} 
\ No newline at end of file
+    SEQ_END;
+}
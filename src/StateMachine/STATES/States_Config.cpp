@@ -20,7 +20,7 @@ const int ROTATION_SERVO_ACTIVE_POSITION = 90;   // Position when activated (deg
 const float CUT_MOTOR_STEPS_PER_INCH = 500.0;  // 4x increase from 38
 const float FEED_MOTOR_STEPS_PER_INCH = 1000.0; // Steps per inch for feed motor
 const float CUT_TRAVEL_DISTANCE = 9.1; // inches
-const float FEED_TRAVEL_DISTANCE = 3.4; // inches (3.4 for 3 inch squares and 3.25 for 2.65 inch squares)
+const float FEED_TRAVEL_DISTANCE = 3.4; // inches - homing frame; the cycle uses the active material recipe (Config/Material_Recipes.h)
 const float CUT_MOTOR_INCREMENTAL_MOVE_INCHES = 0.1; // Inches for incremental reverse
 const float CUT_MOTOR_MAX_INCREMENTAL_MOVE_INCHES = 0.4; // Max inches for incremental reverse before error
 
@@ -35,11 +35,30 @@ const int FEED_HOMING_DIRECTION = 1;
 const float CUT_MOTOR_NORMAL_SPEED = 650;      // Speed for the cutting pass (steps/sec)
 const float CUT_MOTOR_NORMAL_ACCELERATION = 17000; // Acceleration for the cutting pass (steps/sec^2)
 
+// Zoned cut stroke (Cutting State) - blade in air before contact and after clear
+const float CUT_MOTOR_APPROACH_SPEED = 4000;    // Rapid approach up to the recipe's blade contact position (steps/sec)
+const float CUT_MOTOR_EXIT_SPEED = 4000;        // Exit after the recipe's blade clear position (steps/sec)
+
 // Return Stroke (Returning State / End of Cutting State)
 const float CUT_MOTOR_RETURN_SPEED = 25000;     // Speed for returning after a cut (steps/sec)
 
 // Homing Operation (Homing State)
-const float CUT_MOTOR_HOMING_SPEED = 1500;      // Speed for homing the cut motor (steps/sec)
+// Homing (StateMachine/FUNCTIONS/Homing.h): fast approach to the switch, ramp down
+// past it at the axis's normal acceleration. With HOMING_ISR_LATCH the switch's
+// edge interrupt latches the zero; a switch found by polling instead (no latch, or
+// already made at the start) is backed off and re-latched slowly to set the zero.
+// No path stops dead at the approach speed.
+// v^2/2a at the homing speed plus the detection delay must fit in the overtravel
+// (cut 4000 steps/s at 17000 steps/s^2 ~ 0.94 in, feed 6000 at 22000 ~ 0.82 in);
+// a shorter overtravel lowers the approach speed to match.
+// The overtravel figures are computed from those numbers, NOT measured: check the
+// free travel past each home input on the machine before running these speeds,
+// and set the constant to what the mechanism actually allows.
+const bool HOMING_ISR_LATCH = true;             // Zero from the edge-latched position (both axes)
+const float CUT_MOTOR_HOMING_SPEED = 4000;      // Fast approach to the home switch (steps/sec)
+const float CUT_MOTOR_HOMING_LATCH_SPEED = 500; // Slow re-latch after the back-off (steps/sec)
+const float CUT_MOTOR_HOMING_BACKOFF_INCHES = 0.25; // Back-off from the switch before the latch
+const float CUT_MOTOR_HOMING_OVERTRAVEL_INCHES = 1.0; // Travel allowed past the trip point - computed, confirm on the machine
 
 //* ************************************************************************
 //* ************************ FEED MOTOR SPEED SETTINGS *******************
@@ -54,7 +73,32 @@ const float FEED_MOTOR_RETURN_ACCELERATION =
  30000; // Acceleration for return moves (steps/sec^2)
 
 // Homing Operation (Homing State)
-const float FEED_MOTOR_HOMING_SPEED = 2000;     // Speed for homing the feed motor (steps/sec)
+const float FEED_MOTOR_HOMING_SPEED = 6000;     // Fast approach to the home sensor (steps/sec)
+const float FEED_MOTOR_HOMING_LATCH_SPEED = 1000; // Slow re-latch after the back-off (steps/sec)
+const float FEED_MOTOR_HOMING_BACKOFF_INCHES = 0.25; // Back-off from the sensor before the latch
+const float FEED_MOTOR_HOMING_OVERTRAVEL_INCHES = 0.9; // Travel allowed past the trip point - computed, confirm on the machine
+
+//* ************************************************************************
+//* ************************ MOTION PROFILES ******************************
+//* ************************************************************************
+// S-curve moves ramp the acceleration up over the first LINEAR_ACCELERATION_STEPS
+// (FastAccelStepper setLinearAcceleration) and back down the same way at the end,
+// instead of stepping straight to full acceleration. The jerk-limited start and
+// stop let the motors run a higher peak acceleration without missing steps.
+// Trapezoid moves use the plain acceleration above. The cut stroke itself is
+// always trapezoid - its zone and actuator lead planning assume constant acceleration.
+// Both default to trapezoid until the S-curve peaks below are validated on the
+// machine - e.g. no cut home drift (Safety/Home_Drift.h) over a production run.
+const MotionProfile CUT_RETURN_MOTION_PROFILE = MOTION_PROFILE_TRAPEZOID;
+const MotionProfile FEED_MOTION_PROFILE = MOTION_PROFILE_TRAPEZOID;
+
+const uint32_t CUT_MOTOR_LINEAR_ACCELERATION_STEPS = 150;  // 0.3 inch of jerk-limited ramp
+const uint32_t FEED_MOTOR_LINEAR_ACCELERATION_STEPS = 300; // 0.3 inch of jerk-limited ramp
+
+// Peak accelerations for S-curve moves - starting points, tune on the machine
+const float CUT_MOTOR_RETURN_S_CURVE_ACCELERATION = 22000;   // vs CUT_MOTOR_NORMAL_ACCELERATION (steps/sec^2)
+const float FEED_MOTOR_S_CURVE_ACCELERATION = 27500;         // vs FEED_MOTOR_NORMAL_ACCELERATION (steps/sec^2)
+const float FEED_MOTOR_RETURN_S_CURVE_ACCELERATION = 37500;  // vs FEED_MOTOR_RETURN_ACCELERATION (steps/sec^2)
 
 //* ************************************************************************
 //* ************************ TIMING CONFIGURATION *************************
@@ -68,20 +112,35 @@ const unsigned long ROTATION_CLAMP_EXTEND_DURATION_MS = 2250; //
 // Cut motor homing timeout
 const unsigned long CUT_HOME_TIMEOUT = 5000; // 5 seconds timeout
 
+// Feed motor homing timeout - approach, back-off and latch, from the cut home interlock
+const unsigned long FEED_HOME_TIMEOUT = 30000; // 30 seconds timeout
+
 // Transfer Arm signal timing
 const unsigned long TA_SIGNAL_DURATION = 500; // Duration for Transfer Arm signal (ms)
 
 //* ************************************************************************
 //* ************************ OPERATIONAL CONSTANTS ***********************
 //* ************************************************************************
-// Rotation clamp early activation offset
-const float ROTATION_CLAMP_EARLY_ACTIVATION_OFFSET_INCHES = 2.7; // 1.45 for 3 inch squares and 2.7 for 2.65 inch squares
+// Rotation clamp closed position, as an offset back from CUT_TRAVEL_DISTANCE - the cycle
+// uses the active material recipe (Config/Material_Recipes.h); this is the "default" recipe value
+const float ROTATION_CLAMP_CLOSED_OFFSET_INCHES = 2.6; // 1.35 for 3 inch squares and 2.6 for 2.65 inch squares
 
-// Rotation servo early activation offset
-const float ROTATION_SERVO_EARLY_ACTIVATION_OFFSET_INCHES = 0.053;
+// Blade clear on the cut return - once the cut motor is back below this position the blade
+// is out of the wood's path and RETURNING_YES_2x4 starts the next feed move while the cut
+// motor finishes homing. 0 = wait for the verified home position as before.
+const float CUT_RETURN_BLADE_CLEAR_INCHES = 0.5;
 
-// Transfer Arm signal early activation offset
-const float TA_SIGNAL_EARLY_ACTIVATION_OFFSET_INCHES = 0.01;
+// Actuator response times - from the output switching to the action being complete.
+// The cut stroke fires each actuator early enough, at the planned speed, to be done
+// where it is needed (rotation clamp at its closed position, rotation servo and TA at
+// the end of travel, feed clamp before blade contact), so speed changes need no retuning.
+// At 650 steps/s these reproduce the old fixed offsets (2.7, 0.053 and 0.01 inches):
+// planActuatorLeadSteps() gives 49, 27 and 5 steps. The servo and TA leads end in the
+// ramp down to the end of travel, where the last 5 steps alone take ~24 ms.
+const unsigned long ROTATION_CLAMP_RESPONSE_MS = 75;
+const unsigned long ROTATION_SERVO_RESPONSE_MS = 60;
+const unsigned long TA_SIGNAL_RESPONSE_MS = 23;
+const unsigned long FEED_CLAMP_RESPONSE_MS = 100;
 
 //* ************************************************************************
 //* ************************ SAFETY CONSTANTS *****************************
@@ -90,6 +149,7 @@ const float TA_SIGNAL_EARLY_ACTIVATION_OFFSET_INCHES = 0.01;
 const unsigned long ROTATION_SERVO_EXTENDED_WAIT_THRESHOLD_MS = 3000; // 3 seconds - threshold for extended wait due to failure to suction
 const unsigned long ROTATION_SERVO_SAFETY_DELAY_MS = 3000; // 2 seconds - additional safety delay before returning servo to home
 const unsigned long ROTATION_SERVO_RETURN_DELAY_MS = 150; // 150ms delay before returning servo to home regardless of suction state 
+const unsigned long ROTATION_SERVO_SUCTION_POLL_MS = 5; // Re-check interval while the servo waits for the suction sensor
 
 //* ************************************************************************
 //* ************************ MOTOR CONTROL CONSTANTS *********************
@@ -113,6 +173,3 @@ const float SUCTION_SENSOR_CHECK_DISTANCE_INCHES = 0.2; // Distance cut motor mu
 //* ************************************************************************
 // Pre-calculated step values for cutting state to avoid repeated calculations
 const long SUCTION_SENSOR_CHECK_DISTANCE_STEPS = SUCTION_SENSOR_CHECK_DISTANCE_INCHES * CUT_MOTOR_STEPS_PER_INCH;
-const long ROTATION_CLAMP_ACTIVATION_POSITION_STEPS = (CUT_TRAVEL_DISTANCE - ROTATION_CLAMP_EARLY_ACTIVATION_OFFSET_INCHES) * CUT_MOTOR_STEPS_PER_INCH;
-const long ROTATION_SERVO_ACTIVATION_POSITION_STEPS = (CUT_TRAVEL_DISTANCE - ROTATION_SERVO_EARLY_ACTIVATION_OFFSET_INCHES) * CUT_MOTOR_STEPS_PER_INCH;
-const long TA_SIGNAL_ACTIVATION_POSITION_STEPS = (CUT_TRAVEL_DISTANCE - TA_SIGNAL_EARLY_ACTIVATION_OFFSET_INCHES) * CUT_MOTOR_STEPS_PER_INCH;
\ No newline at end of file
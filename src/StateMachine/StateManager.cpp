@@ -1,11 +1,29 @@
 #include "StateMachine/StateManager.h"
 #include "StateMachine/FUNCTIONS/General_Functions.h"
 #include "StateMachine/00_STARTUP.h"
+#include "StateMachine/01_HOMING.h"
+#include "StateMachine/02_IDLE.h"
+#include "StateMachine/03_CUTTING.h"
+#include "StateMachine/04_RETURNING_Yes_2x4.h"
+#include "StateMachine/05_RETURNING_No_2x4.h"
+#include "StateMachine/07_FEED_WOOD_FWD_ONE.h"
+#include "StateMachine/08_FEED_FIRST_CUT.h"
 #include "StateMachine/STATES/States_Config.h"
 #include "ErrorStates/Errors_Functions.h"
 #include "ErrorStates/Error_Reset.h"
 #include "ErrorStates/Suction_Error.h"
 #include "ErrorStates/Cut_Motor_Error.h"
+#include "Safety/Stop_Interrupts.h"
+#include "Safety/State_Watchdog.h"
+#include "Tasks/Task_Layout.h"
+#include "Timing/Timer_Wheel.h"
+#include "Timing/Timebase.h"
+#include "Timing/Position_Triggers.h"
+#include "StateMachine/FUNCTIONS/Feed_Chain.h"
+#include "Events/Input_Events.h"
+#include "StateMachine/FUNCTIONS/Homing.h"
+#include "Tasks/Command_Ring.h"
+#include "Config/Material_Recipes.h"
 
 // External references to Bounce objects from main.cpp
 extern Bounce cutHomingSwitch;
@@ -26,35 +44,144 @@ extern bool comingFromNoWoodWithSensorsClear;
 // Global variables for state management
 static int consecutiveYeswoodCount = 0;
 static SystemState previousState = STARTUP;
+static uint32_t stateEnteredEventSequence = 0;   // Events posted before this belong to the previous state
+static bool cycleStopRequested = false;          // STOP_CYCLE received - finish the cut, then IDLE
 
-// Forward declarations for state execution functions
-void executeStartupState();
-void executeHomingState();
-void executeIdleState();
-void executeFeedFirstCutState();
-void executeFeedWoodFwdOneState();
-void executeCuttingState();
-void executeReturningYes2x4State();
-void executeReturningNo2x4State();
-
-// Forward declarations for state lifecycle functions
-void onEnterStartupState();
-void onEnterHomingState();
-void onEnterIdleState();
-void onEnterFeedFirstCutState();
-void onEnterFeedWoodFwdOneState();
-void onEnterCuttingState();
-void onEnterReturningYes2x4State();
-void onEnterReturningNo2x4State();
-
-void onExitStartupState();
-void onExitHomingState();
-void onExitIdleState();
-void onExitFeedFirstCutState();
-void onExitFeedWoodFwdOneState();
-void onExitCuttingState();
-void onExitReturningYes2x4State();
-void onExitReturningNo2x4State();
+//* ************************************************************************
+//* *************************** STATE TABLE *******************************
+//* ************************************************************************
+// One row per SystemState, in enum order: name, execute handler, onEnter/onExit hooks,
+// the states it may transition to, the input events it handles (see
+// Events/Input_Events.h), the control commands it accepts (see Tasks/Task_Layout.h)
+// and its watchdog budget (see Safety/State_Watchdog.h). Adding a state means adding its enum value
+// and its row here - the static_asserts below fail the build if a row is missing,
+// out of order or has a null handler.
+// Every state may go to ERROR (hard stop input).
+
+struct StateDefinition {
+    SystemState state;
+    const char* name;
+    void (*execute)();
+    void (*onEnter)();
+    void (*onExit)();
+    uint32_t allowedNextStates;     // Bit mask of stateBit() values
+    uint32_t handledEvents;         // Bit mask of eventBit() values
+    void (*onEvent)(const InputEvent& event);
+    uint32_t acceptedCommands;      // Bit mask of commandBit() values
+    bool (*onCommand)(const ControlCommand& command);
+    unsigned long watchdogBudgetMs; // STATE_WATCHDOG_UNBOUNDED = no limit
+};
+
+constexpr uint32_t stateBit(SystemState state) {
+    return 1UL << state;
+}
+
+// States without lifecycle work use this hook
+static void noStateHook() {}
+
+// States that still poll (handledEvents == 0) use this handler
+static void noEventHandler(const InputEvent& event) {}
+
+// States that accept no machine commands (acceptedCommands == 0) use this handler
+static bool noCommandHandler(const ControlCommand& command) { return false; }
+
+static void handleStandardErrorEvent(const InputEvent& event);
+static bool handleCycleStopCommand(const ControlCommand& command);
+
+constexpr StateDefinition STATE_TABLE[] = {
+    { STARTUP, "STARTUP",
+      executeStartupState, onEnterStartupState, onExitStartupState,
+      stateBit(HOMING) | stateBit(ERROR),
+      0, noEventHandler,
+      0, noCommandHandler,
+      STARTUP_WATCHDOG_MS },
+    { HOMING, "HOMING",
+      executeHomingState, onEnterHomingState, onExitHomingState,
+      stateBit(IDLE) | stateBit(ERROR),
+      eventBit(EVENT_HOMING_DONE) | eventBit(EVENT_HOMING_FAILED), handleHomingEvent,
+      0, noCommandHandler,
+      HOMING_WATCHDOG_MS },
+    { IDLE, "IDLE",
+      executeIdleState, onEnterIdleState, onExitIdleState,
+      stateBit(FEED_FIRST_CUT) | stateBit(FEED_WOOD_FWD_ONE) | stateBit(CUTTING) | stateBit(ERROR),
+      eventBit(EVENT_PUSHWOOD_PRESSED) | eventBit(EVENT_START_SWITCH_ON), handleIdleEvent,
+      commandBit(CONTROL_CMD_START_CYCLE) | commandBit(CONTROL_CMD_SELECT_RECIPE), handleIdleCommand,
+      STATE_WATCHDOG_UNBOUNDED },
+    { CUTTING, "CUTTING",
+      executeCuttingState, onEnterCuttingState, onExitCuttingState,
+      stateBit(RETURNING_YES_2x4) | stateBit(RETURNING_NO_2x4) | stateBit(SUCTION_ERROR) |
+      stateBit(ERROR_RESET) | stateBit(ERROR),
+      0, noEventHandler,
+      commandBit(CONTROL_CMD_STOP_CYCLE), handleCycleStopCommand,
+      CUTTING_WATCHDOG_MS },
+    { ERROR, "ERROR",
+      handleStandardErrorState, noStateHook, noStateHook,
+      stateBit(ERROR_RESET),
+      eventBit(EVENT_RELOAD_SWITCH_ON), handleStandardErrorEvent,
+      0, noCommandHandler,
+      STATE_WATCHDOG_UNBOUNDED },
+    { ERROR_RESET, "ERROR_RESET",
+      handleErrorResetState, noStateHook, noStateHook,
+      stateBit(HOMING) | stateBit(ERROR),
+      0, noEventHandler,
+      0, noCommandHandler,
+      ERROR_RESET_WATCHDOG_MS },
+    { SUCTION_ERROR, "SUCTION_ERROR",
+      handleSuctionErrorState, noStateHook, noStateHook,
+      stateBit(HOMING) | stateBit(ERROR),
+      eventBit(EVENT_START_SWITCH_ON) | eventBit(EVENT_HOMING_DONE) | eventBit(EVENT_HOMING_FAILED),
+      handleSuctionErrorEvent,
+      0, noCommandHandler,
+      STATE_WATCHDOG_UNBOUNDED },
+    { Cut_Motor_Homing_Error, "Cut_Motor_Homing_Error",
+      handleCutMotorErrorState, noStateHook, noStateHook,
+      stateBit(ERROR_RESET) | stateBit(ERROR),
+      0, noEventHandler,
+      0, noCommandHandler,
+      STATE_WATCHDOG_UNBOUNDED },
+    { RETURNING_YES_2x4, "RETURNING_YES_2x4",
+      executeReturningYes2x4State, onEnterReturningYes2x4State, onExitReturningYes2x4State,
+      stateBit(CUTTING) | stateBit(IDLE) | stateBit(HOMING) | stateBit(ERROR),
+      0, noEventHandler,
+      commandBit(CONTROL_CMD_STOP_CYCLE), handleCycleStopCommand,
+      RETURNING_WATCHDOG_MS },
+    { RETURNING_NO_2x4, "RETURNING_NO_2x4",
+      executeReturningNo2x4State, onEnterReturningNo2x4State, onExitReturningNo2x4State,
+      stateBit(IDLE) | stateBit(ERROR),
+      0, noEventHandler,
+      commandBit(CONTROL_CMD_STOP_CYCLE), handleCycleStopCommand,
+      RETURNING_WATCHDOG_MS },
+    { FEED_FIRST_CUT, "FEED_FIRST_CUT",
+      executeFeedFirstCutState, onEnterFeedFirstCutState, onExitFeedFirstCutState,
+      stateBit(CUTTING) | stateBit(IDLE) | stateBit(ERROR),
+      0, noEventHandler,
+      commandBit(CONTROL_CMD_STOP_CYCLE), handleCycleStopCommand,
+      FEED_WATCHDOG_MS },
+    { FEED_WOOD_FWD_ONE, "FEED_WOOD_FWD_ONE",
+      executeFeedWoodFwdOneState, onEnterFeedWoodFwdOneState, onExitFeedWoodFwdOneState,
+      stateBit(CUTTING) | stateBit(IDLE) | stateBit(ERROR),
+      0, noEventHandler,
+      commandBit(CONTROL_CMD_STOP_CYCLE), handleCycleStopCommand,
+      FEED_WATCHDOG_MS },
+};
+
+constexpr bool stateTableIsComplete(int index) {
+    return index >= SYSTEM_STATE_COUNT ||
+           (STATE_TABLE[index].state == index &&
+            STATE_TABLE[index].execute != nullptr &&
+            STATE_TABLE[index].onEnter != nullptr &&
+            STATE_TABLE[index].onExit != nullptr &&
+            STATE_TABLE[index].onEvent != nullptr &&
+            STATE_TABLE[index].onCommand != nullptr &&
+            stateTableIsComplete(index + 1));
+}
+
+static_assert(SYSTEM_STATE_COUNT <= 32, "allowedNextStates is a 32-bit mask");
+static_assert(CONTROL_CMD_COUNT <= 32, "acceptedCommands is a 32-bit mask");
+static_assert(sizeof(STATE_TABLE) / sizeof(STATE_TABLE[0]) == SYSTEM_STATE_COUNT,
+              "STATE_TABLE needs exactly one row per SystemState");
+static_assert(stateTableIsComplete(0),
+              "STATE_TABLE rows must be in SystemState order with every handler set");
 
 void executeStateMachine() {
     handleCommonOperations();
@@ -64,78 +191,27 @@ void executeStateMachine() {
         handleErrorLedBlink();
     }
     
-    switch (currentState) {
-        case STARTUP:
-            executeStartupState();
-            break;
-        case HOMING:
-            executeHomingState();
-            break;
-        case IDLE:
-            executeIdleState();
-            break;
-        case FEED_FIRST_CUT:
-            executeFeedFirstCutState();
-            break;
-        case FEED_WOOD_FWD_ONE:
-            executeFeedWoodFwdOneState();
-            break;
-        case CUTTING:
-            executeCuttingState();
-            break;
-        case RETURNING_YES_2x4:
-            executeReturningYes2x4State();
-            break;
-        case RETURNING_NO_2x4:
-            executeReturningNo2x4State();
-            break;
-        case ERROR:
-            handleStandardErrorState();
-            break;
-        case ERROR_RESET:
-            handleErrorResetState();
-            break;
-        case SUCTION_ERROR:
-            handleSuctionErrorState();
-            break;
-        case Cut_Motor_Homing_Error:
-            handleCutMotorErrorState();
-            break;
-    }
+    STATE_TABLE[currentState].execute();
 }
 
 void changeState(SystemState newState) {
     if (currentState != newState) {
-        // Call onExit for the current state before changing
-        switch (currentState) {
-            case STARTUP: onExitStartupState(); break;
-            case HOMING: onExitHomingState(); break;
-            case IDLE: onExitIdleState(); break;
-            case FEED_FIRST_CUT: onExitFeedFirstCutState(); break;
-            case FEED_WOOD_FWD_ONE: onExitFeedWoodFwdOneState(); break;
-            case CUTTING: onExitCuttingState(); break;
-            case RETURNING_YES_2x4: onExitReturningYes2x4State(); break;
-            case RETURNING_NO_2x4: onExitReturningNo2x4State(); break;
-            // Error states don't have onExit handlers
-            default: break;
+#ifdef STATE_TRANSITION_CHECKS
+        // Debug builds only: refuse transitions that are not in the state table
+        if (!(STATE_TABLE[currentState].allowedNextStates & stateBit(newState))) {
+            logMessage("REJECTED state transition %s -> %s (not in STATE_TABLE)",
+                       STATE_TABLE[currentState].name, STATE_TABLE[newState].name);
+            return;
         }
+#endif
+        STATE_TABLE[currentState].onExit();
         
         previousState = currentState;
         currentState = newState;
+        stateEnteredEventSequence = getNextInputEventSequence();
+        startStateWatchdog(newState, STATE_TABLE[newState].watchdogBudgetMs);
         
-        // Call onEnter for the new state after changing
-        switch (newState) {
-            case STARTUP: onEnterStartupState(); break;
-            case HOMING: onEnterHomingState(); break;
-            case IDLE: onEnterIdleState(); break;
-            case FEED_FIRST_CUT: onEnterFeedFirstCutState(); break;
-            case FEED_WOOD_FWD_ONE: onEnterFeedWoodFwdOneState(); break;
-            case CUTTING: onEnterCuttingState(); break;
-            case RETURNING_YES_2x4: onEnterReturningYes2x4State(); break;
-            case RETURNING_NO_2x4: onEnterReturningNo2x4State(); break;
-            // Error states don't have onEnter handlers
-            default: break;
-        }
+        STATE_TABLE[newState].onEnter();
     }
 }
 
@@ -248,27 +324,27 @@ void setComingFromNoWoodWithSensorsClear(bool value) {
     comingFromNoWoodWithSensorsClear = value;
 }
 
-unsigned long getLastBlinkTime() {
+uint64_t getLastBlinkTime() {
     return lastBlinkTime;
 }
 
-void setLastBlinkTime(unsigned long value) {
+void setLastBlinkTime(uint64_t value) {
     lastBlinkTime = value;
 }
 
-unsigned long getLastErrorBlinkTime() {
+uint64_t getLastErrorBlinkTime() {
     return lastErrorBlinkTime;
 }
 
-void setLastErrorBlinkTime(unsigned long value) {
+void setLastErrorBlinkTime(uint64_t value) {
     lastErrorBlinkTime = value;
 }
 
-unsigned long getErrorStartTime() {
+uint64_t getErrorStartTime() {
     return errorStartTime;
 }
 
-void setErrorStartTime(unsigned long value) {
+void setErrorStartTime(uint64_t value) {
     errorStartTime = value;
 }
 
@@ -288,11 +364,11 @@ void setErrorBlinkState(bool value) {
     errorBlinkState = value;
 }
 
-unsigned long getRotationServoActiveStartTime() {
+uint64_t getRotationServoActiveStartTime() {
     return rotationServoActiveStartTime;
 }
 
-void setRotationServoActiveStartTime(unsigned long value) {
+void setRotationServoActiveStartTime(uint64_t value) {
     rotationServoActiveStartTime = value;
 }
 
@@ -314,32 +390,32 @@ void setRotationServoSafetyDelayActive(bool value) {
     rotationServoSafetyDelayActive = value;
 }
 
-unsigned long getRotationServoSafetyDelayStartTime() {
-    extern unsigned long rotationServoSafetyDelayStartTime; // From main.cpp
+uint64_t getRotationServoSafetyDelayStartTime() {
+    extern uint64_t rotationServoSafetyDelayStartTime; // From main.cpp
     return rotationServoSafetyDelayStartTime;
 }
 
-void setRotationServoSafetyDelayStartTime(unsigned long value) {
-    extern unsigned long rotationServoSafetyDelayStartTime; // From main.cpp
+void setRotationServoSafetyDelayStartTime(uint64_t value) {
+    extern uint64_t rotationServoSafetyDelayStartTime; // From main.cpp
     rotationServoSafetyDelayStartTime = value;
 }
 
 // Rotation servo return delay timing functions
-unsigned long getRotationServoReturnDelayStartTime() {
-    extern unsigned long rotationServoReturnDelayStartTime; // From main.cpp
+uint64_t getRotationServoReturnDelayStartTime() {
+    extern uint64_t rotationServoReturnDelayStartTime; // From main.cpp
     return rotationServoReturnDelayStartTime;
 }
 
-void setRotationServoReturnDelayStartTime(unsigned long value) {
-    extern unsigned long rotationServoReturnDelayStartTime; // From main.cpp
+void setRotationServoReturnDelayStartTime(uint64_t value) {
+    extern uint64_t rotationServoReturnDelayStartTime; // From main.cpp
     rotationServoReturnDelayStartTime = value;
 }
 
-unsigned long getRotationClampExtendTime() {
+uint64_t getRotationClampExtendTime() {
     return rotationClampExtendTime;
 }
 
-void setRotationClampExtendTime(unsigned long value) {
+void setRotationClampExtendTime(uint64_t value) {
     rotationClampExtendTime = value;
 }
 
@@ -351,11 +427,11 @@ void setRotationClampIsExtended(bool value) {
     rotationClampIsExtended = value;
 }
 
-unsigned long getSignalTAStartTime() {
+uint64_t getSignalTAStartTime() {
     return signalTAStartTime;
 }
 
-void setSignalTAStartTime(unsigned long value) {
+void setSignalTAStartTime(uint64_t value) {
     signalTAStartTime = value;
 }
 
@@ -379,10 +455,28 @@ void resetConsecutiveYeswoodCount() {
     consecutiveYeswoodCount = 0;
 }
 
+bool getCycleStopRequested() {
+    return cycleStopRequested;
+}
+
+void setCycleStopRequested(bool value) {
+    cycleStopRequested = value;
+}
+
 //* ************************************************************************
 //* ************************* UTILITY FUNCTIONS ****************************
 //* ************************************************************************
 
+const char* getStateName(SystemState state) {
+    if (state < 0 || state >= SYSTEM_STATE_COUNT) return "UNKNOWN";
+    return STATE_TABLE[state].name;
+}
+
+unsigned long getStateWatchdogBudget(SystemState state) {
+    if (state < 0 || state >= SYSTEM_STATE_COUNT) return STATE_WATCHDOG_UNBOUNDED;
+    return STATE_TABLE[state].watchdogBudgetMs;
+}
+
 void printStateChange() {
     if (currentState != previousState) {
         // Serial.print("Current State: ");
@@ -413,120 +507,118 @@ void updateSwitches() {
     startCycleSwitch.update();
     pushwoodForwardSwitch.update();
     suctionSensorBounce.update();
+
+    // Turn the new edges into events before anything reads them
+    pollInputEvents();
+}
+
+// Hand every queued event to the current state if its STATE_TABLE row lists it.
+// A handler may change state; the rest of the batch was posted before the new
+// state was entered, so it is recorded but not delivered.
+static void dispatchInputEvents() {
+    beginInputEventPass();
+
+    InputEvent event;
+    while (popInputEvent(event)) {
+        // Start switch OFF arms the start switch safety in every state
+        if (event.type == EVENT_START_SWITCH_OFF && !startSwitchSafe) {
+            startSwitchSafe = true;
+        }
+
+        const StateDefinition& state = STATE_TABLE[currentState];
+        bool handled = (state.handledEvents & eventBit(event.type)) &&
+                       (int32_t)(event.sequence - stateEnteredEventSequence) >= 0;
+        recordDispatchedInputEvent(event, currentState, handled);
+        if (handled) state.onEvent(event);
+    }
+}
+
+bool dispatchControlCommand(const ControlCommand& command) {
+    const StateDefinition& state = STATE_TABLE[currentState];
+    if (!(state.acceptedCommands & commandBit(command.type))) {
+        logMessage("Command %s rejected in state %s", getControlCommandName(command.type), state.name);
+        return false;
+    }
+    return state.onCommand(command);
+}
+
+void logMachineStatus() {
+    float cutInches = cutMotor ? (float)cutMotor->getCurrentPosition() / CUT_MOTOR_STEPS_PER_INCH : 0.0f;
+    float feedInches = feedMotor ? (float)feedMotor->getCurrentPosition() / FEED_MOTOR_STEPS_PER_INCH : 0.0f;
+    logMessage("Status: %s, recipe %s, cycle %s, continuous %s, reload %s, stop %s, cut %.2f in, feed %.2f in",
+               getStateName(currentState), getActiveRecipe().name,
+               cuttingCycleInProgress ? "ON" : "OFF", continuousModeActive ? "ON" : "OFF",
+               isReloadMode ? "ON" : "OFF", cycleStopRequested ? "PENDING" : "NO",
+               cutInches, feedInches);
 }
 
 void handleCommonOperations() {
     // Update all switches first
     updateSwitches();
     
-    // Check for cut motor hitting home sensor during RETURNING_YES_2x4 return
-    extern bool cutMotorInReturningYes2x4Return; // This global flag is still in main.cpp
-    if (cutMotorInReturningYes2x4Return && cutMotor && cutMotor->isRunning() && cutHomingSwitch.read() == HIGH) {
-        //serial.println("Cut motor hit homing sensor during RETURNING_YES_2x4 return - stopping immediately!");
-        cutMotor->forceStopAndNewPosition(0);  // Stop immediately and set position to 0
+    // Hard stop input - the ISR has already stopped both motors, park the state machine in ERROR
+    if (consumeHardStopEvent()) {
+        cancelFeedChain();
+        // A chain callback may have issued a move after the ISR stopped the motors
+        if (cutMotor) cutMotor->forceStopAndNewPosition(cutMotor->getCurrentPosition());
+        if (feedMotor) feedMotor->forceStopAndNewPosition(feedMotor->getCurrentPosition());
+        abortHoming();
+        logMessage("HARD STOP input activated in state %s - motors stopped", getStateName(currentState));
+        changeState(ERROR);
     }
-    // Handle rotation servo return with safety delay logic
-    if (rotationServoIsActiveAndTiming && millis() - rotationServoActiveStartTime >= ROTATION_SERVO_ACTIVE_HOLD_DURATION_MS) {
-        extern const int WOOD_SUCTION_CONFIRM_SENSOR; // This is in main.cpp
-        
-        // Check if suction sensor reads HIGH (wood is properly grabbed by transfer arm)
-        // Using debounced reading with 15ms debounce time
-        if (suctionSensorBounce.read() == HIGH) {
-            // Check if we've been waiting for more than 3 seconds due to failure to suction
-            if (millis() - rotationServoActiveStartTime >= ROTATION_SERVO_EXTENDED_WAIT_THRESHOLD_MS) {
-                // We've been waiting for extended time due to failure to suction - apply safety delay
-                extern bool rotationServoSafetyDelayActive; // From main.cpp
-                extern unsigned long rotationServoSafetyDelayStartTime; // From main.cpp
-                if (!rotationServoSafetyDelayActive) {
-                    // Start the safety delay period
-                    rotationServoSafetyDelayActive = true;
-                    rotationServoSafetyDelayStartTime = millis();
-                    //serial.println("Servo was waiting for extended time due to failure to suction. Starting 2-second safety delay before returning to home.");
-                } else if (millis() - rotationServoSafetyDelayStartTime >= ROTATION_SERVO_SAFETY_DELAY_MS) {
-                    // Safety delay complete - now start return delay
-                    extern bool rotationServoReturnDelayActive; // From main.cpp
-                    extern unsigned long rotationServoReturnDelayStartTime; // From main.cpp
-                    if (!rotationServoReturnDelayActive) {
-                        // Start the return delay period
-                        rotationServoReturnDelayActive = true;
-                        rotationServoReturnDelayStartTime = millis();
-                        //serial.println("Safety delay complete. Starting 150ms return delay before returning servo to home.");
-                    } else if (millis() - rotationServoReturnDelayStartTime >= ROTATION_SERVO_RETURN_DELAY_MS) {
-                        // Return delay complete - now return servo to home
-                        handleRotationServoReturn();
-                        //serial.println("Return delay complete. Returning rotation servo to home position.");
-                        rotationServoIsActiveAndTiming = false;
-                        rotationServoSafetyDelayActive = false; // Reset safety delay flag
-                        rotationServoReturnDelayActive = false; // Reset return delay flag
-                    }
-                } else {
-                    // Still in safety delay period
-                    static unsigned long lastSafetyMessage = 0;
-                    if (millis() - lastSafetyMessage >= 500) { // Update message every 500ms
-                        unsigned long remainingMs = ROTATION_SERVO_SAFETY_DELAY_MS - (millis() - rotationServoSafetyDelayStartTime);
-                                //Serial.print("Safety delay active. Servo will return home in ");
-        //Serial.print(remainingMs);
-        //serial.println("ms to allow operator to move hand away.");
-                        lastSafetyMessage = millis();
-                    }
-                }
-            } else {
-                // Normal operation - no extended wait, but still apply 150ms return delay
-                extern bool rotationServoReturnDelayActive; // From main.cpp
-                extern unsigned long rotationServoReturnDelayStartTime; // From main.cpp
-                if (!rotationServoReturnDelayActive) {
-                    // Start the return delay period
-                    rotationServoReturnDelayActive = true;
-                    rotationServoReturnDelayStartTime = millis();
-                    //serial.println("Starting 150ms return delay before returning servo to home.");
-                } else if (millis() - rotationServoReturnDelayStartTime >= ROTATION_SERVO_RETURN_DELAY_MS) {
-                    // Return delay complete - now return servo to home
-                    handleRotationServoReturn();
-                    //serial.println("Return delay complete. Returning rotation servo to home position.");
-                    rotationServoIsActiveAndTiming = false;
-                    rotationServoReturnDelayActive = false; // Reset return delay flag
-                }
-            }
+
+    // State/step watchdog - a wait that never ends costs its budget, not the shift
+    WatchdogOverrun overrun;
+    if (checkStateWatchdog(currentState, STATE_TABLE[currentState].watchdogBudgetMs, overrun)) {
+        cancelFeedChain();      // Before the stop, so the chain cannot issue another move
+        abortHoming();
+        // Drop the queued steps as well - the axis may be jammed
+        if (cutMotor) cutMotor->forceStopAndNewPosition(cutMotor->getCurrentPosition());
+        if (feedMotor) feedMotor->forceStopAndNewPosition(feedMotor->getCurrentPosition());
+        if (overrun.stepName) {
+            logMessage("WATCHDOG: %s step %s #%d ran %lu ms (budget %lu ms) - motors stopped",
+                       getStateName(currentState), overrun.stepName, overrun.stepIndex,
+                       overrun.elapsedMs, overrun.budgetMs);
         } else {
-            // Suction sensor still reads LOW - wood not grabbed by transfer arm, continue waiting
-            //serial.println("Waiting for WAS_WOOD_SUCTIONED_SENSOR to read HIGH before returning rotation servo...");
+            logMessage("WATCHDOG: %s ran %lu ms (budget %lu ms) - motors stopped",
+                       getStateName(currentState), overrun.elapsedMs, overrun.budgetMs);
         }
+        setErrorStartTime(nowUs());
+        changeState(ERROR);
     }
+    
+    // Homing runs (HOMING, SUCTION_ERROR) - one step per pass, results come back as events
+    serviceHoming();
 
-    // Handle Rotation Clamp retraction after 1 second
-    if (rotationClampIsExtended && (millis() - rotationClampExtendTime >= ROTATION_CLAMP_EXTEND_DURATION_MS)) {
-        retractRotationClamp();
-        //serial.println("Rotation Clamp retracted after 1 second.");
+    // Check for cut motor hitting home sensor during RETURNING_YES_2x4 return.
+    // The home switch ISR normally stops the motor first; this polled check is the fallback
+    // for a switch that was already made when the stop was armed (no edge to interrupt on).
+    extern bool cutMotorInReturningYes2x4Return; // This global flag is still in main.cpp
+    if (cutMotorInReturningYes2x4Return && cutMotor && cutMotor->isRunning() && cutHomingSwitch.read() == HIGH) {
+        //serial.println("Cut motor hit homing sensor during RETURNING_YES_2x4 return - stopping immediately!");
+        long stopPosition = cutMotor->getCurrentPosition();
+        cutMotor->forceStopAndNewPosition(0);  // Stop immediately and set position to 0
+        recordCutHomePollStop(stopPosition);
     }
+    // Fire expired actuator timeouts (rotation servo hold/return, rotation clamp retract,
+    // TA signal pulse) - each actuator schedules its own timer when it is activated
+    serviceTimers();
+
+    // Position triggers: schedule the ones coming up, report the ones the timer fired
+    servicePositionTriggers();
 
     // 2x4 sensor - Update global _2x4Present flag
     extern const int _2x4_PRESENT_SENSOR; // This is in main.cpp
     _2x4Present = (digitalRead(_2x4_PRESENT_SENSOR) == LOW);
     
-    // Handle start switch safety check
-    if (!startSwitchSafe && startCycleSwitch.fell()) {
-        startSwitchSafe = true;
-    }
-    
-    // Handle error acknowledgment separately
-    if (reloadSwitch.rose() && currentState == ERROR) {
-        changeState(ERROR_RESET);
-        errorAcknowledged = true;
-    }
+    // Start switch safety, error acknowledgment (ERROR) and the other state event handlers
+    dispatchInputEvents();
     
     // Check for continuous mode activation/deactivation - modified to include safety check
     bool startSwitchOn = startCycleSwitch.read() == HIGH;
     if (startSwitchOn != continuousModeActive && startSwitchSafe) {
         continuousModeActive = startSwitchOn;
     }
-    
-    // Handle TA signal timeout after TA_SIGNAL_DURATION
-    if (signalTAActive && millis() - signalTAStartTime >= TA_SIGNAL_DURATION) {
-        extern const int TRANSFER_ARM_SIGNAL_PIN; // This is in main.cpp
-        digitalWrite(TRANSFER_ARM_SIGNAL_PIN, LOW); // Return to inactive state (LOW)
-        signalTAActive = false;
-        //serial.println("Signal to Transfer Arm (TA) timed out and reset to LOW"); 
-    }
 }
 
 //* ************************************************************************
@@ -536,9 +628,22 @@ void handleCommonOperations() {
 void handleStandardErrorState() {
     // Handle standard error state with basic error LED blinking
     handleErrorLedBlink();
-    
-    // Check for error acknowledgment
-    if (reloadSwitch.rose()) {
+}
+
+// Cycle states: let the current cut finish, then stop in IDLE instead of starting the next one.
+// Same effect as turning the start switch off, except a switch that is still on cannot
+// restart the cycle until it has been turned off and on again.
+static bool handleCycleStopCommand(const ControlCommand& command) {
+    cycleStopRequested = true;
+    startSwitchSafe = false;
+    continuousModeActive = false;
+    logMessage("Cycle stop requested in state %s - stopping after this cut", getStateName(currentState));
+    return true;
+}
+
+static void handleStandardErrorEvent(const InputEvent& event) {
+    // Reload switch ON acknowledges the error - not while the hard stop input is still held
+    if (event.type == EVENT_RELOAD_SWITCH_ON && !isHardStopInputActive()) {
         changeState(ERROR_RESET);
         errorAcknowledged = true;
         //serial.println("Standard error acknowledged by reload switch.");
@@ -546,7 +651,12 @@ void handleStandardErrorState() {
 }
 
 void handleErrorResetState() {
-    // Call the actual error reset handling function from Error_Reset.cpp
-    ::handleErrorResetState();
+    // Error acknowledged: clear it and re-home before anything else moves.
+    // (This used to call ::handleErrorResetState() - itself - and overflowed the stack.)
+    allLedsOff();
+    setErrorAcknowledged(false);
+    setWoodSuctionError(false);
+    setContinuousModeActive(false);
+    changeState(HOMING);
 }
 
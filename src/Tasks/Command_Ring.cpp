@@ -0,0 +1,103 @@
+#include "Tasks/Command_Ring.h"
+#include <atomic>
+
+//* ************************************************************************
+//* *************************** COMMAND RING *******************************
+//* ************************************************************************
+
+static const char* const CONTROL_COMMAND_NAMES[CONTROL_CMD_COUNT] = {
+    "OTA_BEGIN",
+    "OTA_ABORT",
+    "RESET_LATENCY",
+    "START_CYCLE",
+    "STOP_CYCLE",
+    "SELECT_RECIPE",
+    "LOG_STATUS"
+};
+
+static ControlCommand commandRing[CONTROL_COMMAND_RING_LENGTH];
+
+// Free-running counters; slot = counter & mask. head is written by the producer
+// only, tail by the consumer only. Release/acquire orders the slot contents.
+static std::atomic<uint32_t> commandRingHead(0);
+static std::atomic<uint32_t> commandRingTail(0);
+
+static CommandRingStats commandStats;
+static portMUX_TYPE commandStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+//* ************************************************************************
+//* ****************************** RING ************************************
+//* ************************************************************************
+
+bool pushControlCommand(const ControlCommand& command) {
+    uint32_t head = commandRingHead.load(std::memory_order_relaxed);
+    uint32_t tail = commandRingTail.load(std::memory_order_acquire);
+    uint32_t waiting = head - tail;
+
+    if (waiting >= CONTROL_COMMAND_RING_LENGTH) {
+        portENTER_CRITICAL(&commandStatsMux);
+        commandStats.dropped++;
+        portEXIT_CRITICAL(&commandStatsMux);
+        return false;
+    }
+
+    commandRing[head & (CONTROL_COMMAND_RING_LENGTH - 1)] = command;
+    commandRingHead.store(head + 1, std::memory_order_release);
+
+    portENTER_CRITICAL(&commandStatsMux);
+    commandStats.pushed++;
+    if (waiting + 1 > commandStats.highWater) commandStats.highWater = waiting + 1;
+    portEXIT_CRITICAL(&commandStatsMux);
+    return true;
+}
+
+bool popControlCommand(ControlCommand& command) {
+    uint32_t tail = commandRingTail.load(std::memory_order_relaxed);
+    uint32_t head = commandRingHead.load(std::memory_order_acquire);
+    if (head == tail) return false;
+
+    command = commandRing[tail & (CONTROL_COMMAND_RING_LENGTH - 1)];
+    commandRingTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+void recordControlCommandResult(ControlCommandType type, bool accepted) {
+    if (type >= CONTROL_CMD_COUNT) return;
+    portENTER_CRITICAL(&commandStatsMux);
+    if (accepted) commandStats.accepted[type]++; else commandStats.rejected[type]++;
+    portEXIT_CRITICAL(&commandStatsMux);
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+const char* getControlCommandName(ControlCommandType type) {
+    if (type >= CONTROL_CMD_COUNT) return "UNKNOWN";
+    return CONTROL_COMMAND_NAMES[type];
+}
+
+void getCommandRingStats(CommandRingStats& stats) {
+    portENTER_CRITICAL(&commandStatsMux);
+    stats = commandStats;
+    portEXIT_CRITICAL(&commandStatsMux);
+}
+
+void resetCommandRingStats() {
+    portENTER_CRITICAL(&commandStatsMux);
+    memset(&commandStats, 0, sizeof(commandStats));
+    portEXIT_CRITICAL(&commandStatsMux);
+}
+
+void printCommandRingReport(Print& out) {
+    CommandRingStats stats;
+    getCommandRingStats(stats);
+
+    out.println("Control commands:");
+    out.printf("  Pushed / dropped (full):   %lu / %lu\n", stats.pushed, stats.dropped);
+    out.printf("  Ring high water:           %u of %u\n", stats.highWater, CONTROL_COMMAND_RING_LENGTH);
+    out.println("  COMMAND         ACCEPTED   REJECTED");
+    for (int i = 0; i < CONTROL_CMD_COUNT; i++) {
+        out.printf("  %-15s %-10lu %lu\n", CONTROL_COMMAND_NAMES[i], stats.accepted[i], stats.rejected[i]);
+    }
+}
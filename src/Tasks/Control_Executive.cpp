@@ -0,0 +1,142 @@
+#include "Tasks/Control_Executive.h"
+#include <freertos/task.h>
+#include "StateMachine/StateManager.h"
+
+//* ************************************************************************
+//* ************************* CONTROL EXECUTIVE ****************************
+//* ************************************************************************
+
+static const char* const TASK_BUDGET_NAMES[TASK_BUDGET_COUNT] = {"control", "comms"};
+static const char* const SHED_WORK_NAMES[SHED_WORK_COUNT] = {"OTA", "console", "log drain"};
+
+static hw_timer_t* controlTickTimer = NULL;
+static TaskHandle_t tickedTask = NULL;
+static volatile bool loadSheddingActive = false;
+
+static ControlExecutiveStats executiveStats;
+static portMUX_TYPE executiveStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Timer ISR on core 1 - just wake the control task
+static void ARDUINO_ISR_ATTR onControlTick() {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(tickedTask, &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken == pdTRUE) portYIELD_FROM_ISR();
+}
+
+static void setTaskBudgets() {
+    executiveStats.tasks[TASK_BUDGET_CONTROL].budgetUs = CONTROL_TICK_BUDGET_US;
+    executiveStats.tasks[TASK_BUDGET_COMMS].budgetUs = COMMS_TASK_BUDGET_US;
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+bool startControlTick(TaskHandle_t controlTask) {
+    tickedTask = controlTask;
+    resetControlExecutiveStats();
+
+    // 80 MHz APB / 80 = 1 us per count. The interrupt goes to the core that
+    // attaches it - this one, core 1.
+    controlTickTimer = timerBegin(CONTROL_TICK_HW_TIMER, 80, true);
+    if (!controlTickTimer) return false;
+    timerAttachInterrupt(controlTickTimer, onControlTick, true);
+    timerAlarmWrite(controlTickTimer, CONTROL_TICK_PERIOD_US, true);
+    timerAlarmEnable(controlTickTimer);
+    executiveStats.tickRunning = true;
+    return true;
+}
+
+uint32_t waitForControlTick() {
+    if (!controlTickTimer) {
+        // No tick - block for one RTOS tick rather than spin and starve core 1
+        vTaskDelay(1);
+        return 0;
+    }
+
+    // The notification count is the number of ticks since the last wait
+    uint32_t ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t missed = ticks > 1 ? ticks - 1 : 0;
+    if (missed) {
+        portENTER_CRITICAL(&executiveStatsMux);
+        executiveStats.missedTicks += missed;
+        portEXIT_CRITICAL(&executiveStatsMux);
+    }
+    return missed;
+}
+
+bool isMotionCriticalState(SystemState state) {
+    return state == CUTTING || state == RETURNING_YES_2x4 || state == RETURNING_NO_2x4;
+}
+
+void setLoadSheddingActive(bool active) {
+    loadSheddingActive = active;
+}
+
+//* ************************************************************************
+//* ************************** BOTH TASKS **********************************
+//* ************************************************************************
+
+void recordTaskRun(TaskBudgetId task, unsigned long durationUs) {
+    portENTER_CRITICAL(&executiveStatsMux);
+    TaskBudgetStats& stats = executiveStats.tasks[task];
+    stats.runs++;
+    stats.lastUs = durationUs;
+    if (durationUs > stats.maxUs) stats.maxUs = durationUs;
+    if (durationUs > stats.budgetUs) stats.overruns++;
+    portEXIT_CRITICAL(&executiveStatsMux);
+}
+
+bool isLoadSheddingActive() {
+    return loadSheddingActive;
+}
+
+void recordShedWork(ShedWork work) {
+    portENTER_CRITICAL(&executiveStatsMux);
+    executiveStats.shedPasses[work]++;
+    portEXIT_CRITICAL(&executiveStatsMux);
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void getControlExecutiveStats(ControlExecutiveStats& stats) {
+    portENTER_CRITICAL(&executiveStatsMux);
+    stats = executiveStats;
+    portEXIT_CRITICAL(&executiveStatsMux);
+}
+
+void resetControlExecutiveStats() {
+    portENTER_CRITICAL(&executiveStatsMux);
+    bool tickRunning = executiveStats.tickRunning;
+    memset(&executiveStats, 0, sizeof(executiveStats));
+    executiveStats.tickRunning = tickRunning;
+    setTaskBudgets();
+    portEXIT_CRITICAL(&executiveStatsMux);
+}
+
+void printControlExecutiveReport(Print& out) {
+    ControlExecutiveStats stats;
+    getControlExecutiveStats(stats);
+
+    out.println("Control executive:");
+    if (stats.tickRunning) {
+        out.printf("  Control tick:              %lu us (%lu Hz), hardware timer %u ISR on core 1\n",
+                   CONTROL_TICK_PERIOD_US, 1000000UL / CONTROL_TICK_PERIOD_US, CONTROL_TICK_HW_TIMER);
+    } else {
+        out.println("  Control tick:              NOT RUNNING - control task runs on the RTOS tick");
+    }
+    out.printf("  Missed ticks:              %lu\n", stats.missedTicks);
+    out.printf("  Load shedding:             %s\n", isLoadSheddingActive() ? "ACTIVE" : "off");
+    out.println("  TASK      BUDGET_US    RUNS        LAST_US  MAX_US   OVERRUNS");
+    for (int i = 0; i < TASK_BUDGET_COUNT; i++) {
+        const TaskBudgetStats& task = stats.tasks[i];
+        out.printf("  %-9s %-12lu %-11lu %-8lu %-8lu %lu\n", TASK_BUDGET_NAMES[i], task.budgetUs,
+                   task.runs, task.lastUs, task.maxUs, task.overruns);
+    }
+    out.println("  Shed comms passes:");
+    for (int i = 0; i < SHED_WORK_COUNT; i++) {
+        out.printf("    %-10s %lu\n", SHED_WORK_NAMES[i], stats.shedPasses[i]);
+    }
+}
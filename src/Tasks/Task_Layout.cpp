@@ -0,0 +1,186 @@
+#include "Tasks/Task_Layout.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <stdarg.h>
+#include "OTAUpdater/ota_updater.h"
+#include "StateMachine/StateManager.h"
+#include "Diagnostics/Loop_Latency.h"
+#include "Diagnostics/Telemetry.h"
+#include "Console/Serial_Console.h"
+#include "StateMachine/FUNCTIONS/Motion_Table.h"
+#include "StateMachine/FUNCTIONS/Feed_Chain.h"
+#include "StateMachine/03_CUTTING.h"
+#include "Tasks/Control_Executive.h"
+#include "Tasks/Command_Ring.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ************************ TASK CONFIGURATION ****************************
+//* ************************************************************************
+// Control task - motion timing critical, pinned away from the WiFi stack
+const BaseType_t CONTROL_TASK_CORE = 1;
+const UBaseType_t CONTROL_TASK_PRIORITY = configMAX_PRIORITIES - 2;
+const uint32_t CONTROL_TASK_STACK_SIZE = 8192;
+
+// Comms task - WiFi, OTA and logging share core 0 with the WiFi/LwIP tasks
+const BaseType_t COMMS_TASK_CORE = 0;
+const UBaseType_t COMMS_TASK_PRIORITY = 1;
+const uint32_t COMMS_TASK_STACK_SIZE = 8192;
+const TickType_t COMMS_TASK_PERIOD_TICKS = pdMS_TO_TICKS(5);
+
+// Queue sizes
+const UBaseType_t LOG_QUEUE_LENGTH = 32;
+const UBaseType_t LOG_QUEUE_SHED_DRAIN_LEVEL = 24;   // Print anyway while shedding once this many lines wait
+const size_t LOG_MESSAGE_MAX_LENGTH = 96;
+
+struct LogMessage {
+    char text[LOG_MESSAGE_MAX_LENGTH];
+};
+
+static QueueHandle_t logQueue = NULL;
+static TaskHandle_t controlTaskHandle = NULL;
+static TaskHandle_t commsTaskHandle = NULL;
+
+static volatile unsigned long droppedLogMessages = 0;
+static bool controlPausedForOTA = false;
+
+//* ************************************************************************
+//* ************************ CONTROL TASK (CORE 1) *************************
+//* ************************************************************************
+
+static void handleControlCommand(const ControlCommand& command) {
+    bool accepted = true;
+    switch (command.type) {
+        case CONTROL_CMD_OTA_BEGIN:
+            // Flash writes stall the system - bring both axes to a stop before they start
+            stopCutMotor();
+            stopFeedMotor();
+            controlPausedForOTA = true;
+            break;
+        case CONTROL_CMD_OTA_ABORT:
+            controlPausedForOTA = false;
+            break;
+        case CONTROL_CMD_RESET_LATENCY:
+            resetLoopLatency();
+            break;
+        case CONTROL_CMD_LOG_STATUS:
+            logMachineStatus();
+            break;
+        default:
+            // Machine commands go to the current state; nothing moves while parked for OTA
+            if (controlPausedForOTA) {
+                logMessage("Command %s rejected - control parked for OTA", getControlCommandName(command.type));
+                accepted = false;
+            } else {
+                accepted = dispatchControlCommand(command);
+            }
+            break;
+    }
+    recordControlCommandResult(command.type, accepted);
+}
+
+static void controlTask(void* parameter) {
+    ControlCommand command;
+    // Start the tick from inside the task - it preempts setup() the moment it is
+    // created, so a tick started by the creator would not exist yet
+    if (!startControlTick(xTaskGetCurrentTaskHandle())) {
+        logMessage("Control tick timer failed to start - control task paced by the RTOS tick");
+    }
+    for (;;) {
+        // Fixed-rate tick (Control_Executive) - sleeps until the next 500 us boundary
+        waitForControlTick();
+        uint64_t tickStartUs = nowUs();
+
+        // Drain pending commands first so every pass sees a consistent command set
+        while (popControlCommand(command)) {
+            handleControlCommand(command);
+        }
+        serviceMotionTableLoads();
+
+        if (!controlPausedForOTA) {
+            // Time the whole pass against the state it started in
+            SystemState passState = getCurrentState();
+            uint64_t passStartUs = nowUs();
+            executeStateMachine();
+            recordLoopLatency(passState, (unsigned long)usSince(passStartUs));
+        }
+        // One consistent status picture per pass for readers on core 0
+        publishTelemetrySnapshot(controlPausedForOTA);
+        // Never shed OTA while parked for an upload - ArduinoOTA must keep being serviced
+        setLoadSheddingActive(!controlPausedForOTA && isMotionCriticalState(getCurrentState()));
+
+        recordTaskRun(TASK_BUDGET_CONTROL, (unsigned long)usSince(tickStartUs));
+    }
+}
+
+//* ************************************************************************
+//* ************************ COMMS TASK (CORE 0) ***************************
+//* ************************************************************************
+
+static void commsTask(void* parameter) {
+    LogMessage message;
+    for (;;) {
+        uint64_t runStartUs = nowUs();
+        // CUTTING / RETURNING_*: defer low-priority work until the cycle is over
+        bool shed = isLoadSheddingActive();
+
+        if (shed) recordShedWork(SHED_OTA); else handleOTA();
+        // The console keeps reading while shed so a stop command still gets through
+        if (shed) recordShedWork(SHED_CONSOLE);
+        handleSerialConsole(shed);
+
+        // Keep log lines queued while shedding, unless the queue is close to dropping them
+        if (shed && uxQueueMessagesWaiting(logQueue) < LOG_QUEUE_SHED_DRAIN_LEVEL) {
+            recordShedWork(SHED_LOG_DRAIN);
+        } else {
+            while (xQueueReceive(logQueue, &message, 0) == pdTRUE) {
+                Serial.println(message.text);
+            }
+        }
+
+        recordTaskRun(TASK_BUDGET_COMMS, (unsigned long)usSince(runStartUs));
+        vTaskDelay(COMMS_TASK_PERIOD_TICKS);
+    }
+}
+
+//* ************************************************************************
+//* ************************ PUBLIC FUNCTIONS ******************************
+//* ************************************************************************
+
+void startSystemTasks() {
+    logQueue = xQueueCreate(LOG_QUEUE_LENGTH, sizeof(LogMessage));
+    setupMotionTables();
+    setupFeedChain();
+    setupCuttingTriggers();
+
+    xTaskCreatePinnedToCore(commsTask, "comms", COMMS_TASK_STACK_SIZE, NULL,
+                            COMMS_TASK_PRIORITY, &commsTaskHandle, COMMS_TASK_CORE);
+    xTaskCreatePinnedToCore(controlTask, "control", CONTROL_TASK_STACK_SIZE, NULL,
+                            CONTROL_TASK_PRIORITY, &controlTaskHandle, CONTROL_TASK_CORE);
+}
+
+bool sendControlCommand(ControlCommandType type, uint8_t arg) {
+    ControlCommand command;
+    command.type = type;
+    command.arg = arg;
+    return pushControlCommand(command);
+}
+
+void logMessage(const char* format, ...) {
+    if (!logQueue) return;
+
+    LogMessage message;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message.text, sizeof(message.text), format, args);
+    va_end(args);
+
+    if (xQueueSend(logQueue, &message, 0) != pdTRUE) {
+        droppedLogMessages++;
+    }
+}
+
+unsigned long getDroppedLogMessageCount() {
+    return droppedLogMessages;
+}
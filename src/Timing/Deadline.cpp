@@ -0,0 +1,36 @@
+#include "Timing/Deadline.h"
+
+//* ************************************************************************
+//* ************************** DEADLINE SERVICE ****************************
+//* ************************************************************************
+// Durations are given in ms and kept in us on the 64-bit timebase (Timing/Timebase.h).
+
+void startDeadline(Deadline& deadline, unsigned long durationMs) {
+    deadline.startUs = nowUs();
+    deadline.durationUs = (uint64_t)durationMs * 1000;
+    deadline.armed = true;
+}
+
+void clearDeadline(Deadline& deadline) {
+    deadline.armed = false;
+}
+
+bool isDeadlineArmed(const Deadline& deadline) {
+    return deadline.armed;
+}
+
+bool isDeadlineExpired(const Deadline& deadline) {
+    return deadline.armed && usSince(deadline.startUs) >= deadline.durationUs;
+}
+
+bool waitForDeadline(Deadline& deadline, unsigned long durationMs) {
+    if (!deadline.armed) {
+        startDeadline(deadline, durationMs);
+        return false;
+    }
+    if (!isDeadlineExpired(deadline)) {
+        return false;
+    }
+    clearDeadline(deadline);
+    return true;
+}
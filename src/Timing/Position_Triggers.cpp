@@ -0,0 +1,267 @@
+#include "Timing/Position_Triggers.h"
+#include "StateMachine/StateManager.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ************************* POSITION TRIGGERS ****************************
+//* ************************************************************************
+
+static PositionTrigger* registeredTriggers[POSITION_TRIGGER_MAX];
+static uint8_t registeredTriggerCount = 0;
+
+// Shared by all triggers, allocated by the control task on its first pass (core 1)
+static hw_timer_t* triggerTimer = NULL;
+static bool triggerTimerAllocated = false;
+static bool triggerTimerRunning = false;
+
+// Stats are written by the control task (fired) and the timer ISR (rechecks)
+static portMUX_TYPE triggerStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static FastAccelStepper* triggerAxisMotor(TriggerAxis axis) {
+    return axis == TRIGGER_AXIS_CUT ? getCutMotor() : getFeedMotor();
+}
+
+// Steps still to go before the target, in the trigger's direction (<= 0 = passed)
+static long stepsToTarget(const PositionTrigger& trigger, long position) {
+    return (trigger.targetSteps - position) * trigger.direction;
+}
+
+static void writeTriggerOutput(PositionTrigger& trigger, long position, bool byPoll) {
+    trigger.firedPositionSteps = position;
+    trigger.output();
+    trigger.firedAtUs = nowUs();
+    trigger.firedByPoll = byPoll;
+    trigger.phase.store(TRIGGER_FIRED, std::memory_order_release);
+}
+
+//* ************************************************************************
+//* *************************** TIMER ISR **********************************
+//* ************************************************************************
+
+static void ARDUINO_ISR_ATTR checkScheduledTrigger(PositionTrigger& trigger) {
+    // Claim it - loses to a disarm or to the control pass fallback
+    uint8_t expected = TRIGGER_SCHEDULED;
+    if (!trigger.phase.compare_exchange_strong(expected, TRIGGER_FIRING, std::memory_order_acq_rel)) return;
+
+    FastAccelStepper* motor = triggerAxisMotor(trigger.axis);
+    long position = motor ? motor->getCurrentPosition() : trigger.targetSteps;
+    long remaining = stepsToTarget(trigger, position);
+    if (remaining <= 0) {
+        writeTriggerOutput(trigger, position, false);
+        return;
+    }
+
+    // Target step still to come: check again once it can have gone out while the
+    // axis is on its way, otherwise (slowed or stopped short) let the control pass
+    // predict again
+    float speed = motor ? (float)motor->getCurrentSpeedInMilliHz(true) * trigger.direction / 1000.0f : 0.0f;
+    float untilUs = speed > 0.0f ? (remaining - 1) * 1000000.0f / speed : 0.0f;
+    bool onTheWay = speed > 0.0f && untilUs <= TRIGGER_SCHEDULE_HORIZON_US;
+    portENTER_CRITICAL_ISR(&triggerStatsMux);
+    if (onTheWay) trigger.stats.rechecks++; else trigger.stats.rearmed++;
+    portEXIT_CRITICAL_ISR(&triggerStatsMux);
+
+    if (onTheWay) {
+        trigger.scheduledForUs = nowUs() + (uint64_t)untilUs;
+        trigger.phase.store(TRIGGER_SCHEDULED, std::memory_order_release);
+        return;
+    }
+    trigger.phase.store(TRIGGER_ARMED, std::memory_order_release);
+}
+
+// Every TRIGGER_RECHECK_US while a trigger is scheduled - checks the ones now due
+static void ARDUINO_ISR_ATTR onPositionTriggerTimer() {
+    uint64_t now = nowUs();
+    for (uint8_t i = 0; i < registeredTriggerCount; i++) {
+        PositionTrigger& trigger = *registeredTriggers[i];
+        if (trigger.phase.load(std::memory_order_acquire) != TRIGGER_SCHEDULED) continue;
+        if (now < trigger.scheduledForUs) continue;
+        checkScheduledTrigger(trigger);
+    }
+}
+
+//* ************************************************************************
+//* ************************** CONTROL TASK ********************************
+//* ************************************************************************
+
+bool registerPositionTrigger(PositionTrigger& trigger, const char* name, TriggerAxis axis,
+                             int8_t direction, TriggerOutput output, TriggerCallback onFired) {
+    if (registeredTriggerCount >= POSITION_TRIGGER_MAX) return false;
+
+    trigger.name = name;
+    trigger.axis = axis;
+    trigger.direction = direction < 0 ? -1 : 1;
+    trigger.output = output;
+    trigger.onFired = onFired;
+    trigger.phase.store(TRIGGER_IDLE, std::memory_order_relaxed);
+    memset(&trigger.stats, 0, sizeof(trigger.stats));
+
+    registeredTriggers[registeredTriggerCount++] = &trigger;
+    return true;
+}
+
+// The interrupt is attached on the core that allocates the timer, so this runs
+// from the control task. Autoreload from TRIGGER_RECHECK_US, alarm left off until
+// a trigger is scheduled.
+static void allocateTriggerTimer() {
+    triggerTimerAllocated = true;
+    triggerTimer = timerBegin(POSITION_TRIGGER_HW_TIMER, 80, true);     // 1 MHz
+    if (!triggerTimer) {
+        logMessage("WARNING: position trigger timer %u unavailable - triggers fire from the control pass",
+                   POSITION_TRIGGER_HW_TIMER);
+        return;
+    }
+    timerAttachInterrupt(triggerTimer, onPositionTriggerTimer, true);
+    timerAlarmWrite(triggerTimer, TRIGGER_RECHECK_US, true);
+}
+
+// The ISR runs on this core, so it never sees the alarm change under it
+static void setTriggerTimerRunning(bool running) {
+    if (!triggerTimer || running == triggerTimerRunning) return;
+    if (running) {
+        timerWrite(triggerTimer, 0);
+        timerAlarmEnable(triggerTimer);
+    } else {
+        timerAlarmDisable(triggerTimer);
+    }
+    triggerTimerRunning = running;
+}
+
+// Report a written output and hand over to the owner's bookkeeping
+static void completePositionTrigger(PositionTrigger& trigger) {
+    long errorSteps = (trigger.firedPositionSteps - trigger.targetSteps) * trigger.direction;
+    long absErrorSteps = errorSteps < 0 ? -errorSteps : errorSteps;
+
+    portENTER_CRITICAL(&triggerStatsMux);
+    PositionTriggerStats& stats = trigger.stats;
+    stats.fired++;
+    if (trigger.firedByPoll) {
+        stats.polled++;
+    } else {
+        unsigned long latencyUs = trigger.firedAtUs > trigger.scheduledForUs ?
+                                  (unsigned long)(trigger.firedAtUs - trigger.scheduledForUs) : 0;
+        stats.lastTimerLatencyUs = latencyUs;
+        if (latencyUs > stats.maxTimerLatencyUs) stats.maxTimerLatencyUs = latencyUs;
+    }
+    stats.lastErrorSteps = errorSteps;
+    if (absErrorSteps > stats.maxErrorSteps) stats.maxErrorSteps = absErrorSteps;
+    stats.totalAbsErrorSteps += absErrorSteps;
+    portEXIT_CRITICAL(&triggerStatsMux);
+
+    trigger.phase.store(TRIGGER_IDLE, std::memory_order_release);
+    if (trigger.onFired) trigger.onFired(trigger);
+}
+
+bool armPositionTrigger(PositionTrigger& trigger, long targetSteps) {
+    uint8_t phase = trigger.phase.load(std::memory_order_acquire);
+    if (phase == TRIGGER_FIRED) {
+        completePositionTrigger(trigger);
+    } else if (phase == TRIGGER_SCHEDULED) {
+        if (!trigger.phase.compare_exchange_strong(phase, TRIGGER_IDLE, std::memory_order_acq_rel)) {
+            return false;   // The timer ISR claimed it first
+        }
+    } else if (phase == TRIGGER_FIRING) {
+        return false;
+    }
+    trigger.targetSteps = targetSteps;
+    trigger.phase.store(TRIGGER_ARMED, std::memory_order_release);
+    return true;
+}
+
+void disarmPositionTrigger(PositionTrigger& trigger) {
+    uint8_t phase = trigger.phase.load(std::memory_order_acquire);
+    if (phase == TRIGGER_ARMED || phase == TRIGGER_SCHEDULED) {
+        trigger.phase.compare_exchange_strong(phase, TRIGGER_IDLE, std::memory_order_acq_rel);
+    }
+}
+
+bool isPositionTriggerPending(const PositionTrigger& trigger) {
+    uint8_t phase = trigger.phase.load(std::memory_order_acquire);
+    return phase == TRIGGER_ARMED || phase == TRIGGER_SCHEDULED || phase == TRIGGER_FIRING;
+}
+
+void servicePositionTriggers() {
+    if (!triggerTimerAllocated && registeredTriggerCount > 0) allocateTriggerTimer();
+
+    bool anyScheduled = false;
+    for (uint8_t i = 0; i < registeredTriggerCount; i++) {
+        PositionTrigger& trigger = *registeredTriggers[i];
+        uint8_t phase = trigger.phase.load(std::memory_order_acquire);
+
+        if (phase == TRIGGER_FIRED) {
+            completePositionTrigger(trigger);
+            continue;
+        }
+        if (phase != TRIGGER_ARMED && phase != TRIGGER_SCHEDULED) continue;
+
+        FastAccelStepper* motor = triggerAxisMotor(trigger.axis);
+        if (!motor) continue;
+        long position = motor->getCurrentPosition();
+        long remaining = stepsToTarget(trigger, position);
+
+        if (remaining <= 0) {
+            // Passed without the timer (axis sped up, or armed behind the axis) - fire now
+            if (trigger.phase.compare_exchange_strong(phase, TRIGGER_FIRING, std::memory_order_acq_rel)) {
+                writeTriggerOutput(trigger, position, true);
+                completePositionTrigger(trigger);
+            }
+            continue;
+        }
+        if (phase == TRIGGER_SCHEDULED) {
+            anyScheduled = true;
+            continue;
+        }
+        if (!triggerTimer) continue;
+
+        // Speed towards the target; inside the horizon it is treated as constant.
+        // The axis may be up to one step further on than the counter shows, so aim
+        // for the earliest the target step can go out - the ISR checks from there.
+        float speed = (float)motor->getCurrentSpeedInMilliHz(true) * trigger.direction / 1000.0f;
+        if (speed <= 0.0f) continue;
+        float untilUs = (remaining - 1) * 1000000.0f / speed;
+        if (untilUs > TRIGGER_SCHEDULE_HORIZON_US) continue;
+
+        trigger.scheduledForUs = nowUs() + (uint64_t)untilUs;
+        trigger.phase.store(TRIGGER_SCHEDULED, std::memory_order_release);
+        anyScheduled = true;
+    }
+    setTriggerTimerRunning(anyScheduled);
+}
+
+//* ************************************************************************
+//* ************************** DIAGNOSTICS *********************************
+//* ************************************************************************
+
+void resetPositionTriggerStats() {
+    portENTER_CRITICAL(&triggerStatsMux);
+    for (uint8_t i = 0; i < registeredTriggerCount; i++) {
+        memset(&registeredTriggers[i]->stats, 0, sizeof(PositionTriggerStats));
+    }
+    portEXIT_CRITICAL(&triggerStatsMux);
+}
+
+void printPositionTriggerReport(Print& out) {
+    out.println("Position triggers (error = fired - target steps, in the direction of travel):");
+    if (triggerTimer) {
+        out.printf("  Timer: hardware timer %u ISR on core 1, every %lu us while scheduled\n",
+                   POSITION_TRIGGER_HW_TIMER, (unsigned long)TRIGGER_RECHECK_US);
+    } else {
+        out.printf("  Timer: %s - all triggers fire from the control pass\n",
+                   triggerTimerAllocated ? "NOT AVAILABLE" : "not started");
+    }
+    out.println("  TRIGGER            AXIS  FIRED  POLLED RECHK  REARM  LAST ERR  MAX ERR  MEAN ERR  ISR LAT (LAST/MAX us)");
+    for (uint8_t i = 0; i < registeredTriggerCount; i++) {
+        const PositionTrigger& trigger = *registeredTriggers[i];
+        PositionTriggerStats stats;
+        portENTER_CRITICAL(&triggerStatsMux);
+        stats = trigger.stats;
+        portEXIT_CRITICAL(&triggerStatsMux);
+
+        float meanError = stats.fired ? (float)stats.totalAbsErrorSteps / stats.fired : 0.0f;
+        out.printf("  %-18s %-5s %-6lu %-6lu %-6lu %-6lu %-9ld %-8ld %-9.1f %lu/%lu\n",
+                   trigger.name, trigger.axis == TRIGGER_AXIS_CUT ? "cut" : "feed",
+                   stats.fired, stats.polled, stats.rechecks, stats.rearmed,
+                   stats.lastErrorSteps, stats.maxErrorSteps,
+                   meanError, stats.lastTimerLatencyUs, stats.maxTimerLatencyUs);
+    }
+}
@@ -0,0 +1,34 @@
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ***************************** TIMEBASE *********************************
+//* ************************************************************************
+
+#ifdef TIMEBASE_VIRTUAL_CLOCK
+
+static uint64_t virtualNowUs = 0;
+
+uint64_t nowUs() {
+    return virtualNowUs;
+}
+
+void setVirtualTimeUs(uint64_t timeUs) {
+    virtualNowUs = timeUs;
+}
+
+void advanceVirtualTimeUs(uint64_t deltaUs) {
+    virtualNowUs += deltaUs;
+}
+
+#else
+
+#include <esp_timer.h>
+
+// IRAM_ATTR only keeps the call itself out of flash. The stop ISRs that use it
+// also call digitalRead() and FastAccelStepper, so none of them is safe while
+// the flash cache is disabled.
+uint64_t IRAM_ATTR nowUs() {
+    return (uint64_t)esp_timer_get_time();
+}
+
+#endif
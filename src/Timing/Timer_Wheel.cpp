@@ -0,0 +1,94 @@
+#include "Timing/Timer_Wheel.h"
+
+//* ************************************************************************
+//* **************************** TIMER WHEEL *******************************
+//* ************************************************************************
+
+const unsigned long TIMER_WHEEL_SLOTS = 128;    // Power of two - slot = expiry & mask
+const unsigned long TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+
+static WheelTimer* timerWheelSlots[TIMER_WHEEL_SLOTS];
+static uint64_t lastServicedMs = 0;
+static bool timerWheelStarted = false;
+
+static uint64_t timerWheelNow() {
+    return nowUs() / 1000;
+}
+
+static bool isTimerDue(const WheelTimer& timer, uint64_t nowMs) {
+    return timer.expiryMs <= nowMs;
+}
+
+static void unlinkTimer(WheelTimer& timer) {
+    if (timer.prev) {
+        timer.prev->next = timer.next;
+    } else {
+        timerWheelSlots[timer.expiryMs & TIMER_WHEEL_SLOT_MASK] = timer.next;
+    }
+    if (timer.next) timer.next->prev = timer.prev;
+    timer.next = NULL;
+    timer.prev = NULL;
+    timer.scheduled = false;
+}
+
+//* ************************************************************************
+//* ************************** PUBLIC FUNCTIONS ****************************
+//* ************************************************************************
+
+void scheduleTimer(WheelTimer& timer, unsigned long delayMs, TimerCallback callback) {
+    uint64_t nowMs = timerWheelNow();
+    if (!timerWheelStarted) {
+        // Nothing can be due before the first schedule - start the sweep here
+        lastServicedMs = nowMs - 1;
+        timerWheelStarted = true;
+    }
+    if (timer.scheduled) unlinkTimer(timer);
+    // The current tick's slot may already have been swept this millisecond
+    if (delayMs == 0) delayMs = 1;
+
+    timer.expiryMs = nowMs + delayMs;
+    timer.callback = callback;
+    timer.scheduled = true;
+
+    WheelTimer*& slot = timerWheelSlots[timer.expiryMs & TIMER_WHEEL_SLOT_MASK];
+    timer.prev = NULL;
+    timer.next = slot;
+    if (slot) slot->prev = &timer;
+    slot = &timer;
+}
+
+void cancelTimer(WheelTimer& timer) {
+    if (timer.scheduled) unlinkTimer(timer);
+}
+
+bool isTimerScheduled(const WheelTimer& timer) {
+    return timer.scheduled;
+}
+
+void serviceTimers() {
+    if (!timerWheelStarted) return;
+
+    uint64_t nowMs = timerWheelNow();
+    uint64_t ticks = nowMs - lastServicedMs;
+    if (ticks == 0) return;
+    // After a long stall one lap visits every slot - due timers in any slot are caught
+    if (ticks > TIMER_WHEEL_SLOTS) ticks = TIMER_WHEEL_SLOTS;
+
+    for (uint64_t tick = 1; tick <= ticks; tick++) {
+        unsigned long slotIndex = (lastServicedMs + tick) & TIMER_WHEEL_SLOT_MASK;
+        WheelTimer* timer = timerWheelSlots[slotIndex];
+        while (timer) {
+            if (!isTimerDue(*timer, nowMs)) {
+                timer = timer->next;    // Due on a later lap
+                continue;
+            }
+            TimerCallback callback = timer->callback;
+            unlinkTimer(*timer);
+            if (callback) callback();
+            // The callback may have edited this slot - rescan it from the head.
+            // A timer rescheduled from its callback always lands in the future, so this ends.
+            timer = timerWheelSlots[slotIndex];
+        }
+    }
+    lastServicedMs = nowMs;
+}
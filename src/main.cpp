@@ -9,6 +9,8 @@
 #include "StateMachine/FUNCTIONS/General_Functions.h"
 #include "ErrorStates/Errors_Functions.h"
 #include "StateMachine/StateManager.h"
+#include "Tasks/Task_Layout.h"
+#include "Safety/Stop_Interrupts.h"
 
 //* ************************************************************************
 //* ************************ AUTOMATED TABLE SAW **************************
@@ -19,18 +21,18 @@
 // Pin definitions and configuration constants are now in Config/ header files
 
 // Timing variables (constants moved to Config/system_config.h)
-unsigned long rotationServoActiveStartTime = 0;
+uint64_t rotationServoActiveStartTime = 0;
 bool rotationServoIsActiveAndTiming = false;
 
 // Rotation servo safety delay variables
 bool rotationServoSafetyDelayActive = false;
-unsigned long rotationServoSafetyDelayStartTime = 0;
+uint64_t rotationServoSafetyDelayStartTime = 0;
 
 // Rotation servo return delay variables
 bool rotationServoReturnDelayActive = false;
-unsigned long rotationServoReturnDelayStartTime = 0;
+uint64_t rotationServoReturnDelayStartTime = 0;
 
-unsigned long rotationClampExtendTime = 0;
+uint64_t rotationClampExtendTime = 0;
 bool rotationClampIsExtended = false;
 
 // SystemStates Enum is now in Functions.h
@@ -69,17 +71,17 @@ bool startSwitchSafe = false;       // New flag to track if start switch is safe
 bool comingFromNoWoodWithSensorsClear = false; // Flag to track when coming from no-wood cycle with sensors clear
 
 // Timers for various operations
-unsigned long lastBlinkTime = 0;
-unsigned long lastErrorBlinkTime = 0;
-unsigned long errorStartTime = 0;
-unsigned long feedMoveStartTime = 0;
+uint64_t lastBlinkTime = 0;
+uint64_t lastErrorBlinkTime = 0;
+uint64_t errorStartTime = 0;
+uint64_t feedMoveStartTime = 0;
 
 // LED states
 bool blinkState = false;
 bool errorBlinkState = false;
 
 // Global variables for signal handling
-unsigned long signalTAStartTime = 0; // For Transfer Arm signal
+uint64_t signalTAStartTime = 0; // For Transfer Arm signal
 bool signalTAActive = false;      // For Transfer Arm signal
 
 // New flag to track cut motor return during RETURNING_YES_2x4 mode
@@ -201,11 +203,15 @@ void setup() {
   }
   
   delay(10);
+
+  //! Attach the cut home / hard stop interrupts (setup() runs on core 1, same core as the control task)
+  setupStopInterrupts(cutMotor, feedMotor);
+
+  //! Start the control (core 1) and comms (core 0) tasks
+  startSystemTasks();
 }
 
 void loop() {
-  handleOTA(); // Handle OTA requests
-
-  // Execute the state machine - all the logic below has been moved to function-based state management
-  executeStateMachine();
+  // OTA and the state machine now run in their own pinned tasks (see Tasks/Task_Layout.cpp)
+  vTaskDelete(NULL);
 }
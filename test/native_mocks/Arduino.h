@@ -0,0 +1,185 @@
+#ifndef NATIVE_MOCK_ARDUINO_H
+#define NATIVE_MOCK_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+//* ************************************************************************
+//* ************************ NATIVE ARDUINO MOCK ***************************
+//* ************************************************************************
+// Just enough of the Arduino core for the firmware to build and run on the host
+// (pio test -e native). Everything is inline so the mocks need no source file.
+//
+// Time is the virtual clock (Timing/Timebase.h, -DTIMEBASE_VIRTUAL_CLOCK):
+// millis()/micros() read it and delay()/delayMicroseconds() advance it, so a
+// handler that blocks shows up as elapsed time in its pass.
+// Pins are a level table - the test drives inputs with setMockPinLevel().
+
+uint64_t nowUs();
+void advanceVirtualTimeUs(uint64_t deltaUs);
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define ARDUINO_ISR_ATTR
+#define ESP_OK 0
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef int esp_err_t;
+
+using std::min;
+using std::max;
+
+const uint8_t MOCK_PIN_COUNT = 64;
+
+inline uint8_t* mockPinLevels() {
+    static uint8_t levels[MOCK_PIN_COUNT];
+    return levels;
+}
+
+inline void setMockPinLevel(uint8_t pin, uint8_t level) {
+    if (pin < MOCK_PIN_COUNT) mockPinLevels()[pin] = level;
+}
+
+inline unsigned long millis() { return (unsigned long)(nowUs() / 1000); }
+inline unsigned long micros() { return (unsigned long)nowUs(); }
+inline void delay(uint32_t ms) { advanceVirtualTimeUs((uint64_t)ms * 1000); }
+inline void delayMicroseconds(uint32_t us) { advanceVirtualTimeUs(us); }
+
+inline int digitalRead(uint8_t pin) { return pin < MOCK_PIN_COUNT ? mockPinLevels()[pin] : LOW; }
+inline void digitalWrite(uint8_t pin, uint8_t level) { setMockPinLevel(pin, level); }
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {}
+inline void detachInterrupt(uint8_t pin) {}
+inline uint8_t digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+template <class T, class L, class H>
+T constrain(T value, L low, H high) {
+    return value < low ? (T)low : (value > high ? (T)high : value);
+}
+
+// Hardware timers (esp32-hal-timer) are handed out but never interrupt
+struct hw_timer_s {
+    uint8_t number;
+    uint64_t alarmCount;
+    bool alarmEnabled;
+};
+typedef struct hw_timer_s hw_timer_t;
+
+inline hw_timer_t* timerBegin(uint8_t number, uint16_t divider, bool countUp) {
+    static hw_timer_t timers[4];
+    if (number >= 4) return NULL;
+    timers[number].number = number;
+    return &timers[number];
+}
+inline void timerAttachInterrupt(hw_timer_t* timer, void (*isr)(void), bool edge) {}
+inline void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmCount, bool autoreload) { timer->alarmCount = alarmCount; }
+inline void timerAlarmEnable(hw_timer_t* timer) { timer->alarmEnabled = true; }
+inline void timerAlarmDisable(hw_timer_t* timer) { timer->alarmEnabled = false; }
+inline void timerRestart(hw_timer_t* timer) {}
+inline void timerStart(hw_timer_t* timer) {}
+inline void timerStop(hw_timer_t* timer) {}
+inline void timerWrite(hw_timer_t* timer, uint64_t count) {}
+
+//* ************************************************************************
+//* ************************** STRING / PRINT ******************************
+//* ************************************************************************
+
+class String {
+public:
+    String() {}
+    String(const char* text) : value(text ? text : "") {}
+    String(const std::string& text) : value(text) {}
+    String(int number) : value(std::to_string(number)) {}
+    String(unsigned int number) : value(std::to_string(number)) {}
+    String(long number) : value(std::to_string(number)) {}
+    String(unsigned long number) : value(std::to_string(number)) {}
+    String(float number, unsigned int decimals = 2) : value(std::to_string(number)) {}
+
+    String operator+(const String& other) const { return String(value + other.value); }
+    friend String operator+(const char* left, const String& right) { return String(std::string(left) + right.value); }
+    String& operator+=(const String& other) { value += other.value; return *this; }
+    bool operator==(const char* other) const { return value == other; }
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return value.size(); }
+    bool isEmpty() const { return value.empty(); }
+
+private:
+    std::string value;
+};
+
+// Output is discarded - the tests assert on state, not on log text
+class Print {
+public:
+    size_t print(const char* text) { return 0; }
+    size_t print(const String& text) { return 0; }
+    size_t print(char c) { return 0; }
+    size_t print(long number, int base = 10) { return 0; }
+    size_t print(unsigned long number, int base = 10) { return 0; }
+    size_t print(int number, int base = 10) { return 0; }
+    size_t print(unsigned int number, int base = 10) { return 0; }
+    size_t print(double number, int digits = 2) { return 0; }
+    size_t println(const char* text = "") { return 0; }
+    size_t println(const String& text) { return 0; }
+    size_t println(char c) { return 0; }
+    size_t println(long number, int base = 10) { return 0; }
+    size_t println(unsigned long number, int base = 10) { return 0; }
+    size_t println(int number, int base = 10) { return 0; }
+    size_t println(unsigned int number, int base = 10) { return 0; }
+    size_t println(double number, int digits = 2) { return 0; }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) { return 0; }
+    size_t write(const uint8_t* buffer, size_t size) { return size; }
+};
+
+class IPAddress {
+public:
+    String toString() const { return String("0.0.0.0"); }
+};
+
+class HardwareSerial : public Print {
+public:
+    using Print::print;
+    using Print::println;
+    void begin(unsigned long baud) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t println(const IPAddress& address) { return 0; }
+    void flush() {}
+};
+
+// One per translation unit - nothing is shared through it
+static HardwareSerial Serial __attribute__((unused));
+
+class EspClass {
+public:
+    void restart() {}
+};
+
+static EspClass ESP __attribute__((unused));
+
+// The ESP32 core pulls these in with Arduino.h
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+#endif // NATIVE_MOCK_ARDUINO_H
@@ -0,0 +1,27 @@
+#ifndef NATIVE_MOCK_ARDUINO_OTA_H
+#define NATIVE_MOCK_ARDUINO_OTA_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define U_FLASH 0
+#define U_SPIFFS 100
+
+typedef enum { OTA_AUTH_ERROR, OTA_BEGIN_ERROR, OTA_CONNECT_ERROR, OTA_RECEIVE_ERROR, OTA_END_ERROR } ota_error_t;
+
+// Handlers are accepted and never called - no upload ever starts on the host
+class ArduinoOTAClass {
+public:
+    ArduinoOTAClass& onStart(std::function<void(void)> handler) { return *this; }
+    ArduinoOTAClass& onEnd(std::function<void(void)> handler) { return *this; }
+    ArduinoOTAClass& onProgress(std::function<void(unsigned int, unsigned int)> handler) { return *this; }
+    ArduinoOTAClass& onError(std::function<void(ota_error_t)> handler) { return *this; }
+    void setHostname(const char* hostname) {}
+    void begin() {}
+    void handle() {}
+    int getCommand() { return U_FLASH; }
+};
+
+static ArduinoOTAClass ArduinoOTA __attribute__((unused));
+
+#endif // NATIVE_MOCK_ARDUINO_OTA_H
@@ -0,0 +1,49 @@
+#ifndef NATIVE_MOCK_BOUNCE2_H
+#define NATIVE_MOCK_BOUNCE2_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************* NATIVE BOUNCE MOCK ***************************
+//* ************************************************************************
+// Reads the mock pin level on every update() - a level change is accepted once
+// it has been stable for the interval, like Bounce2's stable-interval mode.
+
+class Bounce {
+public:
+    void attach(int pin) { attachedPin = pin; stableState = unstableState = digitalRead(pin); }
+    void attach(int pin, int mode) { attach(pin); }
+    void interval(uint16_t intervalMs) { stableIntervalMs = intervalMs; }
+
+    bool update() {
+        changedState = false;
+        bool level = digitalRead(attachedPin);
+        if (level != unstableState) {
+            unstableState = level;
+            unstableSinceMs = millis();
+        }
+        if (stableState != unstableState && millis() - unstableSinceMs >= stableIntervalMs) {
+            stableState = unstableState;
+            stableSinceMs = millis();
+            changedState = true;
+        }
+        return changedState;
+    }
+
+    bool read() const { return stableState; }
+    bool changed() const { return changedState; }
+    bool rose() const { return changedState && stableState; }
+    bool fell() const { return changedState && !stableState; }
+    unsigned long currentDuration() const { return millis() - stableSinceMs; }
+
+private:
+    int attachedPin = 0;
+    uint16_t stableIntervalMs = 10;
+    bool stableState = false;
+    bool unstableState = false;
+    bool changedState = false;
+    unsigned long unstableSinceMs = 0;
+    unsigned long stableSinceMs = 0;
+};
+
+#endif // NATIVE_MOCK_BOUNCE2_H
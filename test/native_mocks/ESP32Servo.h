@@ -0,0 +1,18 @@
+#ifndef NATIVE_MOCK_ESP32_SERVO_H
+#define NATIVE_MOCK_ESP32_SERVO_H
+
+#include <Arduino.h>
+
+class Servo {
+public:
+    int attach(int pin) { return 1; }
+    int attach(int pin, int minUs, int maxUs) { return 1; }
+    void write(int value) { angle = value; }
+    int read() { return angle; }
+    bool attached() { return true; }
+
+private:
+    int angle = 0;
+};
+
+#endif // NATIVE_MOCK_ESP32_SERVO_H
@@ -0,0 +1,6 @@
+#ifndef NATIVE_MOCK_ESPMDNS_H
+#define NATIVE_MOCK_ESPMDNS_H
+
+#include <Arduino.h>
+
+#endif // NATIVE_MOCK_ESPMDNS_H
@@ -0,0 +1,97 @@
+#ifndef NATIVE_MOCK_FAST_ACCEL_STEPPER_H
+#define NATIVE_MOCK_FAST_ACCEL_STEPPER_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ******************** NATIVE FASTACCELSTEPPER MOCK **********************
+//* ************************************************************************
+// Positioned moves and queued steps complete the moment they are issued;
+// runForward()/runBackward() keep the motor running, without moving, until
+// it is stopped. Enough to walk the state handlers through their steps.
+
+#define MOVE_OK 0
+#define AQE_OK 0
+#define RAMP_STATE_IDLE 0
+#define RAMP_STATE_COAST 1
+
+struct stepper_command_s {
+    uint16_t ticks;
+    uint8_t steps;
+    bool count_up;
+};
+
+class FastAccelStepper {
+public:
+    void setDirectionPin(uint8_t pin, bool dirHighCountsUp = true, uint16_t dirChangeDelayUs = 0) {}
+    int8_t setSpeedInHz(uint32_t speed) { speedHz = speed; return MOVE_OK; }
+    int8_t setSpeedInUs(uint32_t periodUs) { speedHz = periodUs ? 1000000 / periodUs : 0; return MOVE_OK; }
+    int8_t setSpeedInMilliHz(uint32_t speed) { speedHz = speed / 1000; return MOVE_OK; }
+    int8_t setAcceleration(int32_t value) { acceleration = value; return MOVE_OK; }
+    void setLinearAcceleration(uint32_t steps) {}
+    void setJumpStart(uint32_t steps) {}
+    void setForwardPlanningTimeInMs(uint8_t ms) {}
+    void applySpeedAcceleration() {}
+
+    int8_t moveTo(int32_t target, bool blocking = false) {
+        position = targetPosition = target;
+        running = false;
+        return MOVE_OK;
+    }
+    int8_t move(int32_t steps, bool blocking = false) { return moveTo(targetPosition + steps); }
+    int8_t runForward() { running = true; return MOVE_OK; }
+    int8_t runBackward() { running = true; return MOVE_OK; }
+
+    void stopMove() { running = false; targetPosition = position; }
+    void forceStop() { stopMove(); }
+    void forceStopAndNewPosition(int32_t newPosition) { running = false; position = targetPosition = newPosition; }
+    void setCurrentPosition(int32_t newPosition) { position = targetPosition = newPosition; }
+
+    int32_t getCurrentPosition() { return position; }
+    int32_t getTargetPos() { return targetPosition; }
+    int32_t targetPos() { return targetPosition; }
+    int32_t getPositionAfterCommandsCompleted() { return targetPosition; }
+    void setPositionAfterCommandsCompleted(int32_t newPosition) { targetPosition = newPosition; }
+
+    bool isRunning() { return running; }
+    bool isRampGeneratorActive() { return running; }
+    bool isStopping() { return false; }
+    uint8_t rampState() { return running ? RAMP_STATE_COAST : RAMP_STATE_IDLE; }
+    int32_t getCurrentSpeedInMilliHz(bool realtime = true) { return running ? (int32_t)speedHz * 1000 : 0; }
+    uint32_t getSpeedInMilliHz() { return speedHz * 1000; }
+    uint32_t getMaxSpeedInHz() { return 200000; }
+    uint32_t getAcceleration() { return acceleration; }
+    int32_t getCurrentAcceleration() { return 0; }
+
+    int8_t addQueueEntry(const struct stepper_command_s* command, bool start = true) {
+        position += command->count_up ? command->steps : -(int32_t)command->steps;
+        targetPosition = position;
+        return AQE_OK;
+    }
+    bool isQueueEmpty() { return true; }
+    bool isQueueFull() { return false; }
+    bool isQueueRunning() { return false; }
+
+private:
+    int32_t position = 0;
+    int32_t targetPosition = 0;
+    uint32_t speedHz = 0;
+    uint32_t acceleration = 0;
+    bool running = false;
+};
+
+class FastAccelStepperEngine {
+public:
+    void init() {}
+    void init(uint8_t cpuCore) {}
+    FastAccelStepper* stepperConnectToPin(uint8_t stepPin) {
+        if (stepperCount >= 2) return NULL;
+        return &steppers[stepperCount++];
+    }
+
+private:
+    FastAccelStepper steppers[2];
+    uint8_t stepperCount = 0;
+};
+
+#endif // NATIVE_MOCK_FAST_ACCEL_STEPPER_H
@@ -0,0 +1,22 @@
+#ifndef NATIVE_MOCK_WIFI_H
+#define NATIVE_MOCK_WIFI_H
+
+#include <Arduino.h>
+
+#define WIFI_STA 1
+#define WL_CONNECTED 3
+
+// Always connected - setupOTA() returns straight away
+class WiFiClass {
+public:
+    void mode(int mode) {}
+    void begin(const char* ssid, const char* password) {}
+    int waitForConnectResult() { return WL_CONNECTED; }
+    IPAddress localIP() { return IPAddress(); }
+    bool isConnected() { return true; }
+    int status() { return WL_CONNECTED; }
+};
+
+static WiFiClass WiFi __attribute__((unused));
+
+#endif // NATIVE_MOCK_WIFI_H
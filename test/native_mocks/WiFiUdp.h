@@ -0,0 +1,14 @@
+#ifndef NATIVE_MOCK_WIFI_UDP_H
+#define NATIVE_MOCK_WIFI_UDP_H
+
+#include <Arduino.h>
+
+class WiFiUDP {
+public:
+    int begin(uint16_t port) { return 1; }
+    int beginPacket(const char* host, uint16_t port) { return 1; }
+    size_t write(const uint8_t* buffer, size_t size) { return size; }
+    int endPacket() { return 1; }
+};
+
+#endif // NATIVE_MOCK_WIFI_UDP_H
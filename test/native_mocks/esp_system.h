@@ -0,0 +1,6 @@
+#ifndef NATIVE_MOCK_ESP_SYSTEM_H
+#define NATIVE_MOCK_ESP_SYSTEM_H
+
+#include <Arduino.h>
+
+#endif // NATIVE_MOCK_ESP_SYSTEM_H
@@ -0,0 +1,38 @@
+#ifndef NATIVE_MOCK_ESP_TIMER_H
+#define NATIVE_MOCK_ESP_TIMER_H
+
+#include <stdint.h>
+
+//* ************************************************************************
+//* *********************** NATIVE ESP_TIMER MOCK **************************
+//* ************************************************************************
+// Timers are created and started but never call back - the test runs the
+// control pass itself, and position triggers are not exercised on the host.
+
+uint64_t nowUs();
+
+typedef void* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+typedef enum { ESP_TIMER_TASK, ESP_TIMER_ISR } esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void* arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char* name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+inline int64_t esp_timer_get_time() { return (int64_t)nowUs(); }
+
+inline int esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+    static int timerCount = 0;
+    *handle = (esp_timer_handle_t)(intptr_t)(++timerCount);
+    return 0;
+}
+
+inline int esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) { return 0; }
+inline int esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) { return 0; }
+inline int esp_timer_stop(esp_timer_handle_t timer) { return 0; }
+
+#endif // NATIVE_MOCK_ESP_TIMER_H
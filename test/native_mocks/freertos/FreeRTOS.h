@@ -0,0 +1,42 @@
+#ifndef NATIVE_MOCK_FREERTOS_H
+#define NATIVE_MOCK_FREERTOS_H
+
+#include <stdint.h>
+
+//* ************************************************************************
+//* ************************ NATIVE FREERTOS MOCK **************************
+//* ************************************************************************
+// Single-threaded host build: critical sections are empty and one RTOS tick
+// is 1 ms of the virtual clock.
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void* TaskHandle_t;
+
+struct MockQueue;
+typedef MockQueue* QueueHandle_t;
+
+typedef struct {
+    uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define configMAX_PRIORITIES 25
+#define tskIDLE_PRIORITY 0
+
+#endif // NATIVE_MOCK_FREERTOS_H
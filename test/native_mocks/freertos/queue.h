@@ -0,0 +1,54 @@
+#ifndef NATIVE_MOCK_FREERTOS_QUEUE_H
+#define NATIVE_MOCK_FREERTOS_QUEUE_H
+
+#include <string.h>
+#include <deque>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+
+//* ************************************************************************
+//* ************************* NATIVE QUEUE MOCK ****************************
+//* ************************************************************************
+// Bounded FIFO of fixed-size items, like the RTOS queue. Nothing ever waits:
+// a full send or an empty receive fails at once whatever the timeout.
+
+struct MockQueue {
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    std::deque<std::vector<uint8_t> > items;
+};
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    MockQueue* queue = new MockQueue;
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+inline BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    if (!queue || queue->items.size() >= queue->length) return pdFALSE;
+    const uint8_t* bytes = (const uint8_t*)item;
+    queue->items.push_back(std::vector<uint8_t>(bytes, bytes + queue->itemSize));
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return xQueueSendToBack(queue, item, ticks);
+}
+
+inline BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken) {
+    return xQueueSendToBack(queue, item, 0);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+    if (!queue || queue->items.empty()) return pdFALSE;
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    return queue ? queue->items.size() : 0;
+}
+
+#endif // NATIVE_MOCK_FREERTOS_QUEUE_H
@@ -0,0 +1,38 @@
+#ifndef NATIVE_MOCK_FREERTOS_TASK_H
+#define NATIVE_MOCK_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+//* ************************************************************************
+//* ************************* NATIVE TASK MOCK *****************************
+//* ************************************************************************
+// Tasks are never started - the test calls the control pass itself.
+// Blocking calls advance the virtual clock by the time they would block.
+
+uint64_t nowUs();
+void advanceVirtualTimeUs(uint64_t deltaUs);
+
+typedef void (*TaskFunction_t)(void*);
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* parameter,
+                                          UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    if (handle) *handle = NULL;
+    return pdPASS;
+}
+
+inline void vTaskDelete(TaskHandle_t task) {}
+inline void vTaskDelay(TickType_t ticks) { advanceVirtualTimeUs((uint64_t)ticks * 1000); }
+inline TickType_t xTaskGetTickCount() { return (TickType_t)(nowUs() / 1000); }
+inline void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+    *previousWake += period;
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(*previousWake - now) > 0) vTaskDelay(*previousWake - now);
+}
+inline void taskYIELD() {}
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return NULL; }
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) { return 1; }
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) { return pdPASS; }
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {}
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { return 0; }
+
+#endif // NATIVE_MOCK_FREERTOS_TASK_H
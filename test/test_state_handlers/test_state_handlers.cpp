@@ -0,0 +1,114 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "Config/Pins_Definitions.h"
+#include "StateMachine/StateManager.h"
+#include "Diagnostics/Loop_Latency.h"
+#include "Tasks/Control_Executive.h"
+#include "Timing/Timebase.h"
+
+//* ************************************************************************
+//* ************************ STATE HANDLER TIMING **************************
+//* ************************************************************************
+// Host test (pio test -e native): runs the control pass - executeStateMachine(),
+// timed and recorded exactly as the control task does - against the mocks in
+// test/native_mocks. Handler code takes no virtual time; delay(), vTaskDelay()
+// and friends advance the virtual clock by what they would block for. So any
+// pass that shows elapsed time blocked, and none may block for more than 1 ms.
+//
+// The inputs toggle on unrelated periods so the handlers see switches, sensors
+// and the start button change under them and walk through their steps.
+
+void setup();   // main.cpp
+
+const unsigned long MAX_PASS_US = 1000;
+const unsigned long PASSES_PER_STATE = 6000;        // 3 s at the control tick
+
+struct TogglingInput {
+    const int* pin;
+    unsigned long periodMs;
+};
+
+// Hard stop stays released - it latches the machine into ERROR and is covered by its own path
+static const TogglingInput INPUTS[] = {
+    { &CUT_MOTOR_HOME_SWITCH,       37 },
+    { &FEED_MOTOR_HOME_SENSOR,      53 },
+    { &RELOAD_SWITCH,               1900 },
+    { &START_CYCLE_SWITCH,          410 },
+    { &MANUAL_FEED_SWITCH,          2300 },
+    { &FIRST_CUT_OR_WOOD_FWD_ONE,   700 },
+    { &_2x4_PRESENT_SENSOR,         290 },
+    { &WOOD_SUCTION_CONFIRM_SENSOR, 130 },
+};
+
+static unsigned long passesInState[SYSTEM_STATE_COUNT];
+
+static void driveInputs() {
+    unsigned long nowMs = millis();
+    for (size_t i = 0; i < sizeof(INPUTS) / sizeof(INPUTS[0]); i++) {
+        setMockPinLevel(*INPUTS[i].pin, (nowMs / INPUTS[i].periodMs) & 1 ? HIGH : LOW);
+    }
+}
+
+// One control pass, timed against the state it started in (Tasks/Task_Layout.cpp)
+static void runControlPasses(unsigned long passes) {
+    for (unsigned long i = 0; i < passes; i++) {
+        advanceVirtualTimeUs(CONTROL_TICK_PERIOD_US);
+        driveInputs();
+        SystemState passState = getCurrentState();
+        uint64_t passStartUs = nowUs();
+        executeStateMachine();
+        recordLoopLatency(passState, (unsigned long)usSince(passStartUs));
+        passesInState[passState]++;
+    }
+}
+
+static void assertNoPassBlocked() {
+    char message[96];
+    for (int state = 0; state < SYSTEM_STATE_COUNT; state++) {
+        LoopLatencySummary summary;
+        if (!getLoopLatencySummary((SystemState)state, summary)) continue;
+        snprintf(message, sizeof(message), "%s blocked for %lu us in one pass (%lu passes over 1 ms)",
+                 getStateName((SystemState)state), summary.maxUs, summary.blockedCount);
+        TEST_ASSERT_TRUE_MESSAGE(summary.maxUs <= MAX_PASS_US && summary.blockedCount == 0, message);
+    }
+}
+
+void setUp(void) {
+    resetLoopLatency();
+    memset(passesInState, 0, sizeof(passesInState));
+}
+
+void tearDown(void) {}
+
+//* ************************************************************************
+//* ******************************* TESTS **********************************
+//* ************************************************************************
+
+// The mock motors never reach a home input, so this is STARTUP, failed HOMING,
+// ERROR and the reload-switch reset back to HOMING, over and over
+void test_boot_and_error_recovery_do_not_block() {
+    runControlPasses(20000);        // 10 s from STARTUP
+    assertNoPassBlocked();
+}
+
+void test_every_state_handler_does_not_block() {
+    char message[64];
+    for (int state = 0; state < SYSTEM_STATE_COUNT; state++) {
+        changeState((SystemState)state);
+        unsigned long before = passesInState[state];
+        runControlPasses(PASSES_PER_STATE);
+        snprintf(message, sizeof(message), "%s handler never ran", getStateName((SystemState)state));
+        TEST_ASSERT_TRUE_MESSAGE(passesInState[state] > before, message);
+    }
+    assertNoPassBlocked();
+}
+
+int main(int argc, char** argv) {
+    setVirtualTimeUs(1000000);
+    setup();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_and_error_recovery_do_not_block);
+    RUN_TEST(test_every_state_handler_does_not_block);
+    return UNITY_END();
+}
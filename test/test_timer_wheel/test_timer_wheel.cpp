@@ -0,0 +1,167 @@
+#include <unity.h>
+#include "Timing/Timer_Wheel.h"
+
+//* ************************************************************************
+//* ************************** TIMER WHEEL TESTS ***************************
+//* ************************************************************************
+// Host test (pio test -e native): the wheel runs on the virtual clock, so
+// every expiry is stepped exactly with advanceVirtualTimeUs().
+// The wheel keeps its slots between tests - each test cancels what it schedules.
+
+static WheelTimer timerA;
+static WheelTimer timerB;
+static int firedA = 0;
+static int firedB = 0;
+static uint64_t firedAtMs = 0;
+static int repeatsLeft = 0;
+
+static void onTimerA() {
+    firedA++;
+    firedAtMs = nowUs() / 1000;
+}
+
+static void onTimerB() {
+    firedB++;
+}
+
+static void onTimerRepeat() {
+    firedA++;
+    if (--repeatsLeft > 0) scheduleTimer(timerA, 10, onTimerRepeat);
+}
+
+// Advance the clock one control pass at a time, servicing the wheel each pass
+static void runForMs(unsigned long ms) {
+    for (unsigned long i = 0; i < ms * 2; i++) {
+        advanceVirtualTimeUs(500);
+        serviceTimers();
+    }
+}
+
+void setUp(void) {
+    firedA = 0;
+    firedB = 0;
+    firedAtMs = 0;
+    repeatsLeft = 0;
+}
+
+void tearDown(void) {
+    cancelTimer(timerA);
+    cancelTimer(timerB);
+}
+
+//* ************************************************************************
+//* ******************************* TESTS **********************************
+//* ************************************************************************
+
+void test_timer_fires_at_expiry() {
+    uint64_t startMs = nowUs() / 1000;
+    scheduleTimer(timerA, 10, onTimerA);
+    TEST_ASSERT_TRUE(isTimerScheduled(timerA));
+
+    runForMs(9);
+    TEST_ASSERT_EQUAL(0, firedA);
+    runForMs(1);
+    TEST_ASSERT_EQUAL(1, firedA);
+    TEST_ASSERT_EQUAL_UINT64(startMs + 10, firedAtMs);
+    TEST_ASSERT_FALSE(isTimerScheduled(timerA));
+
+    runForMs(200);
+    TEST_ASSERT_EQUAL(1, firedA);
+}
+
+void test_zero_delay_is_one_ms() {
+    scheduleTimer(timerA, 0, onTimerA);
+    serviceTimers();
+    TEST_ASSERT_EQUAL(0, firedA);
+    runForMs(1);
+    TEST_ASSERT_EQUAL(1, firedA);
+}
+
+void test_cancel_before_expiry() {
+    scheduleTimer(timerA, 20, onTimerA);
+    scheduleTimer(timerB, 20, onTimerB);
+    runForMs(10);
+    cancelTimer(timerA);
+    TEST_ASSERT_FALSE(isTimerScheduled(timerA));
+    cancelTimer(timerA);        // Not scheduled - no effect
+
+    runForMs(20);
+    TEST_ASSERT_EQUAL(0, firedA);
+    TEST_ASSERT_EQUAL(1, firedB);   // Same slot - unlinking A left B in place
+}
+
+void test_reschedule_moves_timer() {
+    uint64_t startMs = nowUs() / 1000;
+    scheduleTimer(timerA, 10, onTimerA);
+    scheduleTimer(timerA, 30, onTimerA);
+
+    runForMs(29);
+    TEST_ASSERT_EQUAL(0, firedA);
+    runForMs(1);
+    TEST_ASSERT_EQUAL(1, firedA);
+    TEST_ASSERT_EQUAL_UINT64(startMs + 30, firedAtMs);
+}
+
+void test_same_slot_next_lap_waits() {
+    // 5 ms and 133 ms share a slot (128 slots) - the later one waits a lap
+    scheduleTimer(timerA, 133, onTimerA);
+    scheduleTimer(timerB, 5, onTimerB);
+
+    runForMs(5);
+    TEST_ASSERT_EQUAL(1, firedB);
+    TEST_ASSERT_EQUAL(0, firedA);
+    TEST_ASSERT_TRUE(isTimerScheduled(timerA));
+
+    runForMs(127);
+    TEST_ASSERT_EQUAL(0, firedA);
+    runForMs(1);
+    TEST_ASSERT_EQUAL(1, firedA);
+}
+
+void test_long_timeout_takes_several_laps() {
+    uint64_t startMs = nowUs() / 1000;
+    scheduleTimer(timerA, 1000, onTimerA);
+    runForMs(999);
+    TEST_ASSERT_EQUAL(0, firedA);
+    runForMs(1);
+    TEST_ASSERT_EQUAL(1, firedA);
+    TEST_ASSERT_EQUAL_UINT64(startMs + 1000, firedAtMs);
+}
+
+void test_stall_past_a_lap_catches_due_timers() {
+    // One service after a stall longer than the wheel still finds every due timer
+    scheduleTimer(timerA, 40, onTimerA);
+    scheduleTimer(timerB, 300, onTimerB);
+    advanceVirtualTimeUs(200000);
+    serviceTimers();
+    TEST_ASSERT_EQUAL(1, firedA);
+    TEST_ASSERT_EQUAL(0, firedB);
+
+    advanceVirtualTimeUs(500000);
+    serviceTimers();
+    TEST_ASSERT_EQUAL(1, firedB);
+}
+
+void test_callback_reschedules_itself() {
+    repeatsLeft = 3;
+    scheduleTimer(timerA, 10, onTimerRepeat);
+    runForMs(29);
+    TEST_ASSERT_EQUAL(2, firedA);
+    runForMs(1);
+    TEST_ASSERT_EQUAL(3, firedA);
+    TEST_ASSERT_FALSE(isTimerScheduled(timerA));
+}
+
+int main(int argc, char** argv) {
+    setVirtualTimeUs(1000000);
+    UNITY_BEGIN();
+    RUN_TEST(test_timer_fires_at_expiry);
+    RUN_TEST(test_zero_delay_is_one_ms);
+    RUN_TEST(test_cancel_before_expiry);
+    RUN_TEST(test_reschedule_moves_timer);
+    RUN_TEST(test_same_slot_next_lap_waits);
+    RUN_TEST(test_long_timeout_takes_several_laps);
+    RUN_TEST(test_stall_past_a_lap_catches_due_timers);
+    RUN_TEST(test_callback_reschedules_itself);
+    return UNITY_END();
+}